@@ -0,0 +1,103 @@
+/*
+  This is free and unencumbered software released into the public domain.
+
+  Anyone is free to copy, modify, publish, use, compile, sell, or
+  distribute this software, either in source code form or as a compiled
+  binary, for any purpose, commercial or non-commercial, and by any
+  means.
+
+  In jurisdictions that recognize copyright laws, the author or authors
+  of this software dedicate any and all copyright interest in the
+  software to the public domain. We make this dedication for the benefit
+  of the public at large and to the detriment of our heirs and
+  successors. We intend this dedication to be an overt act of
+  relinquishment in perpetuity of all present and future rights to this
+  software under copyright law.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+  EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+  MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+  IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+  OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+  ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+  OTHER DEALINGS IN THE SOFTWARE.
+
+  For more information, please refer to <http://unlicense.org/>
+*/
+
+#include <stdio.h>
+
+#include <future>
+
+#include "cassandra_coro.hpp"
+
+void print_error(const cass::coro::Response& response) {
+  std::string_view message(response.error_message());
+  fprintf(stderr, "Error: %.*s\n", (int)message.size(), message.data());
+}
+
+cass::coro::Task run(CassSession* session, std::promise<void>& done) {
+  cass::coro::Prepared prepared = co_await cass::coro::prepare(
+      session, "SELECT release_version FROM system.local WHERE key = ?");
+  if (!prepared) {
+    print_error(prepared);
+    done.set_value();
+    co_return;
+  }
+
+  CassStatement* statement = prepared.bind();
+  cass_statement_bind_string(statement, 0, "local");
+  cass_statement_set_paging_size(statement, 1);
+
+  cass::coro::Result result = co_await cass::coro::execute(session, statement);
+  while (result) {
+    CassIterator* iterator = cass_iterator_from_result(result.get());
+    while (cass_iterator_next(iterator)) {
+      const char* release_version;
+      size_t release_version_length;
+      const CassRow* row = cass_iterator_get_row(iterator);
+      cass_value_get_string(cass_row_get_column(row, 0), &release_version,
+                            &release_version_length);
+      printf("release_version: '%.*s'\n", (int)release_version_length, release_version);
+    }
+    cass_iterator_free(iterator);
+
+    if (!result.has_more_pages()) break;
+    result = co_await cass::coro::next_page(session, statement, result);
+  }
+
+  if (!result) {
+    print_error(result);
+  }
+
+  cass_statement_free(statement);
+  done.set_value();
+}
+
+int main(int argc, char* argv[]) {
+  CassCluster* cluster = cass_cluster_new();
+  CassSession* session = cass_session_new();
+  const char* hosts = "127.0.0.1";
+  if (argc > 1) {
+    hosts = argv[1];
+  }
+  cass_cluster_set_contact_points(cluster, hosts);
+
+  CassFuture* connect_future = cass_session_connect(session, cluster);
+  if (cass_future_error_code(connect_future) == CASS_OK) {
+    std::promise<void> done;
+    run(session, done);
+    done.get_future().wait();
+  } else {
+    const char* message;
+    size_t message_length;
+    cass_future_error_message(connect_future, &message, &message_length);
+    fprintf(stderr, "Unable to connect: '%.*s'\n", (int)message_length, message);
+  }
+
+  cass_future_free(connect_future);
+  cass_session_free(session);
+  cass_cluster_free(cluster);
+
+  return 0;
+}
@@ -97,6 +97,18 @@ typedef cass_uint64_t cass_duration_t;
  */
 #define CASS_INET_STRING_LENGTH 46
 
+/**
+ * The size of a data center name in the host metrics including a null
+ * terminator. Longer names are truncated.
+ */
+#define CASS_METRICS_DC_NAME_LENGTH 64
+
+/**
+ * The size of a statement name in the statement metrics including a null
+ * terminator. Longer names are truncated.
+ */
+#define CASS_METRICS_STATEMENT_NAME_LENGTH 256
+
 /**
  * IP address for either IPv4 or IPv6.
  *
@@ -199,6 +211,35 @@ typedef struct CassBatch_ CassBatch;
  */
 typedef struct CassFuture_ CassFuture;
 
+/**
+ * A bounded queue of completed requests. Requests submitted with a completion
+ * queue post a completion record to the queue instead of running a callback.
+ * The application removes the records in batches from its own threads by
+ * polling the queue.
+ *
+ * A completion queue is thread-safe.
+ *
+ * @struct CassCompletionQueue
+ */
+typedef struct CassCompletionQueue_ CassCompletionQueue;
+
+/**
+ * An executor for bulk workloads that keeps a bounded number of requests in
+ * flight. Statements are pulled from a callback whenever a request completes,
+ * optionally limited to a target rate.
+ *
+ * @struct CassBulkExecutor
+ */
+typedef struct CassBulkExecutor_ CassBulkExecutor;
+
+/**
+ * A batch of future callbacks that's handed off to an application-provided
+ * executor instead of being run on the driver's I/O threads.
+ *
+ * @struct CassCallbackBatch
+ */
+typedef struct CassCallbackBatch_ CassCallbackBatch;
+
 /**
  * A statement that has been prepared cluster-side (It has been pre-parsed
  * and cached).
@@ -210,6 +251,18 @@ typedef struct CassFuture_ CassFuture;
  */
 typedef struct CassPrepared_ CassPrepared;
 
+/**
+ * A bound statement for a prepared statement that's executed repeatedly with
+ * different values. The values are encoded in a single contiguous buffer and
+ * are kept between executions, so only the values that change need to be
+ * bound again.
+ *
+ * <b>Note:</b> A statement template is not thread-safe.
+ *
+ * @struct CassStatementTemplate
+ */
+typedef struct CassStatementTemplate_ CassStatementTemplate;
+
 /**
  * The result of a query.
  *
@@ -241,6 +294,21 @@ typedef struct CassIterator_ CassIterator;
  */
 typedef struct CassRow_ CassRow;
 
+/**
+ * A result's rows decoded into per-column contiguous buffers.
+ *
+ * @struct CassColumnarResult
+ */
+typedef struct CassColumnarResult_ CassColumnarResult;
+
+/**
+ * The pages of a continuous paging request, streamed by the server as
+ * they become available.
+ *
+ * @struct CassResultStream
+ */
+typedef struct CassResultStream_ CassResultStream;
+
 /**
  * A single primitive value or a collection of values.
  *
@@ -443,6 +511,138 @@ typedef struct CassSpeculativeExecutionMetrics_ {
   cass_double_t percentage; /**< Fraction of requests that are aborted speculative retries */
 } CassSpeculativeExecutionMetrics;
 
+typedef struct CassOutlierDetectionMetrics_ {
+  cass_uint64_t ejected_hosts; /**< The number of hosts that are currently ejected */
+  cass_uint64_t ejections; /**< The total number of host ejections */
+} CassOutlierDetectionMetrics;
+
+typedef struct CassPrepareHostMetrics_ {
+  cass_uint64_t hosts_preparing; /**< The number of hosts currently being prepared */
+  cass_uint64_t pending_statements; /**< The number of statements waiting to be prepared */
+  cass_uint64_t prepared_statements; /**< The total number of statements prepared on hosts */
+  cass_uint64_t failed_statements; /**< The total number of failed prepare requests */
+} CassPrepareHostMetrics;
+
+typedef struct CassBulkExecutorMetrics_ {
+  struct {
+    cass_uint64_t min; /**< Minimum in microseconds */
+    cass_uint64_t max; /**< Maximum in microseconds */
+    cass_uint64_t mean; /**< Mean in microseconds */
+    cass_uint64_t median; /**< Median in microseconds */
+    cass_uint64_t percentile_95th; /**< 95th percentile in microseconds */
+    cass_uint64_t percentile_99th; /**< 99th percentile in microseconds */
+  } latency; /**< Request latency metrics */
+  cass_uint64_t in_flight; /**< The number of requests currently in flight */
+  cass_uint64_t completed; /**< The total number of completed requests */
+  cass_uint64_t errors; /**< The total number of requests that failed */
+  cass_double_t mean_rate; /**< Mean rate in completed requests per second */
+} CassBulkExecutorMetrics;
+
+typedef struct CassCallbackMetrics_ {
+  cass_uint64_t io_thread_callbacks; /**< The number of callbacks run on the driver's I/O threads */
+  cass_uint64_t io_thread_time; /**< Total time spent in callbacks on the I/O threads in microseconds */
+  cass_uint64_t io_thread_max_time; /**< Longest callback on the I/O threads in microseconds */
+  cass_uint64_t dispatched_callbacks; /**< The number of callbacks handed off to the executor */
+  cass_uint64_t dispatched_batches; /**< The number of batches handed off to the executor */
+} CassCallbackMetrics;
+
+typedef struct CassLatencyMetrics_ {
+  cass_uint64_t count; /**< The number of responses */
+  cass_uint64_t min; /**< Minimum in microseconds */
+  cass_uint64_t max; /**< Maximum in microseconds */
+  cass_uint64_t mean; /**< Mean in microseconds */
+  cass_uint64_t stddev; /**< Standard deviation in microseconds */
+  cass_uint64_t median; /**< Median in microseconds */
+  cass_uint64_t percentile_75th; /**< 75th percentile in microseconds */
+  cass_uint64_t percentile_95th; /**< 95th percentile in microseconds */
+  cass_uint64_t percentile_98th; /**< 98th percentile in microseconds */
+  cass_uint64_t percentile_99th; /**< 99th percentile in microseconds */
+  cass_uint64_t percentile_999th; /**< 99.9th percentile in microseconds */
+} CassLatencyMetrics;
+
+typedef enum CassMetricsWindow_ {
+  CASS_METRICS_WINDOW_ONE_MINUTE      = 1,
+  CASS_METRICS_WINDOW_FIVE_MINUTES    = 5,
+  CASS_METRICS_WINDOW_FIFTEEN_MINUTES = 15
+} CassMetricsWindow;
+
+typedef struct CassRequestMetrics_ {
+  CassLatencyMetrics latency; /**< Latency of the responses (including errors returned by the server) */
+  cass_uint64_t errors; /**< Error responses and failed requests (e.g. connection errors) */
+  cass_uint64_t timeouts; /**< Requests that timed out while waiting on the host */
+  cass_uint64_t in_flight; /**< The number of requests currently in flight */
+  cass_uint64_t speculative_wins; /**< Responses to speculative executions that were used */
+} CassRequestMetrics;
+
+typedef struct CassHostMetrics_ {
+  CassInet address; /**< The address of the host */
+  int port; /**< The port of the host */
+  char dc[CASS_METRICS_DC_NAME_LENGTH]; /**< The host's data center */
+  CassRequestMetrics requests; /**< The requests sent to the host */
+} CassHostMetrics;
+
+typedef struct CassStatementMetrics_ {
+  char name[CASS_METRICS_STATEMENT_NAME_LENGTH]; /**< The statement's label or prepared query */
+  cass_uint64_t count; /**< The number of responses */
+  cass_uint64_t total_time; /**< Total time in microseconds */
+  cass_uint64_t min; /**< Minimum in microseconds */
+  cass_uint64_t max; /**< Maximum in microseconds */
+  cass_uint64_t mean; /**< Mean in microseconds */
+  cass_uint64_t median; /**< Median in microseconds */
+  cass_uint64_t percentile_95th; /**< 95th percentile in microseconds */
+  cass_uint64_t percentile_99th; /**< 99th percentile in microseconds */
+  cass_uint64_t percentile_999th; /**< 99.9th percentile in microseconds */
+} CassStatementMetrics;
+
+/**
+ * The latencies between the stages of the requests' lifecycles. Each stage is
+ * measured from the end of the previous stage.
+ *
+ * The stages from the connection onwards are those of the execution whose
+ * response was used. The connection stage is skipped for requests whose
+ * response came from a speculative execution or a retry, because it would
+ * include the speculative execution delay or the earlier attempts.
+ *
+ * @see cass_cluster_set_request_timings()
+ */
+typedef struct CassRequestStageMetrics_ {
+  CassLatencyMetrics queue; /**< Waiting in a request processor's queue */
+  CassLatencyMetrics plan; /**< Building the query plan */
+  CassLatencyMetrics connection; /**< Getting a connection and writing the request to it */
+  CassLatencyMetrics write; /**< Waiting for the socket write to finish */
+  CassLatencyMetrics server; /**< From the socket write to the first bytes of the response */
+  CassLatencyMetrics decode; /**< Reading and decoding the response */
+} CassRequestStageMetrics;
+
+/**
+ * The times at which a request reached each stage of its lifecycle. The times
+ * are in nanoseconds from an arbitrary point in the past (using a monotonic
+ * clock) so only the differences between them are meaningful. A time of zero
+ * means the request didn't reach the stage.
+ *
+ * @see cass_future_timings()
+ */
+typedef struct CassRequestTimings_ {
+  cass_uint64_t enqueued; /**< Added to a request processor's queue */
+  cass_uint64_t dequeued; /**< Removed from the queue by an I/O thread */
+  cass_uint64_t plan_built; /**< The query plan is built */
+  cass_uint64_t write_queued; /**< Written to a connection's outgoing buffers */
+  cass_uint64_t write_flushed; /**< The socket write has finished */
+  cass_uint64_t response_received; /**< The first bytes of the response have been read */
+  cass_uint64_t response_decoded; /**< The response has been decoded */
+  cass_uint64_t callback_invoked; /**< The future's callback has started running */
+} CassRequestTimings;
+
+typedef enum CassStatementMetricsOrder_ {
+  CASS_STATEMENT_METRICS_ORDER_P99, /**< Highest 99th percentile latency first */
+  CASS_STATEMENT_METRICS_ORDER_TOTAL_TIME /**< Highest total time first */
+} CassStatementMetricsOrder;
+
+typedef struct CassDcMetrics_ {
+  char dc[CASS_METRICS_DC_NAME_LENGTH]; /**< The data center */
+  CassRequestMetrics requests; /**< The requests sent to the data center's hosts */
+} CassDcMetrics;
+
 typedef enum CassConsistency_ {
   CASS_CONSISTENCY_UNKNOWN      = 0xFFFF,
   CASS_CONSISTENCY_ANY          = 0x0000,
@@ -731,6 +931,55 @@ typedef enum CassError_ {
 typedef void (*CassFutureCallback)(CassFuture* future,
                                    void* data);
 
+/**
+ * A completed request removed from a completion queue.
+ *
+ * @see cass_completion_queue_drain()
+ */
+typedef struct CassCompletion_ {
+  void* tag; /**< The tag provided when the request was submitted */
+  CassError code; /**< CASS_OK if the request succeeded, otherwise the error code */
+  CassFuture* future; /**< The request's future (already set). It must be freed. */
+} CassCompletion;
+
+/**
+ * A function that hands off a batch of future callbacks to the application's
+ * executor (e.g. a thread pool or an event loop). It's called on the driver's
+ * I/O threads so it must not block. The batch must be run exactly once using
+ * cass_callback_batch_run().
+ *
+ * @param[in] batch
+ * @param[in] data user defined data provided when the executor was set.
+ *
+ * @see cass_cluster_set_callback_executor()
+ */
+typedef void (*CassCallbackExecutorFunction)(CassCallbackBatch* batch,
+                                             void* data);
+
+/**
+ * A callback that's notified for each page of rows returned by a table scan.
+ *
+ * @param[in] result A page of rows. The result is owned by the scan and must
+ * not be freed or used after the callback returns.
+ * @param[in] data user defined data provided when the scan was started.
+ *
+ * @see cass_session_scan_table()
+ */
+typedef void (*CassTableScanCallback)(const CassResult* result,
+                                      void* data);
+
+/**
+ * A callback that provides the next statement to a bulk executor.
+ *
+ * @param[in] data user defined data provided when the executor was created.
+ * @return The next statement to execute or NULL when there are no more
+ * statements. The executor takes ownership of the statement; it must not be
+ * freed by the application.
+ *
+ * @see cass_bulk_executor_new()
+ */
+typedef CassStatement* (*CassBulkExecutorNextCallback)(void* data);
+
 /**
  * Maximum size of a log message
  */
@@ -1073,6 +1322,54 @@ cass_execution_profile_set_load_balance_dc_aware_n(CassExecProfile* profile,
                                                    unsigned used_hosts_per_remote_dc,
                                                    cass_bool_t allow_remote_dcs_for_local_cl);
 
+/**
+ * Configures the execution profile to use rack-aware load balancing.
+ * For each query, all live nodes in the 'local' rack of the 'local' DC are
+ * tried first, followed by the other nodes in the local DC. When token-aware
+ * routing is enabled, replicas in the local rack are also tried before the
+ * other local replicas.
+ *
+ * <b>Note:</b> Profile-based load balancing policy is disabled by default;
+ * cluster load balancing policy is used when profile does not contain a policy.
+ *
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] local_dc The primary data center to try first
+ * @param[in] local_rack The primary rack within the local data center to try
+ * first
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_load_balance_rack_aware()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_load_balance_rack_aware(CassExecProfile* profile,
+                                                   const char* local_dc,
+                                                   const char* local_rack);
+
+/**
+ * Same as cass_execution_profile_set_load_balance_rack_aware(), but with
+ * lengths for string parameters.
+ *
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] local_dc
+ * @param[in] local_dc_length
+ * @param[in] local_rack
+ * @param[in] local_rack_length
+ * @return same as cass_execution_profile_set_load_balance_rack_aware()
+ *
+ * @see cass_execution_profile_set_load_balance_rack_aware()
+ * @see cass_cluster_set_load_balance_rack_aware_n()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_load_balance_rack_aware_n(CassExecProfile* profile,
+                                                     const char* local_dc,
+                                                     size_t local_dc_length,
+                                                     const char* local_rack,
+                                                     size_t local_rack_length);
+
 /**
  * Configures the execution profile to use token-aware request routing or not.
  *
@@ -1196,6 +1493,109 @@ cass_execution_profile_set_latency_aware_routing_settings(CassExecProfile* profi
                                                           cass_uint64_t update_rate_ms,
                                                           cass_uint64_t min_measured);
 
+/**
+ * Configures the execution profile's latency-aware routing to compare hosts
+ * using a latency percentile (e.g. p99) instead of an exponentially weighted
+ * average. Latencies are recorded into per-host histograms and the percentile
+ * is recomputed once per second.
+ *
+ * <b>Note:</b> Execution profiles use the cluster-level load balancing policy
+ * unless enabled. This setting is not applicable unless a load balancing policy
+ * is enabled on the execution profile.
+ *
+ * <b>Default:</b> 0.0 (use the weighted average latency)
+ *
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] percentile A percentile in the range (0.0, 100.0]
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_latency_aware_routing_percentile()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_latency_aware_routing_percentile(CassExecProfile* profile,
+                                                            cass_double_t percentile);
+
+/**
+ * Configures the execution profile to use outlier detection or not.
+ *
+ * <b>Note:</b> Execution profiles use the cluster-level load balancing policy
+ * unless enabled. This setting is not applicable unless a load balancing policy
+ * is enabled on the execution profile.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_outlier_detection()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_outlier_detection(CassExecProfile* profile,
+                                             cass_bool_t enabled);
+
+/**
+ * Configures the execution profile's settings for outlier detection.
+ *
+ * <b>Note:</b> Execution profiles use the cluster-level load balancing policy
+ * unless enabled. This setting is not applicable unless a load balancing policy
+ * is enabled on the execution profile.
+ *
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] consecutive_failures
+ * @param[in] failure_rate_threshold
+ * @param[in] min_requests
+ * @param[in] interval_ms
+ * @param[in] base_ejection_time_ms
+ * @param[in] max_ejection_time_ms
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_outlier_detection_settings()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_outlier_detection_settings(CassExecProfile* profile,
+                                                      unsigned consecutive_failures,
+                                                      cass_double_t failure_rate_threshold,
+                                                      unsigned min_requests,
+                                                      cass_uint64_t interval_ms,
+                                                      cass_uint64_t base_ejection_time_ms,
+                                                      cass_uint64_t max_ejection_time_ms);
+
+/**
+ * Configures the execution profile's token-aware routing to order replicas by
+ * their latency percentile (lowest first). Replicas with the same latency
+ * keep their shuffled order.
+ *
+ * Percentiles that are older than latency-aware routing's retry period or
+ * that were computed from fewer than its minimum number of measurements are
+ * treated as unknown. Replicas with an unknown latency are tried first so
+ * that they're measured again.
+ *
+ * <b>Note:</b> Token-aware routing must be enabled and latency-aware routing
+ * must be enabled and configured with a percentile, otherwise this setting
+ * has no effect (and a warning is logged when the session connects).
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] enabled
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_execution_profile_set_latency_aware_routing_percentile()
+ * @see cass_cluster_set_token_aware_routing_order_replicas_by_latency()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_token_aware_routing_order_replicas_by_latency(CassExecProfile* profile,
+                                                                         cass_bool_t enabled);
+
 /**
  * Sets/Appends whitelist hosts for the execution profile. The first call sets
  * the whitelist hosts and any subsequent calls appends additional hosts.
@@ -1435,6 +1835,30 @@ cass_execution_profile_set_constant_speculative_execution_policy(CassExecProfile
 CASS_EXPORT CassError
 cass_execution_profile_set_no_speculative_execution_policy(CassExecProfile* profile);
 
+/**
+ * Enable adaptive speculative executions with the supplied settings for the
+ * execution profile.
+ *
+ * <b>Note:</b> Profile-based speculative execution policy is disabled by
+ * default; cluster speculative execution policy is used when profile does not
+ * contain a policy.
+ *
+ * @public @memberof CassExecProfile
+ *
+ * @param[in] profile
+ * @param[in] percentile
+ * @param[in] max_speculative_executions
+ * @param[in] max_speculative_percent
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_adaptive_speculative_execution_policy()
+ */
+CASS_EXPORT CassError
+cass_execution_profile_set_adaptive_speculative_execution_policy(CassExecProfile* profile,
+                                                                 cass_double_t percentile,
+                                                                 int max_speculative_executions,
+                                                                 cass_double_t max_speculative_percent);
+
 /***********************************************************************************
  *
  * Cluster
@@ -1679,6 +2103,65 @@ CASS_EXPORT CassError
 cass_cluster_set_queue_size_io(CassCluster* cluster,
                                unsigned queue_size);
 
+/**
+ * Sets a function that's used to hand off future callbacks to the
+ * application's own executor. By default, callbacks set using
+ * cass_future_set_callback() are run on the driver's I/O threads when the
+ * request completes, so a slow callback delays every other request handled by
+ * the same thread.
+ *
+ * Callbacks that complete while a batch is waiting to be run are added to
+ * that batch, so the function is called at most once per burst of
+ * completions.
+ *
+ * cass_future_wait(), cass_future_wait_timed(), cass_future_wait_all() and
+ * cass_future_wait_any() don't return until the future's callback has been
+ * run by the batch. A callback must not wait on another future whose
+ * callback is handed off to the same executor.
+ *
+ * <b>Note:</b> This replaces a thread pool set using
+ * cass_cluster_set_callback_thread_pool(). It only applies to the futures of
+ * requests executed by a session.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] function The function used to hand off batches of callbacks, or
+ * NULL to run callbacks on the I/O threads.
+ * @param[in] data User data passed to the function.
+ *
+ * @see cass_session_get_callback_metrics()
+ */
+CASS_EXPORT void
+cass_cluster_set_callback_executor(CassCluster* cluster,
+                                   CassCallbackExecutorFunction function,
+                                   void* data);
+
+/**
+ * Runs future callbacks on a pool of threads owned by the driver instead of
+ * on the driver's I/O threads.
+ *
+ * Waiting on a future doesn't return until its callback has been run by
+ * the pool. A callback must not wait on another future whose callback is
+ * run by the same pool.
+ *
+ * <b>Note:</b> This replaces a function set using
+ * cass_cluster_set_callback_executor(). It only applies to the futures of
+ * requests executed by a session.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] num_threads The number of threads, or 0 to run callbacks on the
+ * I/O threads.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_session_get_callback_metrics()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_callback_thread_pool(CassCluster* cluster,
+                                      unsigned num_threads);
+
 /**
  * Sets the size of the fixed size queue that stores
  * events.
@@ -2182,6 +2665,51 @@ cass_cluster_set_load_balance_dc_aware_n(CassCluster* cluster,
                                          unsigned used_hosts_per_remote_dc,
                                          cass_bool_t allow_remote_dcs_for_local_cl);
 
+/**
+ * Configures the cluster to use rack-aware load balancing.
+ * For each query, all live nodes in the 'local' rack of the 'local' DC are
+ * tried first, followed by the other nodes in the local DC. This can reduce
+ * latency and cross-rack (e.g. cross availability zone) traffic.
+ *
+ * When token-aware routing is enabled, replicas in the local rack are tried
+ * before the other local replicas. Replicas within each group are still
+ * shuffled when token-aware routing is configured to shuffle replicas.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] local_dc The primary data center to try first
+ * @param[in] local_rack The primary rack within the local data center to try
+ * first
+ * @return CASS_OK if successful, otherwise an error occurred
+ */
+CASS_EXPORT CassError
+cass_cluster_set_load_balance_rack_aware(CassCluster* cluster,
+                                         const char* local_dc,
+                                         const char* local_rack);
+
+/**
+ * Same as cass_cluster_set_load_balance_rack_aware(), but with lengths for
+ * string parameters.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] local_dc
+ * @param[in] local_dc_length
+ * @param[in] local_rack
+ * @param[in] local_rack_length
+ * @return same as cass_cluster_set_load_balance_rack_aware()
+ *
+ * @see cass_cluster_set_load_balance_rack_aware()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_load_balance_rack_aware_n(CassCluster* cluster,
+                                           const char* local_dc,
+                                           size_t local_dc_length,
+                                           const char* local_rack,
+                                           size_t local_rack_length);
+
 /**
  * Configures the cluster to use token-aware request routing or not.
  *
@@ -2210,6 +2738,10 @@ cass_cluster_set_token_aware_routing(CassCluster* cluster,
  * the effectiveness of server-side caching, but it can better distribute load over
  * replicas for a given partition key.
  *
+ * <b>Note:</b> Replicas are never shuffled for lightweight transactions
+ * (statements using a serial consistency) so that they use the same
+ * coordinator for a given partition key.
+ *
  * <b>Note:</b> Token-aware routing must be enabled for the setting to
  * be applicable.
  *
@@ -2278,27 +2810,136 @@ cass_cluster_set_latency_aware_routing_settings(CassCluster* cluster,
                                                 cass_uint64_t min_measured);
 
 /**
- * Sets/Appends whitelist hosts. The first call sets the whitelist hosts and
- * any subsequent calls appends additional hosts. Passing an empty string will
- * clear and disable the whitelist. White space is striped from the hosts.
- *
- * This policy filters requests to all other policies, only allowing requests
- * to the hosts contained in the whitelist. Any host not in the whitelist will
- * be ignored and a connection will not be established. This policy is useful
- * for ensuring that the driver will only connect to a predefined set of hosts.
+ * Configures latency-aware routing to compare hosts using a latency
+ * percentile (e.g. p99) instead of an exponentially weighted average.
+ * Latencies are recorded into per-host histograms and the percentile is
+ * recomputed once per second. Tail latency is often a better signal of a
+ * struggling host than its average latency.
  *
- * Examples: "127.0.0.1" "127.0.0.1,127.0.0.2"
+ * <b>Default:</b> 0.0 (use the weighted average latency)
  *
  * @public @memberof CassCluster
  *
  * @param[in] cluster
- * @param[in] hosts A comma delimited list of addresses. An empty string will
- * clear the whitelist hosts. The string is copied into the cluster
- * configuration; the memory pointed to by this parameter can be freed after
- * this call.
+ * @param[in] percentile A percentile in the range (0.0, 100.0]
+ * @return CASS_OK if successful, otherwise an error occurred.
  */
-CASS_EXPORT void
-cass_cluster_set_whitelist_filtering(CassCluster* cluster,
+CASS_EXPORT CassError
+cass_cluster_set_latency_aware_routing_percentile(CassCluster* cluster,
+                                                  cass_double_t percentile);
+
+/**
+ * Configures the cluster to use outlier detection or not. Outlier detection
+ * tracks overloaded errors, timeouts, server errors and read/write failures
+ * per host and temporarily ejects hosts with too many failures. Ejected hosts
+ * are only tried after all other hosts in a query plan. Each consecutive
+ * ejection of a host doubles its ejection time.
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * This routing policy is a top-level routing policy. It can be used in
+ * conjunction with any other load balancing and routing policies.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ *
+ * @see cass_session_get_outlier_detection_metrics()
+ */
+CASS_EXPORT void
+cass_cluster_set_outlier_detection(CassCluster* cluster,
+                                   cass_bool_t enabled);
+
+/**
+ * Configures the settings for outlier detection.
+ *
+ * <b>Defaults:</b>
+ *
+ * <ul>
+ *   <li>consecutive_failures: 5</li>
+ *   <li>failure_rate_threshold: 50.0 percent</li>
+ *   <li>min_requests: 20</li>
+ *   <li>interval_ms: 10,000 milliseconds (10 seconds)</li>
+ *   <li>base_ejection_time_ms: 30,000 milliseconds (30 seconds)</li>
+ *   <li>max_ejection_time_ms: 300,000 milliseconds (5 minutes)</li>
+ * </ul>
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] consecutive_failures The number of consecutive failures that
+ * ejects a host. A value of 0 disables ejection by consecutive failures.
+ * @param[in] failure_rate_threshold The percentage of failed requests within
+ * an interval that ejects a host. A value of 0.0 disables ejection by failure
+ * rate.
+ * @param[in] min_requests The minimum number of requests within an interval
+ * before the failure rate is considered.
+ * @param[in] interval_ms The interval over which the failure rate is
+ * calculated.
+ * @param[in] base_ejection_time_ms The ejection time of a host's first
+ * ejection.
+ * @param[in] max_ejection_time_ms The maximum ejection time.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_cluster_set_outlier_detection_settings(CassCluster* cluster,
+                                            unsigned consecutive_failures,
+                                            cass_double_t failure_rate_threshold,
+                                            unsigned min_requests,
+                                            cass_uint64_t interval_ms,
+                                            cass_uint64_t base_ejection_time_ms,
+                                            cass_uint64_t max_ejection_time_ms);
+
+/**
+ * Configures token-aware routing to order replicas by their latency
+ * percentile (lowest first). Replicas with the same latency keep their
+ * shuffled order.
+ *
+ * Percentiles that are older than latency-aware routing's retry period or
+ * that were computed from fewer than its minimum number of measurements are
+ * treated as unknown. Replicas with an unknown latency are tried first so
+ * that they're measured again.
+ *
+ * <b>Note:</b> Token-aware routing must be enabled and latency-aware routing
+ * must be enabled and configured with a percentile, otherwise this setting
+ * has no effect (and a warning is logged when the session connects).
+ *
+ * <b>Default:</b> cass_false (disabled).
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ *
+ * @see cass_cluster_set_latency_aware_routing_percentile()
+ */
+CASS_EXPORT void
+cass_cluster_set_token_aware_routing_order_replicas_by_latency(CassCluster* cluster,
+                                                               cass_bool_t enabled);
+
+/**
+ * Sets/Appends whitelist hosts. The first call sets the whitelist hosts and
+ * any subsequent calls appends additional hosts. Passing an empty string will
+ * clear and disable the whitelist. White space is striped from the hosts.
+ *
+ * This policy filters requests to all other policies, only allowing requests
+ * to the hosts contained in the whitelist. Any host not in the whitelist will
+ * be ignored and a connection will not be established. This policy is useful
+ * for ensuring that the driver will only connect to a predefined set of hosts.
+ *
+ * Examples: "127.0.0.1" "127.0.0.1,127.0.0.2"
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] hosts A comma delimited list of addresses. An empty string will
+ * clear the whitelist hosts. The string is copied into the cluster
+ * configuration; the memory pointed to by this parameter can be freed after
+ * this call.
+ */
+CASS_EXPORT void
+cass_cluster_set_whitelist_filtering(CassCluster* cluster,
                                      const char* hosts);
 
 /**
@@ -2607,6 +3248,32 @@ cass_cluster_set_constant_speculative_execution_policy(CassCluster* cluster,
                                                        cass_int64_t constant_delay_ms,
                                                        int max_speculative_executions);
 
+/**
+ * Enable adaptive speculative executions with the supplied settings. The delay
+ * before a new execution is created is the given percentile of the recently
+ * observed execution latencies (recomputed every second). No speculative
+ * executions are started until enough latencies have been measured.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] percentile The percentile of recent execution latencies used as
+ * the delay before a new execution is created e.g. 99.0. Must be between 0.0
+ * and 100.0.
+ * @param[in] max_speculative_executions
+ * @param[in] max_speculative_percent The maximum number of speculative
+ * executions as a percentage of the total number of requests e.g. 10.0. Once
+ * the limit is reached new speculative executions are skipped. The budget is
+ * tracked separately by each I/O thread and unused budget is carried over, up
+ * to the share of 100 requests. Must be between 0.0 and 100.0.
+ * @return CASS_OK if successful, otherwise an error occurred
+ */
+CASS_EXPORT CassError
+cass_cluster_set_adaptive_speculative_execution_policy(CassCluster* cluster,
+                                                       cass_double_t percentile,
+                                                       int max_speculative_executions,
+                                                       cass_double_t max_speculative_percent);
+
 /**
  * Disable speculative executions
  *
@@ -2720,6 +3387,158 @@ CASS_EXPORT CassError
 cass_cluster_set_prepare_on_up_or_add_host(CassCluster* cluster,
                                            cass_bool_t enabled);
 
+/**
+ * Sets the maximum number of outstanding prepare requests per host when
+ * pre-preparing cached prepared statements on hosts that become available
+ * again or are added to the cluster.
+ *
+ * Statements executed recently (within the last minute) are prepared first
+ * and the host is made available for requests as soon as those statements
+ * are prepared. The remaining statements are prepared in the background.
+ *
+ * <b>Default:</b> 128
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] concurrency Must be greater than zero.
+ * @return CASS_OK if successful, otherwise an error occurred
+ *
+ * @see cass_cluster_set_prepare_on_up_or_add_host()
+ */
+CASS_EXPORT CassError
+cass_cluster_set_prepare_on_up_or_add_host_concurrency(CassCluster* cluster,
+                                                       unsigned concurrency);
+
+/**
+ * Sets the maximum number of statements per second that are prepared on each
+ * host that becomes available again or is added to the cluster. This limits
+ * the load on recovering hosts during rolling restarts when many statements
+ * are cached.
+ *
+ * <b>Default:</b> 0 (unlimited)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] per_second The rate limit. A value of zero disables the limit.
+ *
+ * @see cass_cluster_set_prepare_on_up_or_add_host()
+ */
+CASS_EXPORT void
+cass_cluster_set_prepare_on_up_or_add_host_rate(CassCluster* cluster,
+                                                unsigned per_second);
+
+/**
+ * Sets the maximum number of queries in the session's prepared statement
+ * cache. Simple statements marked as cacheable are prepared in the background
+ * the first time they're executed and are then executed as bound statements.
+ * The least recently used queries are evicted when the cache is full.
+ *
+ * <b>Default:</b> 512
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] size The maximum number of cached queries. A value of 0 disables
+ * the cache.
+ *
+ * @see cass_statement_set_is_cacheable()
+ */
+CASS_EXPORT void
+cass_cluster_set_prepared_cache_size(CassCluster* cluster,
+                                     unsigned size);
+
+/**
+ * Sets the maximum number of statements in the session's per-statement
+ * latency statistics. Statements are identified by their label or, if they
+ * don't have one, by their prepared ID. Simple statements without a label
+ * aren't recorded. The least recently executed statement is evicted when a
+ * new statement is recorded and the statistics are full.
+ *
+ * <b>Note:</b> The statistics of all the I/O threads are recorded under a
+ * single lock.
+ *
+ * <b>Default:</b> 0 (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] size The maximum number of statements. A value of 0 disables the
+ * statistics.
+ *
+ * @see cass_statement_set_label()
+ * @see cass_session_get_statement_metrics()
+ */
+CASS_EXPORT void
+cass_cluster_set_statement_metrics_size(CassCluster* cluster,
+                                        unsigned size);
+
+/**
+ * Enables recording the time at which each request reaches each stage of its
+ * lifecycle: being queued and dequeued by an I/O thread, the query plan being
+ * built, the request being written to a connection and flushed to the socket,
+ * the response being read and decoded and the future's callback being run.
+ * The times of a request are available from its future and the latencies
+ * between the stages are recorded in the session's metrics.
+ *
+ * <b>Default:</b> cass_false (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] enabled
+ *
+ * @see cass_future_timings()
+ * @see cass_session_get_request_stage_metrics()
+ */
+CASS_EXPORT void
+cass_cluster_set_request_timings(CassCluster* cluster,
+                                 cass_bool_t enabled);
+
+/**
+ * Sets a file used to persist prepared statements across restarts. The
+ * session reads the file when it connects and writes the statements it has
+ * prepared to the file when it's closed. Preparing a query that's in the file
+ * completes immediately without sending a request to the cluster. Statements
+ * that are no longer prepared on a host are prepared again automatically the
+ * first time they're executed on that host.
+ *
+ * The file is ignored if it was written by a session that used a different
+ * protocol version or connected to a different keyspace.
+ *
+ * <b>Important:</b> Remove the file after changing the schema of the tables
+ * used by the persisted statements. Otherwise, the bound parameters of the
+ * statements might not match the new schema.
+ *
+ * <b>Default:</b> An empty string (disabled)
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] path The path of the file.
+ */
+CASS_EXPORT void
+cass_cluster_set_prepared_statements_file(CassCluster* cluster,
+                                          const char* path);
+
+/**
+ * Same as cass_cluster_set_prepared_statements_file(), but with lengths for
+ * string parameters.
+ *
+ * @public @memberof CassCluster
+ *
+ * @param[in] cluster
+ * @param[in] path
+ * @param[in] path_length
+ *
+ * @see cass_cluster_set_prepared_statements_file()
+ */
+CASS_EXPORT void
+cass_cluster_set_prepared_statements_file_n(CassCluster* cluster,
+                                            const char* path,
+                                            size_t path_length);
+
 /**
  * Enable the <b>NO_COMPACT</b> startup option.
  *
@@ -3087,6 +3906,32 @@ CASS_EXPORT CassFuture*
 cass_session_execute(CassSession* session,
                      const CassStatement* statement);
 
+/**
+ * Execute several query or bound statements at once. This is equivalent to
+ * calling cass_session_execute() for each statement, but the statements are
+ * handed off to the driver's I/O threads in bulk, which reduces the
+ * per-statement overhead when submitting many statements at once.
+ *
+ * <b>Note:</b> The statements are independent requests and are not executed
+ * as a batch (see cass_session_execute_batch()). They may be executed in any
+ * order.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] statements An array of statements.
+ * @param[in] count The number of statements.
+ * @param[out] futures An array with room for `count` futures. Each future
+ * corresponds to the statement at the same index and must be freed.
+ *
+ * @see cass_future_get_result()
+ */
+CASS_EXPORT void
+cass_session_execute_many(CassSession* session,
+                          const CassStatement* const* statements,
+                          size_t count,
+                          CassFuture** futures);
+
 /**
  * Execute a batch statement.
  *
@@ -3104,6 +3949,138 @@ CASS_EXPORT CassFuture*
 cass_session_execute_batch(CassSession* session,
                            const CassBatch* batch);
 
+/**
+ * Execute a query or bound statement and post its completion to a completion
+ * queue instead of returning a future.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] statement
+ * @param[in] queue
+ * @param[in] tag A user defined tag that's returned with the completion.
+ * @return CASS_OK if the statement was executed, or
+ * CASS_ERROR_LIB_REQUEST_QUEUE_FULL if the queue's capacity of outstanding
+ * completions is reached (the statement isn't executed).
+ *
+ * @see cass_completion_queue_drain()
+ */
+CASS_EXPORT CassError
+cass_session_execute_with_completion_queue(CassSession* session,
+                                           const CassStatement* statement,
+                                           CassCompletionQueue* queue,
+                                           void* tag);
+
+/**
+ * Execute a statement template using the values that are currently bound.
+ * The values are copied so the template can be bound with new values as soon
+ * as this function returns.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] statement_template
+ * @return A future that must be freed.
+ *
+ * @see cass_statement_template_new()
+ * @see cass_future_get_result()
+ */
+CASS_EXPORT CassFuture*
+cass_session_execute_template(CassSession* session,
+                              const CassStatementTemplate* statement_template);
+
+/**
+ * Scans all the rows of a table. The token ring is split into ranges using
+ * the session's token map and each range is queried using
+ * "token(<partition key>) > ? AND token(<partition key>) <= ?". The range
+ * queries are routed to the range's replicas and are interleaved across the
+ * replicas so that no single replica is scanned more heavily than the others.
+ *
+ * Every page of rows (up to 5000 rows) is passed to the callback as it
+ * arrives. The callback is run on the driver's I/O threads and may be called
+ * concurrently for different token ranges; it must not block.
+ *
+ * <b>Note:</b> This requires token-aware routing, schema metadata and the
+ * Murmur3 partitioner. The range queries are idempotent and use the default
+ * execution profile.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] keyspace
+ * @param[in] table
+ * @param[in] concurrency The maximum number of token ranges queried at the
+ * same time.
+ * @param[in] callback A callback that's notified for each page of rows.
+ * @param[in] data User data passed to the callback.
+ * @return A future that must be freed. The future is set after all the
+ * token ranges have been scanned or with the first error encountered. The
+ * callback is not called after the future is set.
+ *
+ * @see cass_session_execute()
+ */
+CASS_EXPORT CassFuture*
+cass_session_scan_table(CassSession* session,
+                        const char* keyspace,
+                        const char* table,
+                        unsigned concurrency,
+                        CassTableScanCallback callback,
+                        void* data);
+
+/**
+ * Same as cass_session_scan_table(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] keyspace
+ * @param[in] keyspace_length
+ * @param[in] table
+ * @param[in] table_length
+ * @param[in] concurrency
+ * @param[in] callback
+ * @param[in] data
+ * @return same as cass_session_scan_table()
+ *
+ * @see cass_session_scan_table()
+ */
+CASS_EXPORT CassFuture*
+cass_session_scan_table_n(CassSession* session,
+                          const char* keyspace,
+                          size_t keyspace_length,
+                          const char* table,
+                          size_t table_length,
+                          unsigned concurrency,
+                          CassTableScanCallback callback,
+                          void* data);
+
+/**
+ * Executes a query or bound statement using continuous paging. The server
+ * streams all the pages of the result on the same request instead of the
+ * driver requesting each page separately. The pages are retrieved, in order,
+ * using cass_result_stream_next().
+ *
+ * <b>Note:</b> Continuous paging requires DataStax Enterprise (a DSE protocol
+ * version). For the DSEv2 protocol and higher the number of pages the server
+ * sends ahead of the application is bounded, otherwise use the
+ * `pages_per_second` setting to limit the rate. Requests using continuous
+ * paging are not retried after pages have been received and don't use
+ * speculative executions.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] statement
+ * @return A result stream that must be freed.
+ *
+ * @see cass_statement_set_continuous_paging()
+ * @see cass_result_stream_free()
+ */
+CASS_EXPORT CassResultStream*
+cass_session_execute_continuous(CassSession* session,
+                                const CassStatement* statement);
+
 /**
  * Gets a snapshot of this session's schema metadata. The returned
  * snapshot of the schema metadata is not updated. This function
@@ -3132,6 +4109,46 @@ CASS_EXPORT void
 cass_session_get_metrics(const CassSession* session,
                          CassMetrics* output);
 
+/**
+ * Gets the request latencies of a recent window of time. Unlike the latencies
+ * returned by cass_session_get_metrics(), which cover every request since the
+ * session was connected, these only cover the most recent minute, five
+ * minutes or fifteen minutes.
+ *
+ * The windows move in steps of 15 seconds, so a window covers between 15
+ * seconds less than its length and its full length. The latencies of the
+ * windows are recorded with two significant figures.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] window
+ * @param[out] output
+ */
+CASS_EXPORT void
+cass_session_get_windowed_metrics(const CassSession* session,
+                                  CassMetricsWindow window,
+                                  CassLatencyMetrics* output);
+
+/**
+ * Gets the latencies between the stages of the session's requests. This tells
+ * whether the time of the requests is spent in the driver's queues, on the I/O
+ * threads or on the server. Only the execution whose response is used is
+ * recorded for each request.
+ *
+ * <b>Note:</b> All the latencies are zero unless request timings are enabled.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_request_timings()
+ */
+CASS_EXPORT void
+cass_session_get_request_stage_metrics(const CassSession* session,
+                                       CassRequestStageMetrics* output);
+
 /**
  * Gets a copy of this session's speculative execution metrics.
  *
@@ -3144,6 +4161,118 @@ CASS_EXPORT void
 cass_session_get_speculative_execution_metrics(const CassSession* session,
                                                CassSpeculativeExecutionMetrics* output);
 
+/**
+ * Gets a copy of this session's outlier detection metrics.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_outlier_detection()
+ */
+CASS_EXPORT void
+cass_session_get_outlier_detection_metrics(const CassSession* session,
+                                           CassOutlierDetectionMetrics* output);
+
+/**
+ * Gets a copy of this session's metrics for preparing cached prepared
+ * statements on hosts that become available again or are added to the
+ * cluster.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_prepare_on_up_or_add_host()
+ */
+CASS_EXPORT void
+cass_session_get_prepare_host_metrics(const CassSession* session,
+                                      CassPrepareHostMetrics* output);
+
+/**
+ * Gets a copy of this session's future callback metrics. This includes the
+ * time spent running application callbacks on the driver's I/O threads.
+ *
+ * <b>Note:</b> Sessions that share a callback executor also share its
+ * metrics.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output
+ *
+ * @see cass_cluster_set_callback_executor()
+ */
+CASS_EXPORT void
+cass_session_get_callback_metrics(const CassSession* session,
+                                  CassCallbackMetrics* output);
+
+/**
+ * Gets a copy of this session's per-host request metrics. Each request
+ * execution, including retries and speculative executions, is recorded
+ * for the host it was sent to. The latencies are measured on the driver's
+ * I/O threads from when the execution started until its response was
+ * received.
+ *
+ * Hosts are included once they're added to the session and are removed
+ * when they're removed from the cluster.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output An array of at least `count` host metrics. This can be
+ * NULL if `count` is 0.
+ * @param[in] count The number of host metrics to copy.
+ * @return The total number of hosts with metrics. Call again with a larger
+ * array if this is greater than `count`.
+ *
+ * @see cass_session_get_dc_metrics()
+ */
+CASS_EXPORT size_t
+cass_session_get_host_metrics(const CassSession* session,
+                              CassHostMetrics* output,
+                              size_t count);
+
+/**
+ * Gets a copy of this session's request metrics aggregated for each data
+ * center.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[out] output An array of at least `count` data center metrics. This
+ * can be NULL if `count` is 0.
+ * @param[in] count The number of data center metrics to copy.
+ * @return The total number of data centers with metrics.
+ *
+ * @see cass_session_get_host_metrics()
+ */
+CASS_EXPORT size_t
+cass_session_get_dc_metrics(const CassSession* session,
+                            CassDcMetrics* output,
+                            size_t count);
+
+/**
+ * Gets a copy of the latency statistics of the slowest statements.
+ *
+ * @public @memberof CassSession
+ *
+ * @param[in] session
+ * @param[in] order How the statements are ranked.
+ * @param[out] output An array of at least `count` statement metrics.
+ * @param[in] count The maximum number of statements to copy.
+ * @return The number of statements copied.
+ *
+ * @see cass_cluster_set_statement_metrics_size()
+ */
+CASS_EXPORT size_t
+cass_session_get_statement_metrics(const CassSession* session,
+                                   CassStatementMetricsOrder order,
+                                   CassStatementMetrics* output,
+                                   size_t count);
+
 /**
  * Get the client id.
  *
@@ -4837,6 +5966,19 @@ cass_future_set_callback(CassFuture* future,
                          CassFutureCallback callback,
                          void* data);
 
+/**
+ * Runs a batch of future callbacks that was handed off to the application's
+ * executor and frees the batch.
+ *
+ * @public @memberof CassCallbackBatch
+ *
+ * @param[in] batch
+ *
+ * @see cass_cluster_set_callback_executor()
+ */
+CASS_EXPORT void
+cass_callback_batch_run(CassCallbackBatch* batch);
+
 /**
  * Gets the set status of the future.
  *
@@ -4874,6 +6016,50 @@ CASS_EXPORT cass_bool_t
 cass_future_wait_timed(CassFuture* future,
                        cass_duration_t timeout_us);
 
+/**
+ * Wait for all the futures to be set or timeout. The waiting thread is woken
+ * up once, when the last future is set, instead of once for each future.
+ *
+ * <b>Important:</b> Do not wait in a future callback. Waiting in a future
+ * callback will cause a deadlock.
+ *
+ * @public @memberof CassFuture
+ *
+ * @param[in] futures An array of futures.
+ * @param[in] count The number of futures.
+ * @param[in] timeout_us wait time in microseconds
+ * @return false if returned due to timeout
+ *
+ * @see cass_future_wait_any()
+ */
+CASS_EXPORT cass_bool_t
+cass_future_wait_all(CassFuture* const* futures,
+                     size_t count,
+                     cass_duration_t timeout_us);
+
+/**
+ * Wait for any of the futures to be set or timeout.
+ *
+ * <b>Important:</b> Do not wait in a future callback. Waiting in a future
+ * callback will cause a deadlock.
+ *
+ * @public @memberof CassFuture
+ *
+ * @param[in] futures An array of futures.
+ * @param[in] count The number of futures.
+ * @param[in] timeout_us wait time in microseconds
+ * @param[out] index The index of the first future in the array that's set,
+ * or `count` if returned due to timeout. Can be NULL.
+ * @return false if returned due to timeout
+ *
+ * @see cass_future_wait_all()
+ */
+CASS_EXPORT cass_bool_t
+cass_future_wait_any(CassFuture* const* futures,
+                     size_t count,
+                     cass_duration_t timeout_us,
+                     size_t* index);
+
 /**
  * Gets the result of a successful future. If the future is not ready this method will
  * wait for the future to be set.
@@ -4964,6 +6150,26 @@ CASS_EXPORT CassError
 cass_future_tracing_id(CassFuture* future,
                        CassUuid* tracing_id);
 
+/**
+ * Gets the times at which the request reached each stage of its lifecycle. If
+ * the future is not ready this method will wait for the future to be set. The
+ * time the callback was invoked is only available once the callback has
+ * started running.
+ *
+ * @public @memberof CassFuture
+ *
+ * @param[in] future
+ * @param[out] timings
+ * @return CASS_OK if successful, CASS_ERROR_LIB_INVALID_FUTURE_TYPE if the
+ * future isn't the future of a request and CASS_ERROR_LIB_INVALID_STATE if
+ * request timings aren't enabled.
+ *
+ * @see cass_cluster_set_request_timings()
+ */
+CASS_EXPORT CassError
+cass_future_timings(CassFuture* future,
+                    CassRequestTimings* timings);
+
 /**
  * Gets a the number of custom payload items from a response future. If the future is not
  * ready this method will wait for the future to be set.
@@ -5002,6 +6208,186 @@ cass_future_custom_payload_item(CassFuture* future,
                                 const cass_byte_t** value,
                                 size_t* value_size);
 
+/**
+ * Sets a completion queue that a completion is posted to when the future is
+ * set. This can't be used with cass_future_set_callback().
+ *
+ * @public @memberof CassFuture
+ *
+ * @param[in] future
+ * @param[in] queue
+ * @param[in] tag A user defined tag that's returned with the completion.
+ * @return CASS_OK if successful, CASS_ERROR_LIB_REQUEST_QUEUE_FULL if the
+ * queue's capacity of outstanding completions is reached, otherwise an error
+ * occurred.
+ *
+ * @see cass_session_execute_with_completion_queue()
+ */
+CASS_EXPORT CassError
+cass_future_set_completion_queue(CassFuture* future,
+                                 CassCompletionQueue* queue,
+                                 void* tag);
+
+/***********************************************************************************
+ *
+ * Completion Queue
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a new completion queue.
+ *
+ * @public @memberof CassCompletionQueue
+ *
+ * @param[in] capacity The maximum number of outstanding completions. This
+ * includes requests that haven't completed and completions that haven't been
+ * drained.
+ * @return Returns a completion queue that must be freed, or NULL if the
+ * capacity is zero.
+ *
+ * @see cass_completion_queue_free()
+ */
+CASS_EXPORT CassCompletionQueue*
+cass_completion_queue_new(size_t capacity);
+
+/**
+ * Frees a completion queue instance. Requests that are still outstanding
+ * keep the queue alive until they complete. Completions that are never
+ * drained are freed with the queue.
+ *
+ * @public @memberof CassCompletionQueue
+ *
+ * @param[in] queue
+ */
+CASS_EXPORT void
+cass_completion_queue_free(CassCompletionQueue* queue);
+
+/**
+ * Removes up to `count` completions from the queue without blocking. The
+ * future of each completion must be freed.
+ *
+ * @public @memberof CassCompletionQueue
+ *
+ * @param[in] queue
+ * @param[out] completions An array of at least `count` completions.
+ * @param[in] count
+ * @return The number of completions removed.
+ */
+CASS_EXPORT size_t
+cass_completion_queue_drain(CassCompletionQueue* queue,
+                            CassCompletion* completions,
+                            size_t count);
+
+/***********************************************************************************
+ *
+ * Bulk Executor
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a new bulk executor. The executor keeps up to `max_in_flight`
+ * requests in flight across the session and pulls the next statement from
+ * the callback as soon as a request completes.
+ *
+ * <b>Note:</b> The callback is run on the driver's I/O threads (and on the
+ * thread that calls cass_bulk_executor_execute()). It's never called
+ * concurrently, but it must not block. It may use the executor, e.g. to get
+ * its metrics using cass_bulk_executor_get_metrics().
+ *
+ * @public @memberof CassBulkExecutor
+ *
+ * @param[in] session A connected session.
+ * @param[in] max_in_flight The maximum number of requests in flight.
+ * @param[in] next_callback A callback that provides the statements.
+ * @param[in] data User data passed to the callback.
+ * @return Returns a bulk executor that must be freed, or NULL if the maximum
+ * number of requests in flight is zero or the callback is NULL.
+ *
+ * @see cass_bulk_executor_free()
+ */
+CASS_EXPORT CassBulkExecutor*
+cass_bulk_executor_new(CassSession* session,
+                       unsigned max_in_flight,
+                       CassBulkExecutorNextCallback next_callback,
+                       void* data);
+
+/**
+ * Frees a bulk executor instance. An executor that's running keeps executing
+ * statements until the callback runs out of statements.
+ *
+ * @public @memberof CassBulkExecutor
+ *
+ * @param[in] executor
+ */
+CASS_EXPORT void
+cass_bulk_executor_free(CassBulkExecutor* executor);
+
+/**
+ * Sets the target rate of the executor. This must be set before the executor
+ * is started.
+ *
+ * <b>Default:</b> 0 (unlimited)
+ *
+ * @public @memberof CassBulkExecutor
+ *
+ * @param[in] executor
+ * @param[in] requests_per_second The maximum number of requests started per
+ * second. A value of zero disables the rate limit.
+ */
+CASS_EXPORT void
+cass_bulk_executor_set_rate(CassBulkExecutor* executor,
+                            unsigned requests_per_second);
+
+/**
+ * Sets a callback that's called with the future of each completed request.
+ * This must be set before the executor is started.
+ *
+ * <b>Note:</b> The callback is run on the driver's I/O threads and may be
+ * called concurrently. The future is owned by the executor and must not be
+ * freed.
+ *
+ * @public @memberof CassBulkExecutor
+ *
+ * @param[in] executor
+ * @param[in] callback
+ * @param[in] data
+ */
+CASS_EXPORT void
+cass_bulk_executor_set_result_callback(CassBulkExecutor* executor,
+                                       CassFutureCallback callback,
+                                       void* data);
+
+/**
+ * Starts executing statements. Calling this more than once returns the
+ * future of the first call.
+ *
+ * @public @memberof CassBulkExecutor
+ *
+ * @param[in] executor
+ * @return A future that must be freed. It's set once the callback has run
+ * out of statements and all the requests have completed, or with an error if
+ * the session isn't connected. Requests that fail don't fail the future;
+ * they're passed to the result callback and counted in the executor's
+ * metrics.
+ *
+ * @see cass_bulk_executor_get_metrics()
+ */
+CASS_EXPORT CassFuture*
+cass_bulk_executor_execute(CassBulkExecutor* executor);
+
+/**
+ * Gets a snapshot of the executor's aggregate throughput, errors and
+ * latency.
+ *
+ * @public @memberof CassBulkExecutor
+ *
+ * @param[in] executor
+ * @param[out] output
+ */
+CASS_EXPORT void
+cass_bulk_executor_get_metrics(const CassBulkExecutor* executor,
+                               CassBulkExecutorMetrics* output);
+
 /***********************************************************************************
  *
  * Statement
@@ -5212,6 +6598,63 @@ cass_statement_set_paging_state_token(CassStatement* statement,
                                       const char* paging_state,
                                       size_t paging_state_size);
 
+/**
+ * Sets the number of pages to request ahead of the application for a paged
+ * query. While the application processes a page the driver requests the
+ * following pages. Re-executing the statement with the paging state of a
+ * received page (using cass_statement_set_paging_state() or
+ * cass_statement_set_paging_state_token()) returns the page that's already in
+ * flight, or already received, instead of issuing a new request.
+ *
+ * The number of prefetched pages that haven't been retrieved by the
+ * application is bounded by this setting to limit memory usage. Executing the
+ * statement with any other paging state (e.g. the first page) starts a new
+ * sequence of pages and discards previously prefetched pages. A statement that
+ * prefetches pages should only be used for a single paged query at a time.
+ *
+ * <b>Default:</b> 0 (disabled)
+ *
+ * @cassandra{2.0+}
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] pages The maximum number of pages to prefetch. A value of 0
+ * disables prefetching.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_set_paging_size()
+ */
+CASS_EXPORT CassError
+cass_statement_set_prefetch_pages(CassStatement* statement,
+                                  unsigned pages);
+
+/**
+ * Sets the options used when the statement is executed using continuous
+ * paging.
+ *
+ * <b>Default:</b> No limits and a page size of 5000 rows (or the statement's
+ * paging size, if set).
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] max_pages The maximum number of pages returned. A value of 0
+ * means no limit.
+ * @param[in] pages_per_second The maximum number of pages the server sends
+ * per second. A value of 0 means no limit.
+ * @param[in] page_size_bytes The size of the pages in bytes instead of rows.
+ * A value of 0 uses a page size in rows.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_session_execute_continuous()
+ */
+CASS_EXPORT CassError
+cass_statement_set_continuous_paging(CassStatement* statement,
+                                     int max_pages,
+                                     int pages_per_second,
+                                     int page_size_bytes);
+
 /**
  * Sets the statement's timestamp.
  *
@@ -5252,15 +6695,41 @@ cass_statement_set_request_timeout(CassStatement* statement,
  * @public @memberof CassStatement
  *
  * @param[in] statement
- * @param[in] is_idempotent
+ * @param[in] is_idempotent
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_constant_speculative_execution_policy()
+ * @see cass_execution_profile_set_constant_speculative_execution_policy()
+ */
+CASS_EXPORT CassError
+cass_statement_set_is_idempotent(CassStatement* statement,
+                                 cass_bool_t is_idempotent);
+
+/**
+ * Sets whether a simple statement uses the session's prepared statement
+ * cache. The query is prepared in the background the first time it's
+ * executed and later executions send the prepared statement's ID and the
+ * bound values instead of the query text, which avoids parsing the query on
+ * the server. The cache is keyed by the query text and the statement's
+ * keyspace.
+ *
+ * <b>Note:</b> Statements with values bound by name are always executed as
+ * simple statements.
+ *
+ * <b>Default:</b> cass_false
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] is_cacheable
  * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_INVALID_STATEMENT_TYPE is returned for bound statements.
  *
- * @see cass_cluster_set_constant_speculative_execution_policy()
- * @see cass_execution_profile_set_constant_speculative_execution_policy()
+ * @see cass_cluster_set_prepared_cache_size()
  */
 CASS_EXPORT CassError
-cass_statement_set_is_idempotent(CassStatement* statement,
-                                 cass_bool_t is_idempotent);
+cass_statement_set_is_cacheable(CassStatement* statement,
+                                cass_bool_t is_cacheable);
 
 /**
  * Sets the statement's retry policy.
@@ -5325,6 +6794,40 @@ cass_statement_set_execution_profile_n(CassStatement* statement,
                                        const char* name,
                                        size_t name_length);
 
+/**
+ * Sets a label that identifies the statement in the session's per-statement
+ * latency statistics. Statements with the same label are recorded together.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] label The label or an empty string to remove the label.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_statement_metrics_size()
+ */
+CASS_EXPORT CassError
+cass_statement_set_label(CassStatement* statement,
+                        const char* label);
+
+/**
+ * Same as cass_statement_set_label(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] label
+ * @param[in] label_length
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_set_label()
+ */
+CASS_EXPORT CassError
+cass_statement_set_label_n(CassStatement* statement,
+                          const char* label,
+                          size_t label_length);
+
 /**
  * Sets whether the statement should use tracing.
  *
@@ -6454,163 +7957,469 @@ cass_statement_bind_tuple_by_name(CassStatement* statement,
  * @param[in] tuple
  * @return same as cass_statement_bind_tuple_by_name()
  *
- * @see cass_statement_bind_tuple_by_name()
+ * @see cass_statement_bind_tuple_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_tuple_by_name_n(CassStatement* statement,
+                                    const char* name,
+                                    size_t name_length,
+                                    const CassTuple* tuple);
+
+/**
+ * Bind a user defined type to a query or bound statement at the
+ * specified index.
+ *
+ * @cassandra{2.1+}
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] index
+ * @param[in] user_type The user type can be freed after this call.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_bind_user_type(CassStatement* statement,
+                              size_t index,
+                              const CassUserType* user_type);
+/**
+ * Bind a user defined type to a query or bound statement with the
+ * specified name.
+ *
+ * @cassandra{2.1+}
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] user_type The user type can be freed after this call.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_bind_user_type_by_name(CassStatement* statement,
+                                      const char* name,
+                                      const CassUserType* user_type);
+
+/**
+ * Same as cass_statement_bind_user_type_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @cassandra{2.1+}
+ *
+ * @public @memberof CassStatement
+ *
+ * @param[in] statement
+ * @param[in] name
+ * @param[in] name_length
+ * @param[in] user_type
+ * @return same as cass_statement_bind_user_type_by_name()
+ *
+ * @see cass_statement_bind_collection_by_name()
+ */
+CASS_EXPORT CassError
+cass_statement_bind_user_type_by_name_n(CassStatement* statement,
+                                        const char* name,
+                                        size_t name_length,
+                                        const CassUserType* user_type);
+
+/***********************************************************************************
+ *
+ * Prepared
+ *
+ ***********************************************************************************/
+
+/**
+ * Frees a prepared instance.
+ *
+ * @public @memberof CassPrepared
+ *
+ * @param[in] prepared
+ */
+CASS_EXPORT void
+cass_prepared_free(const CassPrepared* prepared);
+
+/**
+ * Creates a bound statement from a pre-prepared statement.
+ *
+ * @public @memberof CassPrepared
+ *
+ * @param[in] prepared
+ * @return Returns a bound statement that must be freed.
+ *
+ * @see cass_statement_free()
+ */
+CASS_EXPORT CassStatement*
+cass_prepared_bind(const CassPrepared* prepared);
+
+/**
+ * Gets the name of a parameter at the specified index.
+ *
+ * @public @memberof CassPrepared
+ *
+ * @param[in] prepared
+ * @param[in] index
+ * @param[out] name
+ * @param[out] name_length
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_prepared_parameter_name(const CassPrepared* prepared,
+                             size_t index,
+                             const char** name,
+                             size_t* name_length);
+
+/**
+ * Gets the data type of a parameter at the specified index.
+ *
+ * @public @memberof CassPrepared
+ *
+ * @param[in] prepared
+ * @param[in] index
+ * @return Returns a reference to the data type of the parameter. Do not free
+ * this reference as it is bound to the lifetime of the prepared.
+ */
+CASS_EXPORT const CassDataType*
+cass_prepared_parameter_data_type(const CassPrepared* prepared,
+                                  size_t index);
+
+/**
+ * Gets the data type of a parameter for the specified name.
+ *
+ * @public @memberof CassPrepared
+ *
+ * @param[in] prepared
+ * @param[in] name
+ * @return Returns a reference to the data type of the parameter. Do not free
+ * this reference as it is bound to the lifetime of the prepared.
+ */
+CASS_EXPORT const CassDataType*
+cass_prepared_parameter_data_type_by_name(const CassPrepared* prepared,
+                                          const char* name);
+
+/**
+ * Same as cass_prepared_parameter_data_type_by_name(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassPrepared
+ *
+ * @param[in] prepared
+ * @param[in] name
+ * @param[in] name_length
+ * @return Returns a reference to the data type of the parameter. Do not free
+ * this reference as it is bound to the lifetime of the prepared.
+ *
+ * @see cass_prepared_parameter_data_type_by_name()
+ */
+CASS_EXPORT const CassDataType*
+cass_prepared_parameter_data_type_by_name_n(const CassPrepared* prepared,
+                                            const char* name,
+                                            size_t name_length);
+
+/***********************************************************************************
+ *
+ * Statement Template
+ *
+ ***********************************************************************************/
+
+/**
+ * Creates a statement template from a pre-prepared statement. All the values
+ * start out as unset.
+ *
+ * @public @memberof CassStatementTemplate
+ *
+ * @param[in] prepared
+ * @return Returns a statement template that must be freed.
+ *
+ * @see cass_statement_template_free()
+ * @see cass_session_execute_template()
+ */
+CASS_EXPORT CassStatementTemplate*
+cass_statement_template_new(const CassPrepared* prepared);
+
+/**
+ * Frees a statement template instance.
+ *
+ * @public @memberof CassStatementTemplate
+ *
+ * @param[in] statement_template
+ */
+CASS_EXPORT void
+cass_statement_template_free(CassStatementTemplate* statement_template);
+
+/**
+ * Sets the statement template's consistency level.
+ *
+ * <b>Default:</b> CASS_CONSISTENCY_LOCAL_ONE
+ *
+ * @public @memberof CassStatementTemplate
+ *
+ * @param[in] statement_template
+ * @param[in] consistency
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_template_set_consistency(CassStatementTemplate* statement_template,
+                                        CassConsistency consistency);
+
+/**
+ * Sets whether the statement template is idempotent. Idempotent statements
+ * are able to be automatically retried after timeouts/errors and can be
+ * speculatively executed.
+ *
+ * @public @memberof CassStatementTemplate
+ *
+ * @param[in] statement_template
+ * @param[in] is_idempotent
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_set_is_idempotent()
+ */
+CASS_EXPORT CassError
+cass_statement_template_set_is_idempotent(CassStatementTemplate* statement_template,
+                                          cass_bool_t is_idempotent);
+
+/**
+ * Binds null to the statement template at the specified index.
+ *
+ * @public @memberof CassStatementTemplate
+ *
+ * @param[in] statement_template
+ * @param[in] index
+ * @return CASS_OK if successful, otherwise an error occurred.
+ */
+CASS_EXPORT CassError
+cass_statement_template_bind_null(CassStatementTemplate* statement_template,
+                                  size_t index);
+
+/**
+ * Binds a "tinyint" to the statement template at the specified index.
+ *
+ * @public @memberof CassStatementTemplate
+ *
+ * @param[in] statement_template
+ * @param[in] index
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_int8()
+ */
+CASS_EXPORT CassError
+cass_statement_template_bind_int8(CassStatementTemplate* statement_template,
+                                  size_t index,
+                                  cass_int8_t value);
+
+/**
+ * Binds a "smallint" to the statement template at the specified index.
+ *
+ * @public @memberof CassStatementTemplate
+ *
+ * @param[in] statement_template
+ * @param[in] index
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_int16()
+ */
+CASS_EXPORT CassError
+cass_statement_template_bind_int16(CassStatementTemplate* statement_template,
+                                   size_t index,
+                                   cass_int16_t value);
+
+/**
+ * Binds an "int" to the statement template at the specified index.
+ *
+ * @public @memberof CassStatementTemplate
+ *
+ * @param[in] statement_template
+ * @param[in] index
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_int32()
  */
 CASS_EXPORT CassError
-cass_statement_bind_tuple_by_name_n(CassStatement* statement,
-                                    const char* name,
-                                    size_t name_length,
-                                    const CassTuple* tuple);
+cass_statement_template_bind_int32(CassStatementTemplate* statement_template,
+                                   size_t index,
+                                   cass_int32_t value);
 
 /**
- * Bind a user defined type to a query or bound statement at the
- * specified index.
- *
- * @cassandra{2.1+}
+ * Binds a "date" to the statement template at the specified index.
  *
- * @public @memberof CassStatement
+ * @public @memberof CassStatementTemplate
  *
- * @param[in] statement
+ * @param[in] statement_template
  * @param[in] index
- * @param[in] user_type The user type can be freed after this call.
+ * @param[in] value
  * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_uint32()
  */
 CASS_EXPORT CassError
-cass_statement_bind_user_type(CassStatement* statement,
-                              size_t index,
-                              const CassUserType* user_type);
+cass_statement_template_bind_uint32(CassStatementTemplate* statement_template,
+                                    size_t index,
+                                    cass_uint32_t value);
+
 /**
- * Bind a user defined type to a query or bound statement with the
- * specified name.
- *
- * @cassandra{2.1+}
+ * Binds a "bigint", "counter", "timestamp" or "time" to the statement
+ * template at the specified index.
  *
- * @public @memberof CassStatement
+ * @public @memberof CassStatementTemplate
  *
- * @param[in] statement
- * @param[in] name
- * @param[in] user_type The user type can be freed after this call.
+ * @param[in] statement_template
+ * @param[in] index
+ * @param[in] value
  * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_int64()
  */
 CASS_EXPORT CassError
-cass_statement_bind_user_type_by_name(CassStatement* statement,
-                                      const char* name,
-                                      const CassUserType* user_type);
+cass_statement_template_bind_int64(CassStatementTemplate* statement_template,
+                                   size_t index,
+                                   cass_int64_t value);
 
 /**
- * Same as cass_statement_bind_user_type_by_name(), but with lengths for string
- * parameters.
- *
- * @cassandra{2.1+}
+ * Binds a "float" to the statement template at the specified index.
  *
- * @public @memberof CassStatement
+ * @public @memberof CassStatementTemplate
  *
- * @param[in] statement
- * @param[in] name
- * @param[in] name_length
- * @param[in] user_type
- * @return same as cass_statement_bind_user_type_by_name()
+ * @param[in] statement_template
+ * @param[in] index
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
  *
- * @see cass_statement_bind_collection_by_name()
+ * @see cass_statement_bind_float()
  */
 CASS_EXPORT CassError
-cass_statement_bind_user_type_by_name_n(CassStatement* statement,
-                                        const char* name,
-                                        size_t name_length,
-                                        const CassUserType* user_type);
+cass_statement_template_bind_float(CassStatementTemplate* statement_template,
+                                   size_t index,
+                                   cass_float_t value);
 
-/***********************************************************************************
+/**
+ * Binds a "double" to the statement template at the specified index.
  *
- * Prepared
+ * @public @memberof CassStatementTemplate
  *
- ***********************************************************************************/
+ * @param[in] statement_template
+ * @param[in] index
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_double()
+ */
+CASS_EXPORT CassError
+cass_statement_template_bind_double(CassStatementTemplate* statement_template,
+                                    size_t index,
+                                    cass_double_t value);
 
 /**
- * Frees a prepared instance.
+ * Binds a "boolean" to the statement template at the specified index.
  *
- * @public @memberof CassPrepared
+ * @public @memberof CassStatementTemplate
  *
- * @param[in] prepared
+ * @param[in] statement_template
+ * @param[in] index
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_bool()
  */
-CASS_EXPORT void
-cass_prepared_free(const CassPrepared* prepared);
+CASS_EXPORT CassError
+cass_statement_template_bind_bool(CassStatementTemplate* statement_template,
+                                  size_t index,
+                                  cass_bool_t value);
 
 /**
- * Creates a bound statement from a pre-prepared statement.
+ * Binds an "ascii", "text" or "varchar" to the statement template at the
+ * specified index.
  *
- * @public @memberof CassPrepared
+ * @public @memberof CassStatementTemplate
  *
- * @param[in] prepared
- * @return Returns a bound statement that must be freed.
+ * @param[in] statement_template
+ * @param[in] index
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
  *
- * @see cass_statement_free()
+ * @see cass_statement_bind_string()
  */
-CASS_EXPORT CassStatement*
-cass_prepared_bind(const CassPrepared* prepared);
+CASS_EXPORT CassError
+cass_statement_template_bind_string(CassStatementTemplate* statement_template,
+                                    size_t index,
+                                    const char* value);
 
 /**
- * Gets the name of a parameter at the specified index.
+ * Same as cass_statement_template_bind_string(), but with lengths for string
+ * parameters.
  *
- * @public @memberof CassPrepared
+ * @public @memberof CassStatementTemplate
  *
- * @param[in] prepared
+ * @param[in] statement_template
  * @param[in] index
- * @param[out] name
- * @param[out] name_length
+ * @param[in] value
+ * @param[in] value_length
  * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_template_bind_string()
  */
 CASS_EXPORT CassError
-cass_prepared_parameter_name(const CassPrepared* prepared,
-                             size_t index,
-                             const char** name,
-                             size_t* name_length);
+cass_statement_template_bind_string_n(CassStatementTemplate* statement_template,
+                                      size_t index,
+                                      const char* value,
+                                      size_t value_length);
 
 /**
- * Gets the data type of a parameter at the specified index.
+ * Binds a "blob", "varint" or "custom" to the statement template at the
+ * specified index.
  *
- * @public @memberof CassPrepared
+ * @public @memberof CassStatementTemplate
  *
- * @param[in] prepared
+ * @param[in] statement_template
  * @param[in] index
- * @return Returns a reference to the data type of the parameter. Do not free
- * this reference as it is bound to the lifetime of the prepared.
+ * @param[in] value
+ * @param[in] value_size
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_bytes()
  */
-CASS_EXPORT const CassDataType*
-cass_prepared_parameter_data_type(const CassPrepared* prepared,
-                                  size_t index);
+CASS_EXPORT CassError
+cass_statement_template_bind_bytes(CassStatementTemplate* statement_template,
+                                   size_t index,
+                                   const cass_byte_t* value,
+                                   size_t value_size);
 
 /**
- * Gets the data type of a parameter for the specified name.
+ * Binds a "uuid" or "timeuuid" to the statement template at the specified
+ * index.
  *
- * @public @memberof CassPrepared
+ * @public @memberof CassStatementTemplate
  *
- * @param[in] prepared
- * @param[in] name
- * @return Returns a reference to the data type of the parameter. Do not free
- * this reference as it is bound to the lifetime of the prepared.
+ * @param[in] statement_template
+ * @param[in] index
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_statement_bind_uuid()
  */
-CASS_EXPORT const CassDataType*
-cass_prepared_parameter_data_type_by_name(const CassPrepared* prepared,
-                                          const char* name);
+CASS_EXPORT CassError
+cass_statement_template_bind_uuid(CassStatementTemplate* statement_template,
+                                  size_t index,
+                                  CassUuid value);
 
 /**
- * Same as cass_prepared_parameter_data_type_by_name(), but with lengths for string
- * parameters.
+ * Binds an "inet" to the statement template at the specified index.
  *
- * @public @memberof CassPrepared
+ * @public @memberof CassStatementTemplate
  *
- * @param[in] prepared
- * @param[in] name
- * @param[in] name_length
- * @return Returns a reference to the data type of the parameter. Do not free
- * this reference as it is bound to the lifetime of the prepared.
+ * @param[in] statement_template
+ * @param[in] index
+ * @param[in] value
+ * @return CASS_OK if successful, otherwise an error occurred.
  *
- * @see cass_prepared_parameter_data_type_by_name()
+ * @see cass_statement_bind_inet()
  */
-CASS_EXPORT const CassDataType*
-cass_prepared_parameter_data_type_by_name_n(const CassPrepared* prepared,
-                                            const char* name,
-                                            size_t name_length);
+CASS_EXPORT CassError
+cass_statement_template_bind_inet(CassStatementTemplate* statement_template,
+                                  size_t index,
+                                  CassInet value);
 
 /***********************************************************************************
  *
@@ -6859,6 +8668,40 @@ cass_batch_set_execution_profile_n(CassBatch* batch,
                                    const char* name,
                                    size_t name_length);
 
+/**
+ * Sets a label that identifies the batch in the session's per-statement
+ * latency statistics. Batches with the same label are recorded together.
+ *
+ * @public @memberof CassBatch
+ *
+ * @param[in] batch
+ * @param[in] label The label or an empty string to remove the label.
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_cluster_set_statement_metrics_size()
+ */
+CASS_EXPORT CassError
+cass_batch_set_label(CassBatch* batch,
+                    const char* label);
+
+/**
+ * Same as cass_batch_set_label(), but with lengths for string
+ * parameters.
+ *
+ * @public @memberof CassBatch
+ *
+ * @param[in] batch
+ * @param[in] label
+ * @param[in] label_length
+ * @return CASS_OK if successful, otherwise an error occurred.
+ *
+ * @see cass_batch_set_label()
+ */
+CASS_EXPORT CassError
+cass_batch_set_label_n(CassBatch* batch,
+                      const char* label,
+                      size_t label_length);
+
 /***********************************************************************************
  *
  * Data type
@@ -9431,6 +11274,168 @@ cass_result_paging_state_token(const CassResult* result,
                                const char** paging_state,
                                size_t* paging_state_size);
 
+/**
+ * Exports the rows of a result into per-column contiguous buffers. This avoids
+ * iterating over rows and retrieving each column value individually.
+ *
+ * The layout of the buffers is compatible with the Arrow C data interface:
+ *
+ * <ul>
+ *   <li>Fixed-width columns (int, bigint, counter, timestamp, float, double,
+ *   uuid and timeuuid) are exported as arrays of native-endian values (uuids
+ *   as 16 byte, big-endian binary values)</li>
+ *   <li>Variable-width columns (ascii, text, varchar and blob) are exported
+ *   as an array of 32-bit offsets (one more than the number of rows) into a
+ *   data buffer</li>
+ *   <li>Null values are tracked using a validity bitmap (least significant bit
+ *   ordering, a set bit indicates a non-null value)</li>
+ * </ul>
+ *
+ * The exported columns are copied and remain valid after the result is freed.
+ *
+ * @public @memberof CassResult
+ *
+ * @param[in] result
+ * @param[out] output A columnar result that must be freed using
+ * cass_columnar_result_free().
+ * @return CASS_OK if successful, otherwise an error occurred.
+ * CASS_ERROR_LIB_INVALID_VALUE_TYPE is returned if a column's type can't be
+ * exported and CASS_ERROR_LIB_INVALID_STATE if the result doesn't contain rows.
+ *
+ * @see cass_columnar_result_column()
+ */
+CASS_EXPORT CassError
+cass_result_export_columns(const CassResult* result,
+                           CassColumnarResult** output);
+
+/***********************************************************************************
+ *
+ * Columnar result
+ *
+ ***********************************************************************************/
+
+/**
+ * The buffers of an exported column.
+ *
+ * @struct CassColumnBuffers
+ */
+typedef struct CassColumnBuffers_ {
+  CassValueType type; /**< The column's type */
+  size_t length; /**< The number of values (rows) */
+  size_t null_count; /**< The number of null values */
+  const cass_uint8_t* validity; /**< Validity bitmap, NULL if there are no null values */
+  const cass_int32_t* offsets; /**< Offsets into values (length + 1), NULL for fixed-width columns */
+  const cass_byte_t* values; /**< Fixed-width values or variable-width data */
+  size_t value_size; /**< The size of a fixed-width value, 0 for variable-width columns */
+} CassColumnBuffers;
+
+/**
+ * Frees a columnar result instance.
+ *
+ * This method invalidates all column buffers that were retrieved from
+ * the columnar result.
+ *
+ * @public @memberof CassColumnarResult
+ *
+ * @param[in] columns
+ */
+CASS_EXPORT void
+cass_columnar_result_free(CassColumnarResult* columns);
+
+/**
+ * Gets the number of rows for the specified columnar result.
+ *
+ * @public @memberof CassColumnarResult
+ *
+ * @param[in] columns
+ * @return The number of rows (the length of each column).
+ */
+CASS_EXPORT size_t
+cass_columnar_result_row_count(const CassColumnarResult* columns);
+
+/**
+ * Gets the number of columns for the specified columnar result.
+ *
+ * @public @memberof CassColumnarResult
+ *
+ * @param[in] columns
+ * @return The number of columns.
+ */
+CASS_EXPORT size_t
+cass_columnar_result_column_count(const CassColumnarResult* columns);
+
+/**
+ * Gets the buffers of the column at index for the specified columnar result.
+ * The buffers are bound to the lifetime of the columnar result.
+ *
+ * @public @memberof CassColumnarResult
+ *
+ * @param[in] columns
+ * @param[in] index
+ * @param[out] output
+ * @return CASS_OK if successful, otherwise CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS.
+ */
+CASS_EXPORT CassError
+cass_columnar_result_column(const CassColumnarResult* columns,
+                            size_t index,
+                            CassColumnBuffers* output);
+
+/***********************************************************************************
+ *
+ * Result stream
+ *
+ ***********************************************************************************/
+
+/**
+ * Frees a result stream instance. If the stream still has pages in flight
+ * the server is asked to stop sending pages.
+ *
+ * @public @memberof CassResultStream
+ *
+ * @param[in] stream
+ */
+CASS_EXPORT void
+cass_result_stream_free(CassResultStream* stream);
+
+/**
+ * Gets the next page of the stream. This blocks until the page is available.
+ *
+ * @public @memberof CassResultStream
+ *
+ * @param[in] stream
+ * @return The next page that must be freed using cass_result_free() or NULL
+ * when there are no more pages or an error occurred.
+ *
+ * @see cass_result_stream_error_code()
+ */
+CASS_EXPORT const CassResult*
+cass_result_stream_next(CassResultStream* stream);
+
+/**
+ * Gets the error code of the stream. This doesn't block.
+ *
+ * @public @memberof CassResultStream
+ *
+ * @param[in] stream
+ * @return CASS_OK if the request hasn't failed, otherwise the error code.
+ */
+CASS_EXPORT CassError
+cass_result_stream_error_code(CassResultStream* stream);
+
+/**
+ * Gets the error message of the stream. This doesn't block.
+ *
+ * @public @memberof CassResultStream
+ *
+ * @param[in] stream
+ * @param[out] message Empty string returned if the request hasn't failed.
+ * @param[out] message_length
+ */
+CASS_EXPORT void
+cass_result_stream_error_message(CassResultStream* stream,
+                                 const char** message,
+                                 size_t* message_length);
+
 /***********************************************************************************
  *
  * Error result
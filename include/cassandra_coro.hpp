@@ -0,0 +1,384 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef __CASS_CORO_HPP_INCLUDED__
+#define __CASS_CORO_HPP_INCLUDED__
+
+/**
+ * @file include/cassandra_coro.hpp
+ *
+ * An optional, header-only C++20 layer that allows coroutines to
+ * `co_await` the results of requests made using the C API.
+ *
+ * @code
+ * cass::coro::Task query(CassSession* session, CassStatement* statement) {
+ *   cass::coro::Result result = co_await cass::coro::execute(session, statement);
+ *   while (result) {
+ *     // Process the rows using result.get()
+ *     if (!result.has_more_pages()) break;
+ *     result = co_await cass::coro::next_page(session, statement, result);
+ *   }
+ * }
+ * @endcode
+ *
+ * The awaiter for a request lives in the coroutine's frame and is passed
+ * directly to cass_future_set_callback() so no additional heap allocations
+ * are made for each request. By default the coroutine is resumed inline on
+ * the thread that sets the future (usually one of the driver's I/O threads
+ * or the thread of the callback executor). An executor can be provided to
+ * resume the coroutine elsewhere; an executor is any copyable callable that
+ * accepts a `std::coroutine_handle<>` and eventually resumes it.
+ *
+ * <b>Note:</b> Coroutines resumed inline on an I/O thread must not block.
+ */
+
+#include "cassandra.h"
+
+#if defined(__cpp_impl_coroutine) && __cplusplus >= 202002L
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <string_view>
+#include <utility>
+
+namespace cass { namespace coro {
+
+/**
+ * Resumes the coroutine inline on the thread that sets the future.
+ */
+struct InlineExecutor {
+  void operator()(std::coroutine_handle<> handle) const { handle.resume(); }
+};
+
+/**
+ * An owning handle to a future that has been set. This is the base of the
+ * values produced by awaiting a request.
+ */
+class Response {
+public:
+  Response() noexcept
+      : future_(nullptr) {}
+
+  explicit Response(CassFuture* future) noexcept
+      : future_(future) {}
+
+  Response(Response&& other) noexcept
+      : future_(std::exchange(other.future_, nullptr)) {}
+
+  Response& operator=(Response&& other) noexcept {
+    if (this != &other) {
+      reset();
+      future_ = std::exchange(other.future_, nullptr);
+    }
+    return *this;
+  }
+
+  Response(const Response&) = delete;
+  Response& operator=(const Response&) = delete;
+
+  ~Response() { reset(); }
+
+  /**
+   * @return The underlying future or NULL if the response is empty.
+   */
+  CassFuture* future() const noexcept { return future_; }
+
+  /**
+   * @return The error code of the request. CASS_OK if the request succeeded.
+   */
+  CassError error_code() const noexcept {
+    return future_ != nullptr ? cass_future_error_code(future_) : CASS_ERROR_LIB_NULL_VALUE;
+  }
+
+  /**
+   * @return The error message of the request or an empty string if the
+   * request succeeded.
+   */
+  std::string_view error_message() const noexcept {
+    if (future_ == nullptr) return std::string_view();
+    const char* message;
+    size_t message_length;
+    cass_future_error_message(future_, &message, &message_length);
+    return std::string_view(message, message_length);
+  }
+
+  /**
+   * @return true if the request succeeded.
+   */
+  explicit operator bool() const noexcept { return error_code() == CASS_OK; }
+
+protected:
+  void reset() noexcept {
+    if (future_ != nullptr) {
+      cass_future_free(future_);
+      future_ = nullptr;
+    }
+  }
+
+private:
+  CassFuture* future_;
+};
+
+/**
+ * The result of awaiting execute() or next_page().
+ */
+class Result : public Response {
+public:
+  Result() noexcept
+      : result_(nullptr) {}
+
+  explicit Result(CassFuture* future) noexcept
+      : Response(future)
+      , result_(cass_future_get_result(future)) {}
+
+  Result(Result&& other) noexcept
+      : Response(std::move(other))
+      , result_(std::exchange(other.result_, nullptr)) {}
+
+  Result& operator=(Result&& other) noexcept {
+    if (this != &other) {
+      free_result();
+      Response::operator=(std::move(other));
+      result_ = std::exchange(other.result_, nullptr);
+    }
+    return *this;
+  }
+
+  ~Result() { free_result(); }
+
+  /**
+   * @return The result or NULL if the request failed.
+   */
+  const CassResult* get() const noexcept { return result_; }
+
+  /**
+   * @return true if there are more pages of rows to fetch using next_page().
+   */
+  bool has_more_pages() const noexcept {
+    return result_ != nullptr && cass_result_has_more_pages(result_) == cass_true;
+  }
+
+private:
+  void free_result() noexcept {
+    if (result_ != nullptr) {
+      cass_result_free(result_);
+      result_ = nullptr;
+    }
+  }
+
+private:
+  const CassResult* result_;
+};
+
+/**
+ * The result of awaiting prepare().
+ */
+class Prepared : public Response {
+public:
+  Prepared() noexcept
+      : prepared_(nullptr) {}
+
+  explicit Prepared(CassFuture* future) noexcept
+      : Response(future)
+      , prepared_(cass_future_get_prepared(future)) {}
+
+  Prepared(Prepared&& other) noexcept
+      : Response(std::move(other))
+      , prepared_(std::exchange(other.prepared_, nullptr)) {}
+
+  Prepared& operator=(Prepared&& other) noexcept {
+    if (this != &other) {
+      free_prepared();
+      Response::operator=(std::move(other));
+      prepared_ = std::exchange(other.prepared_, nullptr);
+    }
+    return *this;
+  }
+
+  ~Prepared() { free_prepared(); }
+
+  /**
+   * @return The prepared statement or NULL if the request failed.
+   */
+  const CassPrepared* get() const noexcept { return prepared_; }
+
+  /**
+   * Creates a bound statement from the prepared statement.
+   *
+   * @return A new bound statement that must be freed using
+   * cass_statement_free() or NULL if the request failed.
+   */
+  CassStatement* bind() const noexcept {
+    return prepared_ != nullptr ? cass_prepared_bind(prepared_) : nullptr;
+  }
+
+private:
+  void free_prepared() noexcept {
+    if (prepared_ != nullptr) {
+      cass_prepared_free(prepared_);
+      prepared_ = nullptr;
+    }
+  }
+
+private:
+  const CassPrepared* prepared_;
+};
+
+/**
+ * An awaitable that takes ownership of a future and produces `T` (a type
+ * constructed from the set future) when the future is set.
+ */
+template <class T, class Executor = InlineExecutor>
+class Awaitable {
+public:
+  Awaitable(CassFuture* future, Executor executor = Executor())
+      : future_(future)
+      , executor_(std::move(executor))
+      , is_set_(false) {}
+
+  // The awaitable's address is passed to the driver so it can't be moved
+  Awaitable(const Awaitable&) = delete;
+  Awaitable& operator=(const Awaitable&) = delete;
+
+  ~Awaitable() {
+    if (future_ != nullptr) cass_future_free(future_);
+  }
+
+  bool await_ready() const noexcept { return cass_future_ready(future_) == cass_true; }
+
+  bool await_suspend(std::coroutine_handle<> handle) noexcept {
+    handle_ = handle;
+    if (cass_future_set_callback(future_, on_set, this) != CASS_OK) {
+      // Another callback has already been set on the future
+      cass_future_wait(future_);
+      return false;
+    }
+    // The future could've been set before (or while) the callback was added
+    // in which case the coroutine continues without suspending.
+    return !is_set_.exchange(true, std::memory_order_acq_rel);
+  }
+
+  T await_resume() noexcept { return T(std::exchange(future_, nullptr)); }
+
+private:
+  static void on_set(CassFuture*, void* data) {
+    Awaitable* self = static_cast<Awaitable*>(data);
+    if (self->is_set_.exchange(true, std::memory_order_acq_rel)) {
+      // Resuming the coroutine destroys the awaitable so copy what's needed
+      std::coroutine_handle<> handle = self->handle_;
+      Executor executor(self->executor_);
+      executor(handle);
+    }
+  }
+
+private:
+  CassFuture* future_;
+  Executor executor_;
+  std::coroutine_handle<> handle_;
+  std::atomic<bool> is_set_;
+};
+
+/**
+ * Execute a statement.
+ *
+ * @param[in] session
+ * @param[in] statement
+ * @param[in] executor The executor used to resume the awaiting coroutine.
+ * @return An awaitable that produces a Result.
+ *
+ * @see cass_session_execute()
+ */
+template <class Executor = InlineExecutor>
+Awaitable<Result, Executor> execute(CassSession* session, const CassStatement* statement,
+                                    Executor executor = Executor()) {
+  return Awaitable<Result, Executor>(cass_session_execute(session, statement),
+                                     std::move(executor));
+}
+
+/**
+ * Execute a batch.
+ *
+ * @param[in] session
+ * @param[in] batch
+ * @param[in] executor The executor used to resume the awaiting coroutine.
+ * @return An awaitable that produces a Result.
+ *
+ * @see cass_session_execute_batch()
+ */
+template <class Executor = InlineExecutor>
+Awaitable<Result, Executor> execute(CassSession* session, const CassBatch* batch,
+                                    Executor executor = Executor()) {
+  return Awaitable<Result, Executor>(cass_session_execute_batch(session, batch),
+                                     std::move(executor));
+}
+
+/**
+ * Fetch the page of rows that follows a previous result. The paging state of
+ * the statement is updated using the previous result.
+ *
+ * @param[in] session
+ * @param[in] statement The statement used to get the previous result.
+ * @param[in] previous The previous result. Result::has_more_pages() must be true.
+ * @param[in] executor The executor used to resume the awaiting coroutine.
+ * @return An awaitable that produces a Result.
+ *
+ * @see cass_statement_set_paging_state()
+ */
+template <class Executor = InlineExecutor>
+Awaitable<Result, Executor> next_page(CassSession* session, CassStatement* statement,
+                                      const Result& previous, Executor executor = Executor()) {
+  cass_statement_set_paging_state(statement, previous.get());
+  return execute(session, statement, std::move(executor));
+}
+
+/**
+ * Prepare a query.
+ *
+ * @param[in] session
+ * @param[in] query
+ * @param[in] executor The executor used to resume the awaiting coroutine.
+ * @return An awaitable that produces a Prepared.
+ *
+ * @see cass_session_prepare_n()
+ */
+template <class Executor = InlineExecutor>
+Awaitable<Prepared, Executor> prepare(CassSession* session, std::string_view query,
+                                      Executor executor = Executor()) {
+  return Awaitable<Prepared, Executor>(cass_session_prepare_n(session, query.data(), query.size()),
+                                       std::move(executor));
+}
+
+/**
+ * A minimal, eagerly started coroutine type for fire-and-forget coroutines
+ * that use this layer. Applications with their own task types can use the
+ * awaitables above directly.
+ */
+struct Task {
+  struct promise_type {
+    Task get_return_object() noexcept { return Task(); }
+    std::suspend_never initial_suspend() noexcept { return std::suspend_never(); }
+    std::suspend_never final_suspend() noexcept { return std::suspend_never(); }
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+}} // namespace cass::coro
+
+#endif
+
+#endif
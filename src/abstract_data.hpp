@@ -80,6 +80,9 @@ public:
   AbstractData(size_t count)
       : elements_(count) {}
 
+  AbstractData(const ElementVec& elements)
+      : elements_(elements) {}
+
   virtual ~AbstractData() {}
 
   const ElementVec& elements() const { return elements_; }
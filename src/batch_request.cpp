@@ -106,6 +106,19 @@ CassError cass_batch_set_execution_profile_n(CassBatch* batch, const char* name,
   return CASS_OK;
 }
 
+CassError cass_batch_set_label(CassBatch* batch, const char* label) {
+  return cass_batch_set_label_n(batch, label, SAFE_STRLEN(label));
+}
+
+CassError cass_batch_set_label_n(CassBatch* batch, const char* label, size_t label_length) {
+  if (label_length > 0) {
+    batch->set_label(String(label, label_length));
+  } else {
+    batch->set_label(String());
+  }
+  return CASS_OK;
+}
+
 } // extern "C"
 
 // Format: <type><n><query_1>...<query_n><consistency><flags>[<serial_consistency>][<timestamp>]
@@ -0,0 +1,306 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "bulk_executor.hpp"
+
+#include "event_loop.hpp"
+#include "request.hpp"
+#include "scoped_lock.hpp"
+#include "scoped_ptr.hpp"
+#include "session.hpp"
+#include "statement.hpp"
+
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassBulkExecutor* cass_bulk_executor_new(CassSession* session, unsigned max_in_flight,
+                                         CassBulkExecutorNextCallback next_callback, void* data) {
+  if (max_in_flight == 0 || next_callback == NULL) return NULL;
+  BulkExecutor* executor = new BulkExecutor(session->from(), max_in_flight, next_callback, data);
+  executor->inc_ref();
+  return CassBulkExecutor::to(executor);
+}
+
+void cass_bulk_executor_free(CassBulkExecutor* executor) { executor->dec_ref(); }
+
+void cass_bulk_executor_set_rate(CassBulkExecutor* executor, unsigned requests_per_second) {
+  executor->set_rate(requests_per_second);
+}
+
+void cass_bulk_executor_set_result_callback(CassBulkExecutor* executor,
+                                            CassFutureCallback callback, void* data) {
+  executor->set_result_callback(callback, data);
+}
+
+CassFuture* cass_bulk_executor_execute(CassBulkExecutor* executor) {
+  Future::Ptr future(executor->execute());
+  future->inc_ref();
+  return CassFuture::to(future.get());
+}
+
+void cass_bulk_executor_get_metrics(const CassBulkExecutor* executor,
+                                    CassBulkExecutorMetrics* output) {
+  executor->get_metrics(output);
+}
+
+} // extern "C"
+
+struct BulkExecutor::PendingRequest : public Allocated {
+  PendingRequest(const BulkExecutor::Ptr& executor, uint64_t start_time_ns)
+      : executor(executor)
+      , start_time_ns(start_time_ns) {}
+
+  BulkExecutor::Ptr executor;
+  uint64_t start_time_ns;
+};
+
+/**
+ * Starts the rate limit timer on the session's event loop.
+ */
+class BulkExecutor::StartTimer : public Task {
+public:
+  StartTimer(const BulkExecutor::Ptr& executor, uint64_t delay_ms)
+      : executor_(executor)
+      , delay_ms_(delay_ms) {}
+
+  virtual void run(EventLoop* event_loop) { executor_->start_timer(event_loop->loop(), delay_ms_); }
+
+private:
+  BulkExecutor::Ptr executor_;
+  uint64_t delay_ms_;
+};
+
+BulkExecutor::BulkExecutor(Session* session, unsigned max_in_flight,
+                           CassBulkExecutorNextCallback next_callback, void* next_data)
+    : session_(session)
+    , max_in_flight_(max_in_flight)
+    , requests_per_second_(0)
+    , next_callback_(next_callback)
+    , next_data_(next_data)
+    , result_callback_(NULL)
+    , result_data_(NULL)
+    , future_(new Future(Future::FUTURE_TYPE_GENERIC))
+    , is_started_(false)
+    , is_refilling_(false)
+    , is_exhausted_(false)
+    , is_finished_(false)
+    , is_timer_pending_(false)
+    , in_flight_(0)
+    , permits_(0.0)
+    , last_permit_ns_(0)
+    , start_time_ns_(0)
+    , finish_time_ns_(0)
+    , completed_(0)
+    , errors_(0) {
+  uv_mutex_init(&mutex_);
+  hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histogram_);
+}
+
+BulkExecutor::~BulkExecutor() {
+  free(histogram_);
+  uv_mutex_destroy(&mutex_);
+}
+
+Future::Ptr BulkExecutor::execute() {
+  {
+    ScopedMutex l(&mutex_);
+    if (is_started_) return future_;
+    is_started_ = true;
+    start_time_ns_ = last_permit_ns_ = uv_hrtime();
+    permits_ = requests_per_second_;
+  }
+
+  if (session_->state() != SessionBase::SESSION_STATE_CONNECTED) {
+    future_->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Session is not connected");
+    return future_;
+  }
+  refill();
+  return future_;
+}
+
+void BulkExecutor::get_metrics(CassBulkExecutorMetrics* metrics) const {
+  ScopedMutex l(&mutex_);
+
+  if (histogram_->total_count > 0) {
+    metrics->latency.min = hdr_min(histogram_);
+    metrics->latency.max = hdr_max(histogram_);
+    metrics->latency.mean = static_cast<cass_uint64_t>(hdr_mean(histogram_));
+    metrics->latency.median = hdr_value_at_percentile(histogram_, 50.0);
+    metrics->latency.percentile_95th = hdr_value_at_percentile(histogram_, 95.0);
+    metrics->latency.percentile_99th = hdr_value_at_percentile(histogram_, 99.0);
+  } else {
+    memset(&metrics->latency, 0, sizeof(metrics->latency));
+  }
+
+  metrics->in_flight = in_flight_;
+  metrics->completed = completed_;
+  metrics->errors = errors_;
+
+  metrics->mean_rate = 0.0;
+  if (is_started_) {
+    uint64_t elapsed_ns = (is_finished_ ? finish_time_ns_ : uv_hrtime()) - start_time_ns_;
+    if (elapsed_ns > 0) {
+      metrics->mean_rate = static_cast<double>(completed_) * 1e9 / static_cast<double>(elapsed_ns);
+    }
+  }
+}
+
+void BulkExecutor::on_result(CassFuture* future, void* data) {
+  ScopedPtr<PendingRequest> request(static_cast<PendingRequest*>(data));
+  request->executor->handle_result(future->from(), request->start_time_ns);
+}
+
+void BulkExecutor::handle_result(Future* future, uint64_t start_time_ns) {
+  uint64_t now = uv_hrtime();
+  { // Record the result before running the callback so the metrics include it
+    ScopedMutex l(&mutex_);
+    completed_++;
+    if (future->error() != NULL) errors_++;
+    hdr_record_value(histogram_, static_cast<int64_t>((now - start_time_ns) / 1000));
+  }
+
+  if (result_callback_ != NULL) {
+    result_callback_(CassFuture::to(future), result_data_);
+  }
+
+  {
+    ScopedMutex l(&mutex_);
+    in_flight_--;
+  }
+  refill();
+}
+
+// Pull statements from the application until the maximum number of requests
+// are in flight. Only a single thread refills at a time; requests that
+// complete on other threads (or that fail immediately, e.g. when the session
+// is disconnected) are picked up by the refilling thread's next iteration
+// which also avoids unbounded recursion. The application's callback is run
+// without holding the lock so that it's able to use the executor (e.g. to get
+// its metrics).
+void BulkExecutor::refill() {
+  {
+    ScopedMutex l(&mutex_);
+    if (is_refilling_) return;
+    is_refilling_ = true;
+  }
+
+  while (true) {
+    Request::ConstVec requests;
+    unsigned count = 0;
+    bool is_finished = false;
+    uint64_t delay_ms = 0;
+    uint64_t now = uv_hrtime();
+
+    { // Determine how many statements can be started. The number of requests
+      // in flight can only decrease while refilling.
+      ScopedMutex l(&mutex_);
+      while (!is_exhausted_ && in_flight_ + count < max_in_flight_) {
+        if (requests_per_second_ > 0 && !acquire_permit(now)) {
+          if (!is_timer_pending_) {
+            is_timer_pending_ = true;
+            delay_ms = static_cast<uint64_t>((1.0 - permits_) * 1000.0 / requests_per_second_) + 1;
+          }
+          break;
+        }
+        count++;
+      }
+
+      if (count == 0) {
+        is_refilling_ = false;
+        if (is_exhausted_ && in_flight_ == 0 && !is_finished_) {
+          is_finished_ = is_finished = true;
+          finish_time_ns_ = now;
+        }
+      }
+    }
+
+    if (delay_ms > 0) {
+      session_->event_loop()->add(new StartTimer(Ptr(this), delay_ms));
+    }
+
+    if (count == 0) {
+      if (is_finished) future_->set();
+      return;
+    }
+
+    bool is_exhausted = false;
+    requests.reserve(count);
+    while (requests.size() < count) {
+      CassStatement* statement = next_callback_(next_data_);
+      if (statement == NULL) {
+        is_exhausted = true;
+        break;
+      }
+      requests.push_back(Request::ConstPtr(statement->from()));
+      statement->from()->dec_ref(); // The executor takes ownership of the statement
+    }
+
+    {
+      ScopedMutex l(&mutex_);
+      in_flight_ += static_cast<unsigned>(requests.size());
+      if (is_exhausted) {
+        is_exhausted_ = true;
+        if (requests_per_second_ > 0) { // Return the unused permits
+          permits_ += static_cast<double>(count - requests.size());
+        }
+      }
+    }
+
+    if (requests.empty()) continue; // Check whether the executor has finished
+
+    Future::Vec futures;
+    session_->execute_many(requests, &futures);
+    for (Future::Vec::const_iterator it = futures.begin(), end = futures.end(); it != end; ++it) {
+      (*it)->set_callback(on_result, new PendingRequest(Ptr(this), now));
+    }
+  }
+}
+
+bool BulkExecutor::acquire_permit(uint64_t now_ns) {
+  if (now_ns > last_permit_ns_) {
+    permits_ = std::min(static_cast<double>(requests_per_second_),
+                        permits_ + static_cast<double>(now_ns - last_permit_ns_) *
+                                       requests_per_second_ / 1e9);
+    last_permit_ns_ = now_ns;
+  }
+  if (permits_ >= 1.0) {
+    permits_ -= 1.0;
+    return true;
+  }
+  return false;
+}
+
+void BulkExecutor::start_timer(uv_loop_t* loop, uint64_t delay_ms) {
+  inc_ref(); // Keep the executor alive until the timer fires
+  timer_.start(loop, delay_ms, bind_callback(&BulkExecutor::on_timeout, this));
+}
+
+void BulkExecutor::on_timeout(Timer* timer) {
+  timer_.stop(); // Close the handle on the event loop's thread
+  {
+    ScopedMutex l(&mutex_);
+    is_timer_pending_ = false;
+  }
+  refill();
+  dec_ref();
+}
@@ -0,0 +1,114 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_BULK_EXECUTOR_HPP
+#define DATASTAX_INTERNAL_BULK_EXECUTOR_HPP
+
+#include "cassandra.h"
+#include "external.hpp"
+#include "future.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "timer.hpp"
+
+#include "third_party/hdr_histogram/hdr_histogram.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+class Session;
+
+/**
+ * An executor that keeps a bounded number of requests in flight for bulk
+ * workloads. A new statement is pulled from the application's callback on the
+ * thread that completes a request, so the executor doesn't need a thread of
+ * its own. Only the optional rate limit uses the session's event loop to
+ * resume once more requests are permitted.
+ */
+class BulkExecutor : public RefCounted<BulkExecutor> {
+public:
+  typedef SharedRefPtr<BulkExecutor> Ptr;
+
+  static const int64_t HIGHEST_TRACKABLE_VALUE = 3600LL * 1000LL * 1000LL;
+
+  BulkExecutor(Session* session, unsigned max_in_flight, CassBulkExecutorNextCallback next_callback,
+               void* next_data);
+  ~BulkExecutor();
+
+  void set_rate(unsigned requests_per_second) { requests_per_second_ = requests_per_second; }
+
+  void set_result_callback(CassFutureCallback callback, void* data) {
+    result_callback_ = callback;
+    result_data_ = data;
+  }
+
+  /**
+   * Start executing statements.
+   *
+   * @return A future that's set when the callback has run out of statements
+   * and all the requests have completed.
+   */
+  Future::Ptr execute();
+
+  void get_metrics(CassBulkExecutorMetrics* metrics) const;
+
+private:
+  struct PendingRequest;
+  class StartTimer;
+
+  static void on_result(CassFuture* future, void* data);
+
+  void handle_result(Future* future, uint64_t start_time_ns);
+  void refill();
+  bool acquire_permit(uint64_t now_ns);
+  void start_timer(uv_loop_t* loop, uint64_t delay_ms);
+  void on_timeout(Timer* timer);
+
+private:
+  mutable uv_mutex_t mutex_;
+  Session* session_;
+  const unsigned max_in_flight_;
+  unsigned requests_per_second_;
+  CassBulkExecutorNextCallback next_callback_;
+  void* next_data_;
+  CassFutureCallback result_callback_;
+  void* result_data_;
+  Future::Ptr future_;
+  bool is_started_;
+  bool is_refilling_;
+  bool is_exhausted_;
+  bool is_finished_;
+  bool is_timer_pending_;
+  unsigned in_flight_;
+  double permits_;
+  uint64_t last_permit_ns_;
+  uint64_t start_time_ns_;
+  uint64_t finish_time_ns_;
+  uint64_t completed_;
+  uint64_t errors_;
+  hdr_histogram* histogram_;
+  Timer timer_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(BulkExecutor);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::BulkExecutor, CassBulkExecutor)
+
+#endif
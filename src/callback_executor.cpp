@@ -0,0 +1,230 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "callback_executor.hpp"
+
+#include "future.hpp"
+#include "scoped_lock.hpp"
+#include "scoped_ptr.hpp"
+
+#include <algorithm>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+void cass_callback_batch_run(CassCallbackBatch* batch) {
+  batch->run();
+  delete batch->from();
+}
+
+} // extern "C"
+
+struct CallbackExecutor::ThreadData : public Allocated {
+  ThreadData(const PendingQueue::Ptr& queue, size_t num_threads)
+      : queue(queue)
+      , num_threads(num_threads) {}
+
+  PendingQueue::Ptr queue;
+  size_t num_threads;
+};
+
+CallbackExecutor::PendingQueue::PendingQueue()
+    : is_closing_(false) {
+  uv_mutex_init(&mutex_);
+  uv_cond_init(&cond_);
+}
+
+CallbackExecutor::PendingQueue::~PendingQueue() {
+  // Don't leave threads waiting on futures whose callbacks are never run
+  for (EntryVec::const_iterator it = entries_.begin(), end = entries_.end(); it != end; ++it) {
+    it->future->finish_callback();
+    it->future->dec_ref();
+  }
+  uv_cond_destroy(&cond_);
+  uv_mutex_destroy(&mutex_);
+}
+
+bool CallbackExecutor::PendingQueue::push(Future* future, CassFutureCallback callback,
+                                          void* data) {
+  Entry entry;
+  entry.future = future;
+  entry.callback = callback;
+  entry.data = data;
+  future->inc_ref(); // Keep the future alive until the callback is run
+
+  ScopedMutex l(&mutex_);
+  bool was_empty = entries_.empty();
+  entries_.push_back(entry);
+  if (was_empty) {
+    uv_cond_signal(&cond_);
+  }
+  return was_empty;
+}
+
+void CallbackExecutor::PendingQueue::run_all() {
+  EntryVec entries;
+  {
+    ScopedMutex l(&mutex_);
+    entries.swap(entries_);
+  }
+  run(entries);
+}
+
+void CallbackExecutor::PendingQueue::run_thread(size_t num_threads) {
+  ScopedMutex l(&mutex_);
+  while (true) {
+    while (entries_.empty() && !is_closing_) {
+      uv_cond_wait(&cond_, l.get());
+    }
+    if (entries_.empty()) return; // Closing
+
+    // Share the callbacks with the other threads
+    size_t count = std::max(static_cast<size_t>(1), entries_.size() / num_threads);
+    EntryVec entries(entries_.begin(), entries_.begin() + count);
+    entries_.erase(entries_.begin(), entries_.begin() + count);
+    if (!entries_.empty()) {
+      uv_cond_signal(&cond_);
+    }
+
+    l.unlock();
+    run(entries);
+    l.lock();
+  }
+}
+
+void CallbackExecutor::PendingQueue::close() {
+  ScopedMutex l(&mutex_);
+  is_closing_ = true;
+  uv_cond_broadcast(&cond_);
+}
+
+void CallbackExecutor::PendingQueue::run(const EntryVec& entries) {
+  for (EntryVec::const_iterator it = entries.begin(), end = entries.end(); it != end; ++it) {
+    it->future->start_callback();
+    it->future->on_callback_invoked();
+    it->callback(CassFuture::to(it->future), it->data);
+    it->future->finish_callback();
+    it->future->dec_ref();
+  }
+}
+
+void CallbackBatch::run() { queue_->run_all(); }
+
+CallbackExecutor::CallbackExecutor()
+    : function_(NULL)
+    , data_(NULL)
+    , num_threads_(0)
+    , io_thread_callbacks_(0)
+    , io_thread_time_ns_(0)
+    , io_thread_max_time_ns_(0)
+    , dispatched_callbacks_(0)
+    , dispatched_batches_(0) {}
+
+CallbackExecutor::CallbackExecutor(CassCallbackExecutorFunction function, void* data)
+    : function_(function)
+    , data_(data)
+    , num_threads_(0)
+    , queue_(new PendingQueue())
+    , io_thread_callbacks_(0)
+    , io_thread_time_ns_(0)
+    , io_thread_max_time_ns_(0)
+    , dispatched_callbacks_(0)
+    , dispatched_batches_(0) {}
+
+CallbackExecutor::CallbackExecutor(unsigned num_threads)
+    : function_(NULL)
+    , data_(NULL)
+    , num_threads_(num_threads)
+    , queue_(new PendingQueue())
+    , io_thread_callbacks_(0)
+    , io_thread_time_ns_(0)
+    , io_thread_max_time_ns_(0)
+    , dispatched_callbacks_(0)
+    , dispatched_batches_(0) {}
+
+CallbackExecutor::~CallbackExecutor() {
+  if (threads_.empty()) return;
+
+  queue_->close();
+
+  // The last reference can be released by a callback running on one of the
+  // pool's threads (e.g. by freeing the cluster). That thread isn't joined,
+  // but it keeps its own reference to the queue until it exits.
+  uv_thread_t self = uv_thread_self();
+  for (Vector<uv_thread_t>::iterator it = threads_.begin(), end = threads_.end(); it != end;
+       ++it) {
+    if (!uv_thread_equal(&self, &(*it))) {
+      uv_thread_join(&(*it));
+    }
+  }
+}
+
+int CallbackExecutor::init() {
+  threads_.reserve(num_threads_);
+  for (unsigned i = 0; i < num_threads_; ++i) {
+    uv_thread_t thread;
+    ThreadData* data = new ThreadData(queue_, num_threads_);
+    int rc = uv_thread_create(&thread, on_thread, data);
+    if (rc != 0) {
+      delete data;
+      return rc;
+    }
+    threads_.push_back(thread);
+  }
+  return 0;
+}
+
+void CallbackExecutor::execute(Future* future, CassFutureCallback callback, void* data) {
+  if (!queue_) {
+    uint64_t start = uv_hrtime();
+    future->on_callback_invoked();
+    callback(CassFuture::to(future), data);
+    uint64_t elapsed = uv_hrtime() - start;
+
+    io_thread_callbacks_.fetch_add(1);
+    io_thread_time_ns_.fetch_add(elapsed);
+    uint64_t max_time = io_thread_max_time_ns_.load();
+    while (elapsed > max_time && !io_thread_max_time_ns_.compare_exchange_weak(max_time, elapsed)) {
+    }
+    return;
+  }
+
+  dispatched_callbacks_.fetch_add(1);
+  // Callbacks that are added while the queue isn't empty join the batch (or
+  // the pool thread wake-up) that's already pending.
+  if (queue_->push(future, callback, data)) {
+    dispatched_batches_.fetch_add(1);
+    if (function_ != NULL) {
+      function_(CassCallbackBatch::to(new CallbackBatch(queue_)), data_);
+    }
+  }
+}
+
+void CallbackExecutor::get_metrics(CassCallbackMetrics* metrics) const {
+  metrics->io_thread_callbacks = io_thread_callbacks_.load();
+  metrics->io_thread_time = io_thread_time_ns_.load() / 1000;
+  metrics->io_thread_max_time = io_thread_max_time_ns_.load() / 1000;
+  metrics->dispatched_callbacks = dispatched_callbacks_.load();
+  metrics->dispatched_batches = dispatched_batches_.load();
+}
+
+void CallbackExecutor::on_thread(void* arg) {
+  ScopedPtr<ThreadData> data(static_cast<ThreadData*>(arg));
+  data->queue->run_thread(data->num_threads);
+}
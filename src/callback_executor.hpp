@@ -0,0 +1,175 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_CALLBACK_EXECUTOR_HPP
+#define DATASTAX_INTERNAL_CALLBACK_EXECUTOR_HPP
+
+#include "allocated.hpp"
+#include "atomic.hpp"
+#include "cassandra.h"
+#include "external.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "vector.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+class Future;
+
+/**
+ * Runs the application's future callbacks. By default the callbacks are run
+ * on the thread that sets the future (usually an I/O thread) and the time
+ * spent in the callbacks is tracked. The callbacks can also be handed off in
+ * batches to an application-provided function or to a built-in thread pool
+ * so that slow callbacks don't delay other requests on the I/O threads.
+ */
+class CallbackExecutor : public RefCounted<CallbackExecutor> {
+public:
+  typedef SharedRefPtr<CallbackExecutor> Ptr;
+
+  /**
+   * The callbacks that are waiting to be run. This is shared with the
+   * batches and the pool's threads so that it can outlive the executor.
+   */
+  class PendingQueue : public RefCounted<PendingQueue> {
+  public:
+    typedef SharedRefPtr<PendingQueue> Ptr;
+
+    struct Entry {
+      Future* future;
+      CassFutureCallback callback;
+      void* data;
+    };
+
+    typedef Vector<Entry> EntryVec;
+
+    PendingQueue();
+    ~PendingQueue();
+
+    /**
+     * Add a callback to the queue.
+     *
+     * @return true if the queue was empty.
+     */
+    bool push(Future* future, CassFutureCallback callback, void* data);
+
+    /**
+     * Run all the callbacks that are in the queue.
+     */
+    void run_all();
+
+    /**
+     * Run callbacks on the calling thread until the queue is closed.
+     *
+     * @param num_threads The number of threads sharing the queue.
+     */
+    void run_thread(size_t num_threads);
+
+    void close();
+
+  private:
+    static void run(const EntryVec& entries);
+
+  private:
+    uv_mutex_t mutex_;
+    uv_cond_t cond_;
+    EntryVec entries_;
+    bool is_closing_;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(PendingQueue);
+  };
+
+  /**
+   * Run callbacks on the thread that sets the future.
+   */
+  CallbackExecutor();
+
+  /**
+   * Hand off batches of callbacks using an application-provided function.
+   */
+  CallbackExecutor(CassCallbackExecutorFunction function, void* data);
+
+  /**
+   * Run callbacks on a pool of threads.
+   */
+  CallbackExecutor(unsigned num_threads);
+
+  ~CallbackExecutor();
+
+  /**
+   * Start the thread pool's threads (if any).
+   *
+   * @return 0 if successful, otherwise an error occurred.
+   */
+  int init();
+
+  /**
+   * Run or hand off the callback of a future that's been set (thread-safe).
+   * The future is notified once a callback that's been handed off has run.
+   */
+  void execute(Future* future, CassFutureCallback callback, void* data);
+
+  /**
+   * Determine if callbacks are handed off to another thread.
+   */
+  bool is_deferred() const { return queue_; }
+
+  void get_metrics(CassCallbackMetrics* metrics) const;
+
+private:
+  struct ThreadData;
+
+  static void on_thread(void* arg);
+
+private:
+  CassCallbackExecutorFunction function_;
+  void* data_;
+  unsigned num_threads_;
+  Vector<uv_thread_t> threads_;
+  PendingQueue::Ptr queue_;
+  Atomic<uint64_t> io_thread_callbacks_;
+  Atomic<uint64_t> io_thread_time_ns_;
+  Atomic<uint64_t> io_thread_max_time_ns_;
+  Atomic<uint64_t> dispatched_callbacks_;
+  Atomic<uint64_t> dispatched_batches_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(CallbackExecutor);
+};
+
+/**
+ * A batch of callbacks handed off to the application's executor. Running the
+ * batch runs all the callbacks that are pending at that time.
+ */
+class CallbackBatch : public Allocated {
+public:
+  CallbackBatch(const CallbackExecutor::PendingQueue::Ptr& queue)
+      : queue_(queue) {}
+
+  void run();
+
+private:
+  CallbackExecutor::PendingQueue::Ptr queue_;
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::CallbackBatch, CassCallbackBatch)
+
+#endif
@@ -750,6 +750,10 @@ private:
         writer.Uint64(dc_lbp->used_hosts_per_remote_dc());
         writer.Key("allowRemoteDcsForLocalCl");
         writer.Bool(!dc_lbp->skip_remote_dcs_for_local_cl());
+        if (!dc_lbp->local_rack().empty()) {
+          writer.Key("localRack");
+          writer.String(dc_lbp->local_rack().c_str());
+        }
       }
       if (!profile.blacklist().empty()) {
         writer.Key("blacklist");
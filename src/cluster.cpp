@@ -179,6 +179,11 @@ Host::Ptr LockedHostMap::get(const Address& address) const {
   return it->second;
 }
 
+HostMap LockedHostMap::copy() const {
+  ScopedMutex l(&mutex_);
+  return hosts_;
+}
+
 void LockedHostMap::erase(const Address& address) {
   ScopedMutex l(&mutex_);
   hosts_.erase(address);
@@ -200,7 +205,8 @@ ClusterSettings::ClusterSettings()
     , port(CASS_DEFAULT_PORT)
     , reconnection_policy(new ExponentialReconnectionPolicy())
     , prepare_on_up_or_add_host(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST)
-    , max_prepares_per_flush(CASS_DEFAULT_MAX_PREPARES_PER_FLUSH)
+    , max_concurrent_prepares(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST_CONCURRENCY)
+    , max_prepares_per_second(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST_RATE)
     , disable_events_on_startup(false)
     , cluster_metadata_resolver_factory(new DefaultClusterMetadataResolverFactory()) {
   load_balancing_policies.push_back(load_balancing_policy);
@@ -213,7 +219,8 @@ ClusterSettings::ClusterSettings(const Config& config)
     , port(config.port())
     , reconnection_policy(config.reconnection_policy())
     , prepare_on_up_or_add_host(config.prepare_on_up_or_add_host())
-    , max_prepares_per_flush(CASS_DEFAULT_MAX_PREPARES_PER_FLUSH)
+    , max_concurrent_prepares(config.prepare_on_up_or_add_host_concurrency())
+    , max_prepares_per_second(config.prepare_on_up_or_add_host_rate())
     , disable_events_on_startup(false)
     , cluster_metadata_resolver_factory(config.cluster_metadata_resolver_factory()) {}
 
@@ -232,6 +239,7 @@ Cluster::Cluster(const ControlConnection::Ptr& connection, ClusterListener* list
     , is_closing_(false)
     , connected_host_(connected_host)
     , hosts_(hosts)
+    , prepare_host_metrics_(new PrepareHostMetrics())
     , local_dc_(local_dc)
     , supported_options_(supported_options)
     , is_recording_events_(settings.disable_events_on_startup) {
@@ -267,6 +275,8 @@ Metadata::SchemaSnapshot Cluster::schema_snapshot() { return metadata_.schema_sn
 
 Host::Ptr Cluster::find_host(const Address& address) const { return hosts_.get(address); }
 
+HostMap Cluster::hosts() const { return hosts_.copy(); }
+
 PreparedMetadata::Entry::Ptr Cluster::prepared(const String& id) const {
   return prepared_metadata_.get(id);
 }
@@ -275,6 +285,10 @@ void Cluster::prepared(const String& id, const PreparedMetadata::Entry::Ptr& ent
   prepared_metadata_.set(id, entry);
 }
 
+PreparedMetadata::Entry::Vec Cluster::prepared_metadata_entries() const {
+  return prepared_metadata_.copy();
+}
+
 HostMap Cluster::available_hosts() const {
   HostMap available;
   for (HostMap::const_iterator it = hosts_.begin(), end = hosts_.end(); it != end; ++it) {
@@ -455,6 +469,12 @@ void Cluster::on_reconnect(ControlConnector* connector) {
 void Cluster::internal_close() {
   is_closing_ = true;
   monitor_reporting_timer_.stop();
+  for (PrepareHostHandler::Vec::const_iterator it = prepare_host_handlers_.begin(),
+                                               end = prepare_host_handlers_.end();
+       it != end; ++it) {
+    if (!(*it)->is_finished()) (*it)->close();
+  }
+  prepare_host_handlers_.clear();
   if (timer_.is_running()) {
     timer_.stop();
     handle_close();
@@ -654,7 +674,20 @@ bool Cluster::prepare_host(const Host::Ptr& host, const PrepareHostHandler::Call
   if (connection_ && settings_.prepare_on_up_or_add_host) {
     PrepareHostHandler::Ptr prepare_host_handler(
         new PrepareHostHandler(host, prepared_metadata_.copy(), callback,
-                               connection_->protocol_version(), settings_.max_prepares_per_flush));
+                               connection_->protocol_version(), settings_.max_concurrent_prepares,
+                               settings_.max_prepares_per_second, prepare_host_metrics_));
+
+    // Keep track of the handlers still preparing statements in the
+    // background so they can be stopped when the cluster is closed.
+    PrepareHostHandler::Vec::iterator it = prepare_host_handlers_.begin();
+    while (it != prepare_host_handlers_.end()) {
+      if ((*it)->is_finished()) {
+        it = prepare_host_handlers_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    prepare_host_handlers_.push_back(prepare_host_handler);
 
     prepare_host_handler->prepare(connection_->loop(),
                                   settings_.control_connection_settings.connection_settings);
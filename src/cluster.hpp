@@ -47,6 +47,7 @@ public:
   const_iterator find(const Address& address) const;
 
   Host::Ptr get(const Address& address) const;
+  HostMap copy() const;
 
   void erase(const Address& address);
 
@@ -204,9 +205,16 @@ struct ClusterSettings {
   bool prepare_on_up_or_add_host;
 
   /**
-   * Max number of requests to be written out to the socket per write system call.
+   * Max number of outstanding prepare requests per host when preparing
+   * statements on a host that's brought up or added.
    */
-  unsigned max_prepares_per_flush;
+  unsigned max_concurrent_prepares;
+
+  /**
+   * Max number of statements prepared per second on a host that's brought up
+   * or added (0 is unlimited).
+   */
+  unsigned max_prepares_per_second;
 
   /**
    * If true then events are disabled on startup. Events can be explicitly
@@ -323,6 +331,13 @@ public:
    */
   Host::Ptr find_host(const Address& address) const;
 
+  /**
+   * Get a copy of all the hosts in the cluster (thread-safe).
+   *
+   * @return A mapping of all hosts.
+   */
+  HostMap hosts() const;
+
   /**
    * Get a prepared metadata entry for a prepared ID (thread-safe).
    *
@@ -340,6 +355,21 @@ public:
    */
   void prepared(const String& id, const PreparedMetadata::Entry::Ptr& entry);
 
+  /**
+   * Get all the prepared metadata entries (thread-safe).
+   *
+   * @return A copy of the prepared metadata entries.
+   */
+  PreparedMetadata::Entry::Vec prepared_metadata_entries() const;
+
+  /**
+   * Get the metrics for preparing statements on hosts that are brought up or
+   * added (thread-safe).
+   *
+   * @return The prepare host metrics.
+   */
+  const PrepareHostMetrics& prepare_host_metrics() const { return *prepare_host_metrics_; }
+
   /**
    * Get available hosts (determined by host distance). This filters out ignored
    * hosts (*NOT* thread-safe).
@@ -438,6 +468,8 @@ private:
   LockedHostMap hosts_;
   Metadata metadata_;
   PreparedMetadata prepared_metadata_;
+  PrepareHostMetrics::Ptr prepare_host_metrics_;
+  PrepareHostHandler::Vec prepare_host_handlers_;
   TokenMap::Ptr token_map_;
   String local_dc_;
   StringMultimap supported_options_;
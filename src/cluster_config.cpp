@@ -109,6 +109,29 @@ CassError cass_cluster_set_queue_size_io(CassCluster* cluster, unsigned queue_si
   return CASS_OK;
 }
 
+void cass_cluster_set_callback_executor(CassCluster* cluster,
+                                        CassCallbackExecutorFunction function, void* data) {
+  if (function == NULL) {
+    cluster->config().set_callback_executor(CallbackExecutor::Ptr());
+  } else {
+    cluster->config().set_callback_executor(
+        CallbackExecutor::Ptr(new CallbackExecutor(function, data)));
+  }
+}
+
+CassError cass_cluster_set_callback_thread_pool(CassCluster* cluster, unsigned num_threads) {
+  if (num_threads == 0) {
+    cluster->config().set_callback_executor(CallbackExecutor::Ptr());
+    return CASS_OK;
+  }
+  CallbackExecutor::Ptr callback_executor(new CallbackExecutor(num_threads));
+  if (callback_executor->init() != 0) {
+    return CASS_ERROR_LIB_UNABLE_TO_INIT;
+  }
+  cluster->config().set_callback_executor(callback_executor);
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_queue_size_event(CassCluster* cluster, unsigned queue_size) {
   return CASS_OK;
 }
@@ -301,6 +324,27 @@ CassError cass_cluster_set_load_balance_dc_aware_n(CassCluster* cluster, const c
   return CASS_OK;
 }
 
+CassError cass_cluster_set_load_balance_rack_aware(CassCluster* cluster, const char* local_dc,
+                                                   const char* local_rack) {
+  if (local_dc == NULL || local_rack == NULL) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  return cass_cluster_set_load_balance_rack_aware_n(cluster, local_dc, SAFE_STRLEN(local_dc),
+                                                    local_rack, SAFE_STRLEN(local_rack));
+}
+
+CassError cass_cluster_set_load_balance_rack_aware_n(CassCluster* cluster, const char* local_dc,
+                                                     size_t local_dc_length,
+                                                     const char* local_rack,
+                                                     size_t local_rack_length) {
+  if (local_dc == NULL || local_dc_length == 0 || local_rack == NULL || local_rack_length == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_load_balancing_policy(new DCAwarePolicy(
+      String(local_dc, local_dc_length), 0, true, String(local_rack, local_rack_length)));
+  return CASS_OK;
+}
+
 void cass_cluster_set_token_aware_routing(CassCluster* cluster, cass_bool_t enabled) {
   cluster->config().set_token_aware_routing(enabled == cass_true);
 }
@@ -317,7 +361,8 @@ void cass_cluster_set_latency_aware_routing(CassCluster* cluster, cass_bool_t en
 void cass_cluster_set_latency_aware_routing_settings(
     CassCluster* cluster, cass_double_t exclusion_threshold, cass_uint64_t scale_ms,
     cass_uint64_t retry_period_ms, cass_uint64_t update_rate_ms, cass_uint64_t min_measured) {
-  LatencyAwarePolicy::Settings settings;
+  LatencyAwarePolicy::Settings settings(
+      cluster->config().default_profile().latency_aware_routing_settings());
   settings.exclusion_threshold = exclusion_threshold;
   settings.scale_ns = scale_ms * 1000 * 1000;
   settings.retry_period_ns = retry_period_ms * 1000 * 1000;
@@ -326,6 +371,46 @@ void cass_cluster_set_latency_aware_routing_settings(
   cluster->config().set_latency_aware_routing_settings(settings);
 }
 
+CassError cass_cluster_set_latency_aware_routing_percentile(CassCluster* cluster,
+                                                            cass_double_t percentile) {
+  if (percentile <= 0.0 || percentile > 100.0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  LatencyAwarePolicy::Settings settings(
+      cluster->config().default_profile().latency_aware_routing_settings());
+  settings.percentile = percentile;
+  cluster->config().set_latency_aware_routing_settings(settings);
+  return CASS_OK;
+}
+
+void cass_cluster_set_outlier_detection(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_outlier_detection(enabled == cass_true);
+}
+
+CassError cass_cluster_set_outlier_detection_settings(
+    CassCluster* cluster, unsigned consecutive_failures, cass_double_t failure_rate_threshold,
+    unsigned min_requests, cass_uint64_t interval_ms, cass_uint64_t base_ejection_time_ms,
+    cass_uint64_t max_ejection_time_ms) {
+  if (failure_rate_threshold < 0.0 || failure_rate_threshold > 100.0 || interval_ms == 0 ||
+      base_ejection_time_ms > max_ejection_time_ms) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  OutlierDetectionPolicy::Settings settings;
+  settings.consecutive_failures = consecutive_failures;
+  settings.failure_rate_threshold = failure_rate_threshold;
+  settings.min_requests = min_requests;
+  settings.interval_ns = interval_ms * 1000 * 1000;
+  settings.base_ejection_time_ns = base_ejection_time_ms * 1000 * 1000;
+  settings.max_ejection_time_ns = max_ejection_time_ms * 1000 * 1000;
+  cluster->config().set_outlier_detection_settings(settings);
+  return CASS_OK;
+}
+
+void cass_cluster_set_token_aware_routing_order_replicas_by_latency(CassCluster* cluster,
+                                                                    cass_bool_t enabled) {
+  cluster->config().set_token_aware_routing_order_replicas_by_latency(enabled == cass_true);
+}
+
 void cass_cluster_set_whitelist_filtering(CassCluster* cluster, const char* hosts) {
   cass_cluster_set_whitelist_filtering_n(cluster, hosts, SAFE_STRLEN(hosts));
 }
@@ -437,6 +522,22 @@ CassError cass_cluster_set_constant_speculative_execution_policy(CassCluster* cl
   return CASS_OK;
 }
 
+CassError cass_cluster_set_adaptive_speculative_execution_policy(
+    CassCluster* cluster, cass_double_t percentile, int max_speculative_executions,
+    cass_double_t max_speculative_percent) {
+  if (percentile < 0.0 || percentile > 100.0 || max_speculative_executions < 0 ||
+      max_speculative_percent < 0.0 || max_speculative_percent > 100.0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  AdaptiveSpeculativeExecutionPolicy::Settings settings;
+  settings.percentile = percentile;
+  settings.max_speculative_executions = max_speculative_executions;
+  settings.max_speculative_percent = max_speculative_percent;
+  cluster->config().set_speculative_execution_policy(
+      new AdaptiveSpeculativeExecutionPolicy(settings));
+  return CASS_OK;
+}
+
 CassError cass_cluster_set_no_speculative_execution_policy(CassCluster* cluster) {
   cluster->config().set_speculative_execution_policy(new NoSpeculativeExecutionPolicy());
   return CASS_OK;
@@ -471,6 +572,40 @@ CassError cass_cluster_set_prepare_on_up_or_add_host(CassCluster* cluster, cass_
   return CASS_OK;
 }
 
+CassError cass_cluster_set_prepare_on_up_or_add_host_concurrency(CassCluster* cluster,
+                                                                 unsigned concurrency) {
+  if (concurrency == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  cluster->config().set_prepare_on_up_or_add_host_concurrency(concurrency);
+  return CASS_OK;
+}
+
+void cass_cluster_set_prepare_on_up_or_add_host_rate(CassCluster* cluster, unsigned per_second) {
+  cluster->config().set_prepare_on_up_or_add_host_rate(per_second);
+}
+
+void cass_cluster_set_prepared_cache_size(CassCluster* cluster, unsigned size) {
+  cluster->config().set_prepared_cache_size(size);
+}
+
+void cass_cluster_set_statement_metrics_size(CassCluster* cluster, unsigned size) {
+  cluster->config().set_statement_metrics_size(size);
+}
+
+void cass_cluster_set_request_timings(CassCluster* cluster, cass_bool_t enabled) {
+  cluster->config().set_request_timings(enabled == cass_true);
+}
+
+void cass_cluster_set_prepared_statements_file(CassCluster* cluster, const char* path) {
+  cass_cluster_set_prepared_statements_file_n(cluster, path, SAFE_STRLEN(path));
+}
+
+void cass_cluster_set_prepared_statements_file_n(CassCluster* cluster, const char* path,
+                                                 size_t path_length) {
+  cluster->config().set_prepared_statements_file(String(path, path_length));
+}
+
 CassError cass_cluster_set_local_address(CassCluster* cluster, const char* name) {
   return cass_cluster_set_local_address_n(cluster, name, SAFE_STRLEN(name));
 }
@@ -0,0 +1,212 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "columnar_result.hpp"
+
+#include "result_response.hpp"
+#include "serialization.hpp"
+
+#include <limits>
+#include <string.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassError cass_result_export_columns(const CassResult* result, CassColumnarResult** output) {
+  ColumnarResult* columns = new ColumnarResult();
+  CassError rc = columns->decode(result);
+  if (rc != CASS_OK) {
+    delete columns;
+    return rc;
+  }
+  *output = CassColumnarResult::to(columns);
+  return CASS_OK;
+}
+
+void cass_columnar_result_free(CassColumnarResult* columns) { delete columns->from(); }
+
+size_t cass_columnar_result_row_count(const CassColumnarResult* columns) {
+  return columns->row_count();
+}
+
+size_t cass_columnar_result_column_count(const CassColumnarResult* columns) {
+  return columns->columns().size();
+}
+
+CassError cass_columnar_result_column(const CassColumnarResult* columns, size_t index,
+                                      CassColumnBuffers* output) {
+  if (index >= columns->columns().size()) {
+    return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+  }
+  const ColumnarResult::Column& column = columns->columns()[index];
+  output->type = column.type;
+  output->length = columns->row_count();
+  output->null_count = column.null_count;
+  output->validity = column.null_count > 0 ? &column.validity[0] : NULL;
+  output->offsets = column.value_size == 0 ? &column.offsets[0] : NULL;
+  output->values = !column.values.empty() ? &column.values[0] : NULL;
+  output->value_size = column.value_size;
+  return CASS_OK;
+}
+
+} // extern "C"
+
+// Convert big-endian values to native byte order in place. These are tight loops over contiguous
+// memory so that the compiler is able to vectorize the byte swapping.
+
+static void to_native_int32(cass_byte_t* values, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    int32_t value;
+    decode_int32(reinterpret_cast<const char*>(values + i * sizeof(int32_t)), value);
+    memcpy(values + i * sizeof(int32_t), &value, sizeof(int32_t));
+  }
+}
+
+static void to_native_int64(cass_byte_t* values, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    int64_t value;
+    decode_int64(reinterpret_cast<const char*>(values + i * sizeof(int64_t)), value);
+    memcpy(values + i * sizeof(int64_t), &value, sizeof(int64_t));
+  }
+}
+
+int ColumnarResult::value_size(CassValueType type) {
+  switch (type) {
+    case CASS_VALUE_TYPE_INT:
+    case CASS_VALUE_TYPE_FLOAT:
+      return 4;
+    case CASS_VALUE_TYPE_BIGINT:
+    case CASS_VALUE_TYPE_COUNTER:
+    case CASS_VALUE_TYPE_TIMESTAMP:
+    case CASS_VALUE_TYPE_DOUBLE:
+      return 8;
+    case CASS_VALUE_TYPE_UUID:
+    case CASS_VALUE_TYPE_TIMEUUID:
+      return 16;
+    case CASS_VALUE_TYPE_ASCII:
+    case CASS_VALUE_TYPE_TEXT:
+    case CASS_VALUE_TYPE_VARCHAR:
+    case CASS_VALUE_TYPE_BLOB:
+      return 0;
+    default:
+      break;
+  }
+  return -1;
+}
+
+CassError ColumnarResult::append(Column& column, size_t row, const char* data, size_t size) {
+  if (data == NULL) {
+    column.null_count++;
+  } else {
+    column.validity[row / 8] |= static_cast<cass_uint8_t>(1 << (row % 8));
+    if (column.value_size > 0) {
+      if (size != column.value_size) {
+        return CASS_ERROR_LIB_INVALID_DATA;
+      }
+      memcpy(&column.values[row * size], data, size);
+    } else {
+      column.values.insert(column.values.end(), data, data + size);
+    }
+  }
+
+  if (column.value_size == 0) {
+    if (column.values.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+      return CASS_ERROR_LIB_INVALID_DATA;
+    }
+    column.offsets.push_back(static_cast<cass_int32_t>(column.values.size()));
+  }
+
+  return CASS_OK;
+}
+
+CassError ColumnarResult::decode(const ResultResponse* result) {
+  if (result->kind() != CASS_RESULT_KIND_ROWS || !result->metadata()) {
+    return CASS_ERROR_LIB_INVALID_STATE;
+  }
+
+  const ResultMetadata* metadata = result->metadata().get();
+  size_t column_count = metadata->column_count();
+  row_count_ = result->row_count();
+
+  columns_.resize(column_count);
+  for (size_t i = 0; i < column_count; ++i) {
+    Column& column = columns_[i];
+    column.type = metadata->get_column_definition(i).data_type->value_type();
+    int size = value_size(column.type);
+    if (size < 0) {
+      return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+    }
+    column.value_size = size;
+    column.validity.resize((row_count_ + 7) / 8, 0);
+    if (size > 0) {
+      column.values.resize(row_count_ * size, 0);
+    } else {
+      column.offsets.reserve(row_count_ + 1);
+      column.offsets.push_back(0);
+    }
+  }
+
+  if (row_count_ > 0) {
+    // The first row has already been decoded and the result's row decoder
+    // is positioned at the second row.
+    const OutputValueVec& values = result->first_row().values;
+    if (values.size() != column_count) {
+      return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+    }
+    for (size_t i = 0; i < column_count; ++i) {
+      const Value& value = values[i];
+      StringRef bytes(value.to_string_ref());
+      CassError rc = append(columns_[i], 0, value.is_null() ? NULL : bytes.data(), bytes.size());
+      if (rc != CASS_OK) return rc;
+    }
+  }
+
+  Decoder decoder(result->row_decoder());
+  for (size_t row = 1; row < row_count_; ++row) {
+    for (size_t i = 0; i < column_count; ++i) {
+      const char* data = NULL;
+      size_t size = 0;
+      if (!decoder.decode_bytes(&data, size)) {
+        return CASS_ERROR_LIB_NOT_ENOUGH_DATA;
+      }
+      CassError rc = append(columns_[i], row, data, size);
+      if (rc != CASS_OK) return rc;
+    }
+  }
+
+  for (ColumnVec::iterator it = columns_.begin(), end = columns_.end(); it != end; ++it) {
+    if (it->values.empty()) continue;
+    switch (it->type) {
+      case CASS_VALUE_TYPE_INT:
+      case CASS_VALUE_TYPE_FLOAT:
+        to_native_int32(&it->values[0], row_count_);
+        break;
+      case CASS_VALUE_TYPE_BIGINT:
+      case CASS_VALUE_TYPE_COUNTER:
+      case CASS_VALUE_TYPE_TIMESTAMP:
+      case CASS_VALUE_TYPE_DOUBLE:
+        to_native_int64(&it->values[0], row_count_);
+        break;
+      default: // UUIDs and variable-width values are kept as-is
+        break;
+    }
+  }
+
+  return CASS_OK;
+}
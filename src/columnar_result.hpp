@@ -0,0 +1,88 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_COLUMNAR_RESULT_HPP
+#define DATASTAX_INTERNAL_COLUMNAR_RESULT_HPP
+
+#include "allocated.hpp"
+#include "cassandra.h"
+#include "external.hpp"
+#include "vector.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+class ResultResponse;
+
+/**
+ * A result's rows decoded into per-column contiguous buffers. The layout is
+ * compatible with the Arrow C data interface: native-endian fixed-width
+ * values, 32-bit offsets for variable-width values and LSB-ordered validity
+ * bitmaps.
+ */
+class ColumnarResult : public Allocated {
+public:
+  struct Column {
+    Column()
+        : type(CASS_VALUE_TYPE_UNKNOWN)
+        , value_size(0)
+        , null_count(0) {}
+
+    CassValueType type;
+    size_t value_size; // 0 for variable-width columns
+    size_t null_count;
+    Vector<cass_uint8_t> validity;
+    Vector<cass_int32_t> offsets;
+    Vector<cass_byte_t> values;
+  };
+
+  typedef Vector<Column> ColumnVec;
+
+  ColumnarResult()
+      : row_count_(0) {}
+
+  /**
+   * Decodes all the rows of a result.
+   *
+   * @param result A rows result.
+   * @return CASS_OK if successful, otherwise an error occurred.
+   */
+  CassError decode(const ResultResponse* result);
+
+  size_t row_count() const { return row_count_; }
+  const ColumnVec& columns() const { return columns_; }
+
+  /**
+   * The size of an exported value for a type.
+   *
+   * @param type
+   * @return The size of a fixed-width value, 0 for variable-width types and
+   * -1 if the type can't be exported.
+   */
+  static int value_size(CassValueType type);
+
+private:
+  static CassError append(Column& column, size_t row, const char* data, size_t size);
+
+private:
+  size_t row_count_;
+  ColumnVec columns_;
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::ColumnarResult, CassColumnarResult)
+
+#endif
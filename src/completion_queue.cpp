@@ -0,0 +1,92 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "completion_queue.hpp"
+
+#include "future.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassCompletionQueue* cass_completion_queue_new(size_t capacity) {
+  if (capacity == 0) return NULL;
+  CompletionQueue* queue = new CompletionQueue(capacity);
+  queue->inc_ref();
+  return CassCompletionQueue::to(queue);
+}
+
+void cass_completion_queue_free(CassCompletionQueue* queue) { queue->dec_ref(); }
+
+size_t cass_completion_queue_drain(CassCompletionQueue* queue, CassCompletion* completions,
+                                   size_t count) {
+  return queue->drain(completions, count);
+}
+
+} // extern "C"
+
+CompletionQueue::CompletionQueue(size_t capacity)
+    : capacity_(capacity)
+    , outstanding_(0)
+    , queue_(capacity) {}
+
+CompletionQueue::~CompletionQueue() {
+  // Release the futures of completions that were never drained
+  CassCompletion completion;
+  while (queue_.dequeue(completion)) {
+    completion.future->from()->dec_ref();
+  }
+}
+
+bool CompletionQueue::reserve() {
+  size_t outstanding = outstanding_.load(MEMORY_ORDER_RELAXED);
+  do {
+    if (outstanding >= capacity_) {
+      return false;
+    }
+  } while (!outstanding_.compare_exchange_weak(outstanding, outstanding + 1));
+  return true;
+}
+
+void CompletionQueue::release() { outstanding_.fetch_sub(1); }
+
+void CompletionQueue::post(Future* future, void* tag) {
+  CassCompletion completion;
+  completion.tag = tag;
+  completion.code = CASS_OK;
+  completion.future = CassFuture::to(future);
+  future->inc_ref(); // The completion's reference
+  const Future::Error* error = future->error();
+  if (error != NULL) {
+    completion.code = error->code;
+  }
+  bool is_enqueued = queue_.enqueue(completion);
+  assert(is_enqueued && "Completion posted without a reservation");
+  UNUSED_(is_enqueued);
+}
+
+size_t CompletionQueue::drain(CassCompletion* completions, size_t count) {
+  size_t drained = 0;
+  while (drained < count && queue_.dequeue(completions[drained])) {
+    drained++;
+  }
+  if (drained > 0) {
+    outstanding_.fetch_sub(drained);
+  }
+  return drained;
+}
@@ -0,0 +1,94 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_COMPLETION_QUEUE_HPP
+#define DATASTAX_INTERNAL_COMPLETION_QUEUE_HPP
+
+#include "atomic.hpp"
+#include "cassandra.h"
+#include "external.hpp"
+#include "macros.hpp"
+#include "mpmc_queue.hpp"
+#include "ref_counted.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+class Future;
+
+/**
+ * A bounded, lock-free queue of completed requests. Futures post a completion
+ * record (tag, error code and a reference to the future) from the thread that
+ * sets them and the application drains the records in batches from its own
+ * threads.
+ *
+ * Space is reserved for a completion when a request is submitted so posting a
+ * completion never fails.
+ */
+class CompletionQueue : public RefCounted<CompletionQueue> {
+public:
+  typedef SharedRefPtr<CompletionQueue> Ptr;
+
+  CompletionQueue(size_t capacity);
+  ~CompletionQueue();
+
+  size_t capacity() const { return capacity_; }
+
+  /**
+   * Reserve space for a completion (thread-safe).
+   *
+   * @return false if the queue already has the maximum number of outstanding
+   * completions.
+   */
+  bool reserve();
+
+  /**
+   * Release a reservation that's not going to be used (thread-safe).
+   */
+  void release();
+
+  /**
+   * Post a completion for a future that's been set. A reservation must have
+   * been made (thread-safe).
+   *
+   * @param future The future that's been set. The completion keeps a reference
+   * to the future.
+   * @param tag The tag provided when the request was submitted.
+   */
+  void post(Future* future, void* tag);
+
+  /**
+   * Remove up to `count` completions (thread-safe).
+   *
+   * @param completions The output array of completions.
+   * @param count The maximum number of completions to remove.
+   * @return The number of completions removed.
+   */
+  size_t drain(CassCompletion* completions, size_t count);
+
+private:
+  const size_t capacity_;
+  Atomic<size_t> outstanding_;
+  MPMCQueue<CassCompletion> queue_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(CompletionQueue);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::CompletionQueue, CassCompletionQueue)
+
+#endif
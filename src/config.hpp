@@ -18,6 +18,7 @@
 #define DATASTAX_INTERNAL_CONFIG_HPP
 
 #include "auth.hpp"
+#include "callback_executor.hpp"
 #include "cassandra.h"
 #include "cloud_secure_connection_config.hpp"
 #include "cluster_metadata_resolver.hpp"
@@ -70,6 +71,11 @@ public:
       , max_reusable_write_objects_(CASS_DEFAULT_MAX_REUSABLE_WRITE_OBJECTS)
       , prepare_on_all_hosts_(CASS_DEFAULT_PREPARE_ON_ALL_HOSTS)
       , prepare_on_up_or_add_host_(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST)
+      , prepare_on_up_or_add_host_concurrency_(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST_CONCURRENCY)
+      , prepare_on_up_or_add_host_rate_(CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST_RATE)
+      , prepared_cache_size_(CASS_DEFAULT_PREPARED_CACHE_SIZE)
+      , statement_metrics_size_(CASS_DEFAULT_STATEMENT_METRICS_SIZE)
+      , request_timings_(CASS_DEFAULT_REQUEST_TIMINGS)
       , no_compact_(CASS_DEFAULT_NO_COMPACT)
       , is_client_id_set_(false)
       , host_listener_(new DefaultHostListener())
@@ -243,6 +249,10 @@ public:
     default_profile_.set_token_aware_routing_shuffle_replicas(shuffle_replicas);
   }
 
+  void set_token_aware_routing_order_replicas_by_latency(bool order_replicas_by_latency) {
+    default_profile_.set_token_aware_routing_order_replicas_by_latency(order_replicas_by_latency);
+  }
+
   void set_latency_aware_routing(bool is_latency_aware) {
     default_profile_.set_latency_aware_routing(is_latency_aware);
   }
@@ -251,6 +261,14 @@ public:
     default_profile_.set_latency_aware_routing_settings(settings);
   }
 
+  void set_outlier_detection(bool is_outlier_detection) {
+    default_profile_.set_outlier_detection(is_outlier_detection);
+  }
+
+  void set_outlier_detection_settings(const OutlierDetectionPolicy::Settings& settings) {
+    default_profile_.set_outlier_detection_settings(settings);
+  }
+
   bool tcp_nodelay_enable() const { return tcp_nodelay_enable_; }
 
   void set_tcp_nodelay(bool enable) { tcp_nodelay_enable_ = enable; }
@@ -322,6 +340,36 @@ public:
 
   void set_prepare_on_up_or_add_host(bool enabled) { prepare_on_up_or_add_host_ = enabled; }
 
+  unsigned prepare_on_up_or_add_host_concurrency() const {
+    return prepare_on_up_or_add_host_concurrency_;
+  }
+
+  void set_prepare_on_up_or_add_host_concurrency(unsigned concurrency) {
+    prepare_on_up_or_add_host_concurrency_ = concurrency;
+  }
+
+  unsigned prepare_on_up_or_add_host_rate() const { return prepare_on_up_or_add_host_rate_; }
+
+  void set_prepare_on_up_or_add_host_rate(unsigned per_second) {
+    prepare_on_up_or_add_host_rate_ = per_second;
+  }
+
+  unsigned prepared_cache_size() const { return prepared_cache_size_; }
+
+  void set_prepared_cache_size(unsigned size) { prepared_cache_size_ = size; }
+
+  unsigned statement_metrics_size() const { return statement_metrics_size_; }
+
+  void set_statement_metrics_size(unsigned size) { statement_metrics_size_ = size; }
+
+  bool request_timings() const { return request_timings_; }
+
+  void set_request_timings(bool enabled) { request_timings_ = enabled; }
+
+  const String& prepared_statements_file() const { return prepared_statements_file_; }
+
+  void set_prepared_statements_file(const String& path) { prepared_statements_file_ = path; }
+
   const Address& local_address() const { return local_address_; }
 
   void set_local_address(const Address& address) { local_address_ = address; }
@@ -360,6 +408,13 @@ public:
     }
   }
 
+  // A null pointer if callbacks are run on the I/O threads
+  const CallbackExecutor::Ptr& callback_executor() const { return callback_executor_; }
+
+  void set_callback_executor(const CallbackExecutor::Ptr& callback_executor) {
+    callback_executor_ = callback_executor;
+  }
+
   unsigned monitor_reporting_interval_secs() const { return monitor_reporting_interval_secs_; }
   void set_monitor_reporting_interval_secs(unsigned interval_secs) {
     monitor_reporting_interval_secs_ = interval_secs;
@@ -431,6 +486,12 @@ private:
   ExecutionProfile::Map profiles_;
   bool prepare_on_all_hosts_;
   bool prepare_on_up_or_add_host_;
+  unsigned prepare_on_up_or_add_host_concurrency_;
+  unsigned prepare_on_up_or_add_host_rate_;
+  unsigned prepared_cache_size_;
+  unsigned statement_metrics_size_;
+  bool request_timings_;
+  String prepared_statements_file_;
   Address local_address_;
   bool no_compact_;
   String application_name_;
@@ -438,6 +499,7 @@ private:
   bool is_client_id_set_;
   CassUuid client_id_;
   DefaultHostListener::Ptr host_listener_;
+  CallbackExecutor::Ptr callback_executor_;
   unsigned monitor_reporting_interval_secs_;
   CloudSecureConnectionConfig cloud_secure_connection_config_;
   ClusterMetadataResolverFactory::Ptr cluster_metadata_resolver_factory_;
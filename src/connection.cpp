@@ -195,6 +195,10 @@ void Connection::on_write(int status, RequestCallback* request) {
   // Keep alive after releasing from the stream manager.
   RequestCallback::Ptr callback(request);
 
+  if (status == 0) {
+    callback->on_flush();
+  }
+
   switch (callback->state()) {
     case RequestCallback::REQUEST_STATE_WRITING:
       if (status == 0) {
@@ -234,7 +238,14 @@ void Connection::on_read(const char* buf, size_t size) {
   // A successful read means the connection is still responsive
   restart_terminate_timer();
 
+  uint64_t read_time_ns = uv_hrtime();
+
   while (remaining != 0 && !socket_->is_closing()) {
+    // Record when the first bytes of each response are read
+    if (response_->received_time_ns() == 0) {
+      response_->set_received_time_ns(read_time_ns);
+    }
+
     ssize_t consumed = response_->decode(pos, remaining);
     if (consumed <= 0) {
       LOG_ERROR("Error decoding/consuming message");
@@ -264,6 +275,16 @@ void Connection::on_read(const char* buf, size_t size) {
         RequestCallback::Ptr callback;
 
         if (stream_manager_.get(response->stream(), callback)) {
+          if (response->has_more_continuous_pages() &&
+              (callback->state() == RequestCallback::REQUEST_STATE_READING ||
+               callback->state() == RequestCallback::REQUEST_STATE_WRITING)) {
+            // More pages are coming on the same stream so keep the request in-flight
+            callback->on_set(response.get());
+            remaining -= consumed;
+            pos += consumed;
+            continue;
+          }
+
           switch (callback->state()) {
             case RequestCallback::REQUEST_STATE_READING:
               pending_reads_.remove(callback.get());
@@ -100,6 +100,9 @@
 #define CASS_RESULT_FLAG_CONTINUOUS_PAGING 0x40000000
 #define CASS_RESULT_FLAG_LAST_CONTINUOUS_PAGE 0x80000000
 
+#define CASS_REVISION_CANCEL_CONTINUOUS_PAGING 1
+#define CASS_REVISION_MORE_CONTINUOUS_PAGES 2
+
 #define CASS_EVENT_TOPOLOGY_CHANGE 1
 #define CASS_EVENT_STATUS_CHANGE 2
 #define CASS_EVENT_SCHEMA_CHANGE 4
@@ -113,12 +116,17 @@
 #define CASS_DEFAULT_HOSTNAME_RESOLUTION_ENABLED false
 #define CASS_DEFAULT_IDLE_TIMEOUT_SECS 60
 #define CASS_DEFAULT_LOG_LEVEL CASS_LOG_WARN
-#define CASS_DEFAULT_MAX_PREPARES_PER_FLUSH 128
 #define CASS_DEFAULT_MAX_REUSABLE_WRITE_OBJECTS UINT_MAX
 #define CASS_DEFAULT_MAX_SCHEMA_WAIT_TIME_MS 10000
 #define CASS_DEFAULT_NUM_CONNECTIONS_PER_HOST 1
 #define CASS_DEFAULT_PREPARE_ON_ALL_HOSTS true
 #define CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST true
+#define CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST_CONCURRENCY 128
+#define CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST_RATE 0
+#define CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST_HOT_WINDOW_MS 60000
+#define CASS_DEFAULT_PREPARED_CACHE_SIZE 512
+#define CASS_DEFAULT_STATEMENT_METRICS_SIZE 0
+#define CASS_DEFAULT_REQUEST_TIMINGS false
 #define CASS_DEFAULT_PORT 9042
 #define CASS_DEFAULT_QUEUE_SIZE_IO 8192
 #define CASS_DEFAULT_CONSTANT_RECONNECT_WAIT_TIME_MS 2000u
@@ -126,6 +134,7 @@
   CASS_DEFAULT_CONSTANT_RECONNECT_WAIT_TIME_MS
 #define CASS_DEFAULT_EXPONENTIAL_RECONNECT_MAX_DELAY_MS 600000u // 10 minutes
 #define CASS_DEFAULT_RESOLVE_TIMEOUT_MS 5000
+#define CASS_DEFAULT_TABLE_SCAN_PAGE_SIZE 5000
 #define CASS_DEFAULT_TCP_KEEPALIVE_DELAY_SECS 0
 #define CASS_DEFAULT_TCP_KEEPALIVE_ENABLED true
 #define CASS_DEFAULT_TCP_NO_DELAY_ENABLED true
@@ -136,6 +145,8 @@
 #define CASS_DEFAULT_USE_RANDOMIZED_CONTACT_POINTS true
 #define CASS_DEFAULT_USE_SCHEMA true
 #define CASS_DEFAULT_COALESCE_DELAY 200
+#define CASS_DEFAULT_CONTINUOUS_PAGING_MAX_ENQUEUED_PAGES 4
+#define CASS_DEFAULT_CONTINUOUS_PAGING_PAGE_SIZE 5000
 #define CASS_DEFAULT_NEW_REQUEST_RATIO 50
 #define CASS_DEFAULT_NO_COMPACT false
 #define CASS_DEFAULT_CQL_VERSION "3.0.0"
@@ -27,10 +27,12 @@ using namespace datastax::internal;
 using namespace datastax::internal::core;
 
 DCAwarePolicy::DCAwarePolicy(const String& local_dc, size_t used_hosts_per_remote_dc,
-                             bool skip_remote_dcs_for_local_cl)
+                             bool skip_remote_dcs_for_local_cl, const String& local_rack)
     : local_dc_(local_dc)
     , used_hosts_per_remote_dc_(used_hosts_per_remote_dc)
     , skip_remote_dcs_for_local_cl_(skip_remote_dcs_for_local_cl)
+    , local_rack_(local_rack)
+    , local_rack_live_hosts_(new HostVec())
     , local_dc_live_hosts_(new HostVec())
     , index_(0) {
   uv_rwlock_init(&available_rwlock_);
@@ -83,6 +85,10 @@ CassHostDistance DCAwarePolicy::distance(const Host::Ptr& host) const {
   return CASS_HOST_DISTANCE_IGNORE;
 }
 
+bool DCAwarePolicy::is_local_rack(const Host::Ptr& host) const {
+  return !local_rack_.empty() && host->rack() == local_rack_ && host->dc() == local_dc_;
+}
+
 QueryPlan* DCAwarePolicy::new_query_plan(const String& keyspace, RequestHandler* request_handler,
                                          const TokenMap* token_map) {
   CassConsistency cl =
@@ -105,6 +111,9 @@ void DCAwarePolicy::on_host_added(const Host::Ptr& host) {
   }
 
   if (dc == local_dc_) {
+    if (is_local_rack(host)) {
+      add_host(local_rack_live_hosts_, host);
+    }
     add_host(local_dc_live_hosts_, host);
   } else {
     per_remote_dc_live_hosts_.add_host_to_dc(dc, host);
@@ -114,6 +123,7 @@ void DCAwarePolicy::on_host_added(const Host::Ptr& host) {
 void DCAwarePolicy::on_host_removed(const Host::Ptr& host) {
   const String& dc = host->dc();
   if (dc == local_dc_) {
+    remove_host(local_rack_live_hosts_, host);
     remove_host(local_dc_live_hosts_, host);
   } else {
     per_remote_dc_live_hosts_.remove_host_from_dc(host->dc(), host);
@@ -131,6 +141,7 @@ void DCAwarePolicy::on_host_up(const Host::Ptr& host) {
 }
 
 void DCAwarePolicy::on_host_down(const Address& address) {
+  remove_host(local_rack_live_hosts_, address);
   if (!remove_host(local_dc_live_hosts_, address) &&
       !per_remote_dc_live_hosts_.remove_host(address)) {
     LOG_DEBUG("Attempted to mark host %s as DOWN, but it doesn't exist",
@@ -218,16 +229,28 @@ DCAwarePolicy::DCAwareQueryPlan::DCAwareQueryPlan(const DCAwarePolicy* policy, C
                                                   size_t start_index)
     : policy_(policy)
     , cl_(cl)
+    , rack_hosts_(policy_->local_rack_live_hosts_)
     , hosts_(policy_->local_dc_live_hosts_)
+    , rack_remaining_(get_hosts_size(rack_hosts_))
     , local_remaining_(get_hosts_size(hosts_))
     , remote_remaining_(0)
+    , rack_index_(start_index)
     , index_(start_index) {}
 
 Host::Ptr DCAwarePolicy::DCAwareQueryPlan::compute_next() {
+  while (rack_remaining_ > 0) {
+    --rack_remaining_;
+    const Host::Ptr& host(get_next_host(rack_hosts_, rack_index_++));
+    if (policy_->is_host_up(host->address())) {
+      return host;
+    }
+  }
+
   while (local_remaining_ > 0) {
     --local_remaining_;
     const Host::Ptr& host(get_next_host(hosts_, index_++));
-    if (policy_->is_host_up(host->address())) {
+    // Hosts in the local rack have already been tried
+    if (!policy_->is_local_rack(host) && policy_->is_host_up(host->address())) {
       return host;
     }
   }
@@ -32,7 +32,7 @@ namespace datastax { namespace internal { namespace core {
 class DCAwarePolicy : public LoadBalancingPolicy {
 public:
   DCAwarePolicy(const String& local_dc = "", size_t used_hosts_per_remote_dc = 0,
-                bool skip_remote_dcs_for_local_cl = true);
+                bool skip_remote_dcs_for_local_cl = true, const String& local_rack = "");
 
   ~DCAwarePolicy();
 
@@ -41,6 +41,8 @@ public:
 
   virtual CassHostDistance distance(const Host::Ptr& host) const;
 
+  virtual bool is_local_rack(const Host::Ptr& host) const;
+
   virtual QueryPlan* new_query_plan(const String& keyspace, RequestHandler* request_handler,
                                     const TokenMap* token_map);
 
@@ -54,9 +56,11 @@ public:
   virtual bool skip_remote_dcs_for_local_cl() const;
   virtual size_t used_hosts_per_remote_dc() const;
   virtual const String& local_dc() const;
+  const String& local_rack() const { return local_rack_; }
 
   virtual LoadBalancingPolicy* new_instance() {
-    return new DCAwarePolicy(local_dc_, used_hosts_per_remote_dc_, skip_remote_dcs_for_local_cl_);
+    return new DCAwarePolicy(local_dc_, used_hosts_per_remote_dc_, skip_remote_dcs_for_local_cl_,
+                             local_rack_);
   }
 
 private:
@@ -99,10 +103,13 @@ public:
   private:
     const DCAwarePolicy* policy_;
     CassConsistency cl_;
+    CopyOnWriteHostVec rack_hosts_;
     CopyOnWriteHostVec hosts_;
     ScopedPtr<PerDCHostMap::KeySet> remote_dcs_;
+    size_t rack_remaining_;
     size_t local_remaining_;
     size_t remote_remaining_;
+    size_t rack_index_;
     size_t index_;
   };
 
@@ -113,7 +120,9 @@ private:
   String local_dc_;
   size_t used_hosts_per_remote_dc_;
   bool skip_remote_dcs_for_local_cl_;
+  String local_rack_;
 
+  CopyOnWriteHostVec local_rack_live_hosts_;
   CopyOnWriteHostVec local_dc_live_hosts_;
   PerDCHostMap per_remote_dc_live_hosts_;
   size_t index_;
@@ -167,6 +167,33 @@ bool Decoder::decode_value(const DataType::ConstPtr& data_type, Value& output,
   return true;
 }
 
+bool Decoder::decode_borrowed_value(const DataType::ConstPtr& data_type, Value& output) {
+  int32_t size = 0;
+
+  if (!decode_int32(size)) {
+    return false;
+  }
+
+  if (size >= 0) {
+    CHECK_REMAINING(size, "value");
+    Decoder decoder(input_, size, protocol_version_);
+    input_ += size;
+    remaining_ -= size;
+
+    int32_t count = 0;
+    if (data_type->is_collection()) {
+      if (!decoder.decode_int32(count)) return false;
+    } else {
+      count = Value::element_count(data_type.get());
+    }
+    output.set_borrowed(data_type, count, decoder, false);
+  } else { // null value
+    output.set_borrowed(data_type, 0, Decoder(), true);
+  }
+
+  return true;
+}
+
 void Decoder::notify_error(const char* detail, size_t bytes) const {
   if (strlen(type_) == 0) {
     LOG_ERROR("Expected at least %u byte%s to decode %s value", static_cast<unsigned int>(bytes),
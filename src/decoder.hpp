@@ -52,12 +52,14 @@ typedef SmallVector<CustomPayloadItem, 8> CustomPayloadVec;
 
 typedef SmallVector<StringRef, 8> WarningVec;
 
-class Value; // Forward declaration
+class ResultResponse; // Forward declaration
+class Value;          // Forward declaration
 
 /**
  * Decoder class to validate server responses
  */
 class Decoder {
+  friend class ResultResponse;
   friend class Value;
 
 public:
@@ -561,6 +563,10 @@ public:
   bool decode_value(const DataType::ConstPtr& data_type, Value& output,
                     bool is_inside_collection = false);
 
+  // Decodes a value that references, rather than copies, its data type. The
+  // data type must outlive the value e.g. when it's owned by result metadata.
+  bool decode_borrowed_value(const DataType::ConstPtr& data_type, Value& output);
+
 protected:
   // Testing only
   inline const char* buffer() const { return input_; }
@@ -19,12 +19,34 @@
 #include "constants.hpp"
 #include "protocol.hpp"
 #include "request_callback.hpp"
+#include "statement_template.hpp"
 
 using namespace datastax::internal::core;
 
 ExecuteRequest::ExecuteRequest(const Prepared* prepared)
     : Statement(prepared)
-    , prepared_(prepared) {}
+    , prepared_(prepared)
+    , has_encoded_values_(false)
+    , has_unset_values_(false)
+    , encoded_values_count_(0) {}
+
+ExecuteRequest::ExecuteRequest(const Prepared* prepared, const Statement& statement)
+    : Statement(prepared, statement)
+    , prepared_(prepared)
+    , has_encoded_values_(false)
+    , has_unset_values_(false)
+    , encoded_values_count_(0) {}
+
+ExecuteRequest::ExecuteRequest(const StatementTemplate* statement_template)
+    : Statement(statement_template->encoded_id())
+    , prepared_(statement_template->prepared())
+    , has_encoded_values_(true)
+    , has_unset_values_(statement_template->has_unset_values())
+    , encoded_values_count_(static_cast<uint16_t>(statement_template->values_count()))
+    , encoded_values_(statement_template->encode_values()) {
+  set_settings(statement_template->settings());
+  statement_template->get_routing_key(&routing_key_);
+}
 
 int ExecuteRequest::encode(ProtocolVersion version, RequestCallback* callback,
                            BufferVec* bufs) const {
@@ -40,10 +62,23 @@ int ExecuteRequest::encode(ProtocolVersion version, RequestCallback* callback,
       length += bufs->back().size();
     }
   }
-  length += encode_begin(version, static_cast<uint16_t>(elements().size()), callback, bufs);
-  int32_t result = encode_values(version, callback, bufs);
-  if (result < 0) return result;
-  length += result;
+  if (has_encoded_values_) {
+    if (has_unset_values_ && version < CASS_PROTOCOL_VERSION_V4) {
+      callback->on_error(CASS_ERROR_LIB_PARAMETER_UNSET,
+                         "Statement template has parameters that were not set");
+      return Request::REQUEST_ERROR_PARAMETER_UNSET;
+    }
+    length += encode_begin(version, encoded_values_count_, callback, bufs);
+    if (encoded_values_count_ > 0) { // The values are already encoded as contiguous [bytes]
+      bufs->push_back(encoded_values_);
+      length += encoded_values_.size();
+    }
+  } else {
+    length += encode_begin(version, static_cast<uint16_t>(elements().size()), callback, bufs);
+    int32_t result = encode_values(version, callback, bufs);
+    if (result < 0) return result;
+    length += result;
+  }
   length += encode_end(version, callback, bufs);
   return length;
 }
@@ -26,15 +26,27 @@
 
 namespace datastax { namespace internal { namespace core {
 
+class StatementTemplate;
+
 class ExecuteRequest : public Statement {
 public:
   ExecuteRequest(const Prepared* prepared);
 
+  ExecuteRequest(const Prepared* prepared, const Statement& statement);
+
+  // Creates a bound statement using a copy of a statement template's values
+  ExecuteRequest(const StatementTemplate* statement_template);
+
   const Prepared::ConstPtr& prepared() const { return prepared_; }
 
   virtual int encode(ProtocolVersion version, RequestCallback* callback, BufferVec* bufs) const;
 
   bool get_routing_key(String* routing_key) const {
+    if (has_encoded_values_) {
+      if (routing_key_.empty()) return false;
+      *routing_key = routing_key_;
+      return true;
+    }
     return calculate_routing_key(prepared_->key_indices(), routing_key);
   }
 
@@ -49,6 +61,11 @@ private:
 
 private:
   Prepared::ConstPtr prepared_;
+  bool has_encoded_values_;
+  bool has_unset_values_;
+  uint16_t encoded_values_count_;
+  Buffer encoded_values_;
+  String routing_key_;
 };
 
 }}} // namespace datastax::internal::core
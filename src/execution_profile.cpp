@@ -74,6 +74,29 @@ CassError cass_execution_profile_set_load_balance_dc_aware_n(
   return CASS_OK;
 }
 
+CassError cass_execution_profile_set_load_balance_rack_aware(CassExecProfile* profile,
+                                                             const char* local_dc,
+                                                             const char* local_rack) {
+  if (local_dc == NULL || local_rack == NULL) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  return cass_execution_profile_set_load_balance_rack_aware_n(
+      profile, local_dc, SAFE_STRLEN(local_dc), local_rack, SAFE_STRLEN(local_rack));
+}
+
+CassError cass_execution_profile_set_load_balance_rack_aware_n(CassExecProfile* profile,
+                                                               const char* local_dc,
+                                                               size_t local_dc_length,
+                                                               const char* local_rack,
+                                                               size_t local_rack_length) {
+  if (local_dc == NULL || local_dc_length == 0 || local_rack == NULL || local_rack_length == 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  profile->set_load_balancing_policy(new DCAwarePolicy(
+      String(local_dc, local_dc_length), 0, true, String(local_rack, local_rack_length)));
+  return CASS_OK;
+}
+
 CassError cass_execution_profile_set_token_aware_routing(CassExecProfile* profile,
                                                          cass_bool_t enabled) {
   profile->set_token_aware_routing(enabled == cass_true);
@@ -95,7 +118,7 @@ CassError cass_execution_profile_set_latency_aware_routing(CassExecProfile* prof
 CassError cass_execution_profile_set_latency_aware_routing_settings(
     CassExecProfile* profile, cass_double_t exclusion_threshold, cass_uint64_t scale_ms,
     cass_uint64_t retry_period_ms, cass_uint64_t update_rate_ms, cass_uint64_t min_measured) {
-  LatencyAwarePolicy::Settings settings;
+  LatencyAwarePolicy::Settings settings(profile->latency_aware_routing_settings());
   settings.exclusion_threshold = exclusion_threshold;
   settings.scale_ns = scale_ms * 1000 * 1000;
   settings.retry_period_ns = retry_period_ms * 1000 * 1000;
@@ -105,6 +128,48 @@ CassError cass_execution_profile_set_latency_aware_routing_settings(
   return CASS_OK;
 }
 
+CassError cass_execution_profile_set_latency_aware_routing_percentile(CassExecProfile* profile,
+                                                                      cass_double_t percentile) {
+  if (percentile <= 0.0 || percentile > 100.0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  LatencyAwarePolicy::Settings settings(profile->latency_aware_routing_settings());
+  settings.percentile = percentile;
+  profile->set_latency_aware_routing_settings(settings);
+  return CASS_OK;
+}
+
+CassError cass_execution_profile_set_outlier_detection(CassExecProfile* profile,
+                                                       cass_bool_t enabled) {
+  profile->set_outlier_detection(enabled == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_execution_profile_set_outlier_detection_settings(
+    CassExecProfile* profile, unsigned consecutive_failures, cass_double_t failure_rate_threshold,
+    unsigned min_requests, cass_uint64_t interval_ms, cass_uint64_t base_ejection_time_ms,
+    cass_uint64_t max_ejection_time_ms) {
+  if (failure_rate_threshold < 0.0 || failure_rate_threshold > 100.0 || interval_ms == 0 ||
+      base_ejection_time_ms > max_ejection_time_ms) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  OutlierDetectionPolicy::Settings settings;
+  settings.consecutive_failures = consecutive_failures;
+  settings.failure_rate_threshold = failure_rate_threshold;
+  settings.min_requests = min_requests;
+  settings.interval_ns = interval_ms * 1000 * 1000;
+  settings.base_ejection_time_ns = base_ejection_time_ms * 1000 * 1000;
+  settings.max_ejection_time_ns = max_ejection_time_ms * 1000 * 1000;
+  profile->set_outlier_detection_settings(settings);
+  return CASS_OK;
+}
+
+CassError cass_execution_profile_set_token_aware_routing_order_replicas_by_latency(
+    CassExecProfile* profile, cass_bool_t enabled) {
+  profile->set_token_aware_routing_order_replicas_by_latency(enabled == cass_true);
+  return CASS_OK;
+}
+
 CassError cass_execution_profile_set_whitelist_filtering(CassExecProfile* profile,
                                                          const char* hosts) {
   return cass_execution_profile_set_whitelist_filtering_n(profile, hosts, SAFE_STRLEN(hosts));
@@ -182,6 +247,21 @@ CassError cass_execution_profile_set_constant_speculative_execution_policy(
   return CASS_OK;
 }
 
+CassError cass_execution_profile_set_adaptive_speculative_execution_policy(
+    CassExecProfile* profile, cass_double_t percentile, int max_speculative_executions,
+    cass_double_t max_speculative_percent) {
+  if (percentile < 0.0 || percentile > 100.0 || max_speculative_executions < 0 ||
+      max_speculative_percent < 0.0 || max_speculative_percent > 100.0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  AdaptiveSpeculativeExecutionPolicy::Settings settings;
+  settings.percentile = percentile;
+  settings.max_speculative_executions = max_speculative_executions;
+  settings.max_speculative_percent = max_speculative_percent;
+  profile->set_speculative_execution_policy(new AdaptiveSpeculativeExecutionPolicy(settings));
+  return CASS_OK;
+}
+
 CassError cass_execution_profile_set_no_speculative_execution_policy(CassExecProfile* profile) {
   profile->set_speculative_execution_policy(new NoSpeculativeExecutionPolicy());
   return CASS_OK;
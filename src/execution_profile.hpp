@@ -25,6 +25,7 @@
 #include "dc_aware_policy.hpp"
 #include "dense_hash_map.hpp"
 #include "latency_aware_policy.hpp"
+#include "outlier_detection_policy.hpp"
 #include "speculative_execution.hpp"
 #include "string.hpp"
 #include "token_aware_policy.hpp"
@@ -43,8 +44,10 @@ public:
       , consistency_(CASS_CONSISTENCY_UNKNOWN)
       , serial_consistency_(CASS_CONSISTENCY_UNKNOWN)
       , latency_aware_routing_(false)
+      , outlier_detection_(false)
       , token_aware_routing_(true)
-      , token_aware_routing_shuffle_replicas_(true) {}
+      , token_aware_routing_shuffle_replicas_(true)
+      , token_aware_routing_order_replicas_by_latency_(false) {}
 
   uint64_t request_timeout_ms() const { return request_timeout_ms_; }
 
@@ -80,6 +83,20 @@ public:
     return latency_aware_routing_settings_;
   }
 
+  bool outlier_detection() const { return outlier_detection_; }
+
+  void set_outlier_detection(bool is_outlier_detection) {
+    outlier_detection_ = is_outlier_detection;
+  }
+
+  void set_outlier_detection_settings(const OutlierDetectionPolicy::Settings& settings) {
+    outlier_detection_settings_ = settings;
+  }
+
+  const OutlierDetectionPolicy::Settings& outlier_detection_settings() const {
+    return outlier_detection_settings_;
+  }
+
   bool token_aware_routing() const { return token_aware_routing_; }
 
   void set_token_aware_routing(bool is_token_aware) { token_aware_routing_ = is_token_aware; }
@@ -92,6 +109,25 @@ public:
     return token_aware_routing_shuffle_replicas_;
   }
 
+  void set_token_aware_routing_order_replicas_by_latency(bool order_replicas_by_latency) {
+    token_aware_routing_order_replicas_by_latency_ = order_replicas_by_latency;
+  }
+
+  bool token_aware_routing_order_replicas_by_latency() const {
+    return token_aware_routing_order_replicas_by_latency_;
+  }
+
+  // Replicas can only be ordered using the percentiles published by
+  // percentile latency-aware routing. Otherwise the setting is ignored.
+  bool can_order_replicas_by_latency() const {
+    return latency_aware() && latency_aware_routing_settings_.percentile > 0.0;
+  }
+
+  bool is_order_replicas_by_latency_ignored() const {
+    return base_load_balancing_policy_ && token_aware_routing() &&
+           token_aware_routing_order_replicas_by_latency_ && !can_order_replicas_by_latency();
+  }
+
   ContactPointList& whitelist() { return whitelist_; }
   const ContactPointList& whitelist() const { return whitelist_; }
 
@@ -118,7 +154,7 @@ public:
 
   void build_load_balancing_policy() {
     // The base LBP can be augmented by special wrappers (whitelist,
-    // token aware, latency aware)
+    // token aware, latency aware, outlier detection)
     if (base_load_balancing_policy_) {
       LoadBalancingPolicy* chain = base_load_balancing_policy_->new_instance();
 
@@ -135,11 +171,19 @@ public:
         chain = new WhitelistDCPolicy(chain, whitelist_dc_);
       }
       if (token_aware_routing()) {
-        chain = new TokenAwarePolicy(chain, token_aware_routing_shuffle_replicas_);
+        // An invalid setting is reported once when the session connects
+        chain = new TokenAwarePolicy(chain, token_aware_routing_shuffle_replicas_,
+                                     token_aware_routing_order_replicas_by_latency_ &&
+                                         can_order_replicas_by_latency(),
+                                     latency_aware_routing_settings_.retry_period_ns,
+                                     latency_aware_routing_settings_.min_measured);
       }
       if (latency_aware()) {
         chain = new LatencyAwarePolicy(chain, latency_aware_routing_settings_);
       }
+      if (outlier_detection()) {
+        chain = new OutlierDetectionPolicy(chain, outlier_detection_settings_);
+      }
 
       load_balancing_policy_.reset(chain);
     }
@@ -158,6 +202,17 @@ public:
     speculative_execution_policy_.reset(sep);
   }
 
+  /**
+   * Replace the speculative execution policy with a new instance so that
+   * policies that keep state (e.g. the adaptive policy) are not shared across
+   * event loops.
+   */
+  void build_speculative_execution_policy() {
+    if (speculative_execution_policy_) {
+      speculative_execution_policy_.reset(speculative_execution_policy_->new_instance());
+    }
+  }
+
 private:
   cass_uint64_t request_timeout_ms_;
   CassConsistency consistency_;
@@ -166,8 +221,11 @@ private:
   DcList blacklist_dc_;
   bool latency_aware_routing_;
   LatencyAwarePolicy::Settings latency_aware_routing_settings_;
+  bool outlier_detection_;
+  OutlierDetectionPolicy::Settings outlier_detection_settings_;
   bool token_aware_routing_;
   bool token_aware_routing_shuffle_replicas_;
+  bool token_aware_routing_order_replicas_by_latency_;
   ContactPointList whitelist_;
   DcList whitelist_dc_;
   LoadBalancingPolicy::Ptr load_balancing_policy_;
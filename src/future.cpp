@@ -35,7 +35,20 @@ void cass_future_free(CassFuture* future) {
 }
 
 CassError cass_future_set_callback(CassFuture* future, CassFutureCallback callback, void* data) {
-  if (!future->set_callback(callback, data)) {
+  if (!future->set_application_callback(callback, data)) {
+    return CASS_ERROR_LIB_CALLBACK_ALREADY_SET;
+  }
+  return CASS_OK;
+}
+
+CassError cass_future_set_completion_queue(CassFuture* future, CassCompletionQueue* queue,
+                                           void* tag) {
+  CompletionQueue::Ptr completion_queue(queue->from());
+  if (!completion_queue->reserve()) {
+    return CASS_ERROR_LIB_REQUEST_QUEUE_FULL;
+  }
+  if (!future->set_completion_queue(completion_queue, tag)) {
+    completion_queue->release();
     return CASS_ERROR_LIB_CALLBACK_ALREADY_SET;
   }
   return CASS_OK;
@@ -51,6 +64,34 @@ cass_bool_t cass_future_wait_timed(CassFuture* future, cass_duration_t wait_us)
   return static_cast<cass_bool_t>(future->wait_for(wait_us));
 }
 
+cass_bool_t cass_future_wait_all(CassFuture* const* futures, size_t count,
+                                 cass_duration_t timeout_us) {
+  if (count == 0) return cass_true;
+  Vector<Future*> internal_futures;
+  internal_futures.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    internal_futures.push_back(futures[i]->from());
+  }
+  return static_cast<cass_bool_t>(
+      Future::wait_all(&internal_futures[0], internal_futures.size(), timeout_us));
+}
+
+cass_bool_t cass_future_wait_any(CassFuture* const* futures, size_t count,
+                                 cass_duration_t timeout_us, size_t* index) {
+  if (index != NULL) *index = count;
+  if (count == 0) return cass_false;
+  Vector<Future*> internal_futures;
+  internal_futures.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    internal_futures.push_back(futures[i]->from());
+  }
+  size_t ready_index = count;
+  bool is_ready =
+      Future::wait_any(&internal_futures[0], internal_futures.size(), timeout_us, &ready_index);
+  if (index != NULL) *index = ready_index;
+  return static_cast<cass_bool_t>(is_ready);
+}
+
 const CassResult* cass_future_get_result(CassFuture* future) {
   if (future->type() != Future::FUTURE_TYPE_RESPONSE) {
     return NULL;
@@ -77,7 +118,8 @@ const CassPrepared* cass_future_get_prepared(CassFuture* future) {
   }
 
   Prepared* prepared =
-      new Prepared(result, response_future->prepare_request, *response_future->schema_metadata);
+      new Prepared(result, response_future->prepare_request, *response_future->schema_metadata,
+                   response_future->prepared_metadata_entry);
   prepared->inc_ref();
   return CassPrepared::to(prepared);
 }
@@ -132,6 +174,28 @@ CassError cass_future_tracing_id(CassFuture* future, CassUuid* tracing_id) {
   return CASS_OK;
 }
 
+CassError cass_future_timings(CassFuture* future, CassRequestTimings* timings) {
+  if (future->type() != Future::FUTURE_TYPE_RESPONSE) {
+    return CASS_ERROR_LIB_INVALID_FUTURE_TYPE;
+  }
+
+  RequestTimings internal_timings;
+  if (!static_cast<ResponseFuture*>(future->from())->timings(&internal_timings)) {
+    return CASS_ERROR_LIB_INVALID_STATE;
+  }
+
+  timings->enqueued = internal_timings.times[RequestTimings::STAGE_ENQUEUED];
+  timings->dequeued = internal_timings.times[RequestTimings::STAGE_DEQUEUED];
+  timings->plan_built = internal_timings.times[RequestTimings::STAGE_PLAN_BUILT];
+  timings->write_queued = internal_timings.times[RequestTimings::STAGE_WRITE_QUEUED];
+  timings->write_flushed = internal_timings.times[RequestTimings::STAGE_WRITE_FLUSHED];
+  timings->response_received = internal_timings.times[RequestTimings::STAGE_RESPONSE_RECEIVED];
+  timings->response_decoded = internal_timings.times[RequestTimings::STAGE_RESPONSE_DECODED];
+  timings->callback_invoked = internal_timings.times[RequestTimings::STAGE_CALLBACK_INVOKED];
+
+  return CASS_OK;
+}
+
 size_t cass_future_custom_payload_item_count(CassFuture* future) {
   if (future->type() != Future::FUTURE_TYPE_RESPONSE) {
     return 0;
@@ -166,30 +230,193 @@ CassError cass_future_custom_payload_item(CassFuture* future, size_t index, cons
 } // extern "C"
 
 bool Future::set_callback(Future::Callback callback, void* data) {
+  return internal_set_callback(callback, data, false);
+}
+
+bool Future::set_application_callback(Future::Callback callback, void* data) {
+  return internal_set_callback(callback, data, true);
+}
+
+bool Future::internal_set_callback(Future::Callback callback, void* data,
+                                   bool is_application_callback) {
   ScopedMutex lock(&mutex_);
-  if (callback_) {
+  if (callback_ || has_completion_queue_) {
     return false; // Callback is already set
   }
   callback_ = callback;
   data_ = data;
+  is_application_callback_ = is_application_callback;
   if (is_set_) {
     // Run the callback if the future is already set
     lock.unlock();
+    on_callback_invoked();
     callback(CassFuture::to(this), data);
   }
   return true;
 }
 
+bool Future::set_completion_queue(const CompletionQueue::Ptr& completion_queue, void* tag) {
+  ScopedMutex lock(&mutex_);
+  if (callback_ || has_completion_queue_) {
+    return false; // Callback is already set
+  }
+  has_completion_queue_ = true;
+  if (is_set_) {
+    // Post the completion if the future is already set
+    lock.unlock();
+    completion_queue->post(this, tag);
+  } else {
+    completion_queue_ = completion_queue;
+    completion_tag_ = tag;
+  }
+  return true;
+}
+
+void FutureWaiter::notify() {
+  ScopedMutex lock(&mutex_);
+  if (remaining_ > 0 && --remaining_ == 0) {
+    uv_cond_signal(&cond_);
+  }
+}
+
+bool FutureWaiter::wait_for(uint64_t timeout_us) {
+  ScopedMutex lock(&mutex_);
+  uint64_t deadline_ns = uv_hrtime() + timeout_us * 1000;
+  while (remaining_ > 0) {
+    uint64_t now_ns = uv_hrtime();
+    if (now_ns >= deadline_ns ||
+        uv_cond_timedwait(&cond_, lock.get(), deadline_ns - now_ns) != 0) {
+      return remaining_ == 0;
+    }
+  }
+  return true;
+}
+
+bool Future::wait_all(Future* const* futures, size_t count, uint64_t timeout_us) {
+  FutureWaiter::Ptr waiter(new FutureWaiter(count));
+  for (size_t i = 0; i < count; ++i) {
+    if (!futures[i]->add_waiter(waiter)) {
+      waiter->notify();
+    }
+  }
+
+  if (waiter->wait_for(timeout_us)) {
+    return true; // All the futures have been set and have removed the waiter
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    futures[i]->remove_waiter(waiter);
+  }
+  return false;
+}
+
+bool Future::wait_any(Future* const* futures, size_t count, uint64_t timeout_us, size_t* index) {
+  FutureWaiter::Ptr waiter(new FutureWaiter(1));
+  size_t registered = 0;
+  while (registered < count && futures[registered]->add_waiter(waiter)) {
+    registered++;
+  }
+
+  bool is_ready = registered < count || waiter->wait_for(timeout_us);
+
+  for (size_t i = 0; i < registered; ++i) {
+    futures[i]->remove_waiter(waiter);
+  }
+
+  if (is_ready) {
+    for (size_t i = 0; i < count; ++i) {
+      if (futures[i]->done()) {
+        *index = i;
+        break;
+      }
+    }
+  }
+  return is_ready;
+}
+
+bool Future::add_waiter(const FutureWaiter::Ptr& waiter) {
+  ScopedMutex lock(&mutex_);
+  if (is_done()) return false;
+  waiters_.push_back(waiter);
+  return true;
+}
+
+void Future::remove_waiter(const FutureWaiter::Ptr& waiter) {
+  ScopedMutex lock(&mutex_);
+  for (Vector<FutureWaiter::Ptr>::iterator it = waiters_.begin(), end = waiters_.end(); it != end;
+       ++it) {
+    if (*it == waiter) {
+      waiters_.erase(it);
+      return;
+    }
+  }
+}
+
 void Future::internal_set(ScopedMutex& lock) {
   is_set_ = true;
+  CallbackExecutor::Ptr callback_executor(callback_executor_);
+  callback_executor_.reset();
   if (callback_) {
     Callback callback = callback_;
     void* data = data_;
+    if (!is_application_callback_) callback_executor.reset();
+    if (callback_executor && callback_executor->is_deferred()) {
+      // The waiters are notified by finish_callback() once the executor has
+      // run the callback. It can run before execute() returns.
+      is_callback_pending_ = true;
+      lock.unlock();
+      callback_executor->execute(this, callback, data);
+      lock.lock();
+      return;
+    }
     lock.unlock();
-    callback(CassFuture::to(this), data);
+    if (callback_executor) {
+      callback_executor->execute(this, callback, data);
+    } else {
+      on_callback_invoked();
+      callback(CassFuture::to(this), data);
+    }
+    lock.lock();
+  } else if (completion_queue_) {
+    // The queue holds a reference to the future until the completion is
+    // drained so don't keep a reference to the queue.
+    CompletionQueue::Ptr completion_queue(completion_queue_);
+    completion_queue_.reset();
+    lock.unlock();
+    completion_queue->post(this, completion_tag_);
     lock.lock();
   }
   // Broadcast after we've run the callback so that threads waiting
   // on this future see the side effects of the callback.
+  notify_waiters();
+}
+
+void Future::start_callback() {
+  ScopedMutex lock(&mutex_);
+  is_callback_running_ = true;
+  callback_thread_ = uv_thread_self();
+}
+
+void Future::finish_callback() {
+  ScopedMutex lock(&mutex_);
+  is_callback_pending_ = false;
+  is_callback_running_ = false;
+  notify_waiters();
+}
+
+bool Future::is_done() const {
+  if (!is_set_) return false;
+  if (!is_callback_pending_) return true;
+  if (!is_callback_running_) return false;
+  uv_thread_t self = uv_thread_self();
+  return uv_thread_equal(&self, &callback_thread_) != 0;
+}
+
+void Future::notify_waiters() {
   uv_cond_broadcast(&cond_);
+  for (Vector<FutureWaiter::Ptr>::const_iterator it = waiters_.begin(), end = waiters_.end();
+       it != end; ++it) {
+    (*it)->notify();
+  }
+  waiters_.clear();
 }
@@ -18,7 +18,9 @@
 #define DATASTAX_INTERNAL_FUTURE_HPP
 
 #include "atomic.hpp"
+#include "callback_executor.hpp"
 #include "cassandra.h"
+#include "completion_queue.hpp"
 #include "external.hpp"
 #include "host.hpp"
 #include "macros.hpp"
@@ -26,6 +28,7 @@
 #include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
 #include "string.hpp"
+#include "vector.hpp"
 
 #include <assert.h>
 #include <uv.h>
@@ -34,9 +37,52 @@ namespace datastax { namespace internal { namespace core {
 
 struct Error;
 
+/**
+ * A wait object shared by several futures. It's notified directly by the
+ * futures as they're set so that a thread waiting on many futures is only
+ * woken up once.
+ */
+class FutureWaiter : public RefCounted<FutureWaiter> {
+public:
+  typedef SharedRefPtr<FutureWaiter> Ptr;
+
+  /**
+   * @param count The number of notifications to wait for.
+   */
+  FutureWaiter(size_t count)
+      : remaining_(count) {
+    uv_mutex_init(&mutex_);
+    uv_cond_init(&cond_);
+  }
+
+  ~FutureWaiter() {
+    uv_mutex_destroy(&mutex_);
+    uv_cond_destroy(&cond_);
+  }
+
+  void notify();
+
+  /**
+   * Wait for the notifications or timeout.
+   *
+   * @param timeout_us The wait time in microseconds.
+   * @return false if returned due to timeout.
+   */
+  bool wait_for(uint64_t timeout_us);
+
+private:
+  uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  size_t remaining_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(FutureWaiter);
+};
+
 class Future : public RefCounted<Future> {
 public:
   typedef SharedRefPtr<Future> Ptr;
+  typedef Vector<Ptr> Vec;
   typedef void (*Callback)(CassFuture*, void*);
 
   enum Type { FUTURE_TYPE_GENERIC, FUTURE_TYPE_SESSION, FUTURE_TYPE_RESPONSE };
@@ -52,8 +98,13 @@ public:
 
   Future(Type type)
       : is_set_(false)
+      , is_callback_pending_(false)
+      , is_callback_running_(false)
       , type_(type)
-      , callback_(NULL) {
+      , callback_(NULL)
+      , is_application_callback_(false)
+      , has_completion_queue_(false)
+      , completion_tag_(NULL) {
     uv_mutex_init(&mutex_);
     uv_cond_init(&cond_);
   }
@@ -70,9 +121,13 @@ public:
     return is_set_;
   }
 
+  // Waiting on a future also waits for its callback when the callback is run
+  // by a callback executor so that the waiting thread sees its side effects.
   virtual void wait() {
     ScopedMutex lock(&mutex_);
-    internal_wait(lock);
+    while (!is_done()) {
+      uv_cond_wait(&cond_, lock.get());
+    }
   }
 
   virtual bool wait_for(uint64_t timeout_us) {
@@ -102,6 +157,59 @@ public:
 
   bool set_callback(Callback callback, void* data);
 
+  // Called right before the future's callback is run (on the thread running
+  // the callback)
+  virtual void on_callback_invoked() {}
+
+  // Set a callback on behalf of the application. It's run using the future's
+  // callback executor (if any) instead of directly on the thread that sets
+  // the future.
+  bool set_application_callback(Callback callback, void* data);
+
+  void set_callback_executor(const CallbackExecutor::Ptr& callback_executor) {
+    ScopedMutex lock(&mutex_);
+    if (!is_set_) callback_executor_ = callback_executor;
+  }
+
+  // The executor is released once the future is set
+  CallbackExecutor::Ptr callback_executor() {
+    ScopedMutex lock(&mutex_);
+    return callback_executor_;
+  }
+
+  // Called by the callback executor on the thread running a callback that
+  // was handed off. The callback is able to wait on its own future.
+  void start_callback();
+
+  // Called by the callback executor once a callback that was handed off has
+  // run (or is dropped). This notifies the threads waiting on the future.
+  void finish_callback();
+
+  // Post a completion to the queue when the future is set (instead of
+  // running a callback). Space must already be reserved in the queue.
+  bool set_completion_queue(const CompletionQueue::Ptr& completion_queue, void* tag);
+
+  /**
+   * Wait for all the futures to be set or timeout.
+   *
+   * @param futures
+   * @param count
+   * @param timeout_us The wait time in microseconds.
+   * @return false if returned due to timeout.
+   */
+  static bool wait_all(Future* const* futures, size_t count, uint64_t timeout_us);
+
+  /**
+   * Wait for any of the futures to be set or timeout.
+   *
+   * @param futures
+   * @param count
+   * @param timeout_us The wait time in microseconds.
+   * @param index The index of the first future that's set.
+   * @return false if returned due to timeout.
+   */
+  static bool wait_any(Future* const* futures, size_t count, uint64_t timeout_us, size_t* index);
+
 protected:
   bool is_set() const { return is_set_; }
 
@@ -112,16 +220,35 @@ protected:
   }
 
   bool internal_wait_for(ScopedMutex& lock, uint64_t timeout_us) {
-    if (!is_set_) {
+    if (!is_done()) {
       if (uv_cond_timedwait(&cond_, lock.get(), timeout_us * 1000) != 0) { // Expects nanos
         return false;
       }
     }
-    return is_set_;
+    return is_done();
+  }
+
+  // The future is set and its callback has run if it was handed off to a
+  // callback executor (must be called with the lock held).
+  bool is_done() const;
+
+  bool done() {
+    ScopedMutex lock(&mutex_);
+    return is_done();
   }
 
   void internal_set(ScopedMutex& lock);
 
+  // Must be called with the lock held
+  void notify_waiters();
+
+  bool internal_set_callback(Callback callback, void* data, bool is_application_callback);
+
+  // Notify the waiter when the future is done. Returns false if the future is
+  // already done.
+  bool add_waiter(const FutureWaiter::Ptr& waiter);
+  void remove_waiter(const FutureWaiter::Ptr& waiter);
+
   void internal_set_error(CassError code, const String& message, ScopedMutex& lock) {
     error_.reset(new Error(code, message));
     internal_set(lock);
@@ -131,11 +258,20 @@ protected:
 
 private:
   bool is_set_;
+  bool is_callback_pending_;
+  bool is_callback_running_;
+  uv_thread_t callback_thread_;
   uv_cond_t cond_;
   Type type_;
   ScopedPtr<Error> error_;
   Callback callback_;
   void* data_;
+  bool is_application_callback_;
+  CallbackExecutor::Ptr callback_executor_;
+  bool has_completion_queue_;
+  CompletionQueue::Ptr completion_queue_;
+  void* completion_tag_;
+  Vector<FutureWaiter::Ptr> waiters_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Future);
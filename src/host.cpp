@@ -20,6 +20,8 @@
 #include "row.hpp"
 #include "value.hpp"
 
+#include <algorithm>
+
 using namespace datastax;
 using namespace datastax::internal::core;
 
@@ -82,6 +84,117 @@ void Host::LatencyTracker::update(uint64_t latency_ns) {
   current_.timestamp = now;
 }
 
+// Latencies are tracked in microseconds up to a minute using two significant
+// digits. This is precise enough to rank hosts and keeps the per-thread
+// histograms small.
+#define LATENCY_HISTOGRAM_HIGHEST_TRACKABLE_VALUE (60LL * 1000LL * 1000LL)
+#define LATENCY_HISTOGRAM_SIGNIFICANT_FIGURES 2
+
+hdr_histogram* Host::create_latency_histogram() {
+  hdr_histogram* histogram;
+  hdr_init(1LL, LATENCY_HISTOGRAM_HIGHEST_TRACKABLE_VALUE, LATENCY_HISTOGRAM_SIGNIFICANT_FIGURES,
+           &histogram);
+  return histogram;
+}
+
+Host::LatencyHistogram::LatencyHistogram(double percentile, uint64_t window_ns)
+    : percentile_(percentile)
+    , window_ns_(window_ns)
+    , histogram_(create_latency_histogram())
+    , window_start_(uv_hrtime())
+    , percentile_ns_(-1)
+    , timestamp_(0)
+    , num_measured_(0) {}
+
+void Host::LatencyHistogram::merge(hdr_histogram* from) {
+  uint64_t now = uv_hrtime();
+
+  ScopedSpinlock l(SpinlockPool<LatencyHistogram>::get_spinlock(this));
+
+  hdr_add(histogram_, from);
+
+  if (now - window_start_ >= window_ns_) {
+    // Only publish windows with measurements so that the timestamp reflects
+    // the last time the host was used.
+    if (histogram_->total_count > 0) {
+      percentile_ns_.store(hdr_value_at_percentile(histogram_, percentile_) * 1000LL,
+                           MEMORY_ORDER_RELEASE);
+      num_measured_.store(histogram_->total_count, MEMORY_ORDER_RELEASE);
+      timestamp_.store(now, MEMORY_ORDER_RELEASE);
+      hdr_reset(histogram_);
+    }
+    window_start_ = now;
+  }
+}
+
+Host::OutlierDetector::OutlierDetector(const OutlierDetectionSettings& settings)
+    : settings_(settings)
+    , window_start_(uv_hrtime())
+    , window_requests_(0)
+    , window_failures_(0)
+    , consecutive_failures_(0)
+    , ejection_level_(0)
+    , ejected_until_(0)
+    , ejection_count_(0) {}
+
+bool Host::OutlierDetector::record(bool is_failure, uint64_t now) {
+  ScopedSpinlock l(SpinlockPool<OutlierDetector>::get_spinlock(this));
+
+  if (now - window_start_ >= settings_.interval_ns) {
+    // A full interval without failures after being re-admitted reduces the
+    // ejection time of the next ejection.
+    if (ejection_level_ > 0 && window_failures_ == 0 && !is_ejected(now)) {
+      ejection_level_--;
+    }
+    window_start_ = now;
+    window_requests_ = 0;
+    window_failures_ = 0;
+  }
+
+  window_requests_++;
+
+  if (!is_failure) {
+    consecutive_failures_ = 0;
+    return false;
+  }
+
+  window_failures_++;
+  consecutive_failures_++;
+
+  if (is_ejected(now)) {
+    return false;
+  }
+
+  if ((settings_.consecutive_failures > 0 &&
+       consecutive_failures_ >= settings_.consecutive_failures) ||
+      (settings_.failure_rate_threshold > 0.0 && window_requests_ >= settings_.min_requests &&
+       window_failures_ * 100.0 >= settings_.failure_rate_threshold * window_requests_)) {
+    eject(now);
+    return true;
+  }
+
+  return false;
+}
+
+void Host::OutlierDetector::eject(uint64_t now) {
+  uint64_t ejection_time_ns = settings_.base_ejection_time_ns;
+  for (unsigned i = 0; i < ejection_level_ && ejection_time_ns < settings_.max_ejection_time_ns;
+       ++i) {
+    ejection_time_ns *= 2;
+  }
+  ejection_time_ns = std::min(ejection_time_ns, settings_.max_ejection_time_ns);
+
+  ejected_until_.store(now + ejection_time_ns, MEMORY_ORDER_RELEASE);
+  ejection_count_.fetch_add(1, MEMORY_ORDER_RELAXED);
+  ejection_level_++;
+
+  // Start over once the host is re-admitted
+  consecutive_failures_ = 0;
+  window_start_ = now;
+  window_requests_ = 0;
+  window_failures_ = 0;
+}
+
 bool VersionNumber::parse(const String& version) {
   return sscanf(version.c_str(), "%d.%d.%d", &major_version_, &minor_version_, &patch_version_) >=
          2;
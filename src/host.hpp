@@ -25,13 +25,17 @@
 #include "logger.hpp"
 #include "macros.hpp"
 #include "map.hpp"
+#include "metrics.hpp"
 #include "ref_counted.hpp"
 #include "scoped_ptr.hpp"
 #include "spin_lock.hpp"
 #include "vector.hpp"
 
+#include "third_party/hdr_histogram/hdr_histogram.hpp"
+
 #include <math.h>
 #include <stdint.h>
+#include <stdlib.h>
 
 namespace datastax { namespace internal { namespace core {
 
@@ -48,6 +52,23 @@ struct TimestampedAverage {
   uint64_t num_measured;
 };
 
+struct OutlierDetectionSettings {
+  OutlierDetectionSettings()
+      : consecutive_failures(5)
+      , failure_rate_threshold(50.0)
+      , min_requests(20)
+      , interval_ns(10LL * 1000LL * 1000LL * 1000LL)
+      , base_ejection_time_ns(30LL * 1000LL * 1000LL * 1000LL)
+      , max_ejection_time_ns(300LL * 1000LL * 1000LL * 1000LL) {}
+
+  unsigned consecutive_failures;  // Disabled when 0
+  double failure_rate_threshold;  // Percentage of failed requests; disabled when 0.0
+  unsigned min_requests;          // Required per interval for the failure rate to be considered
+  uint64_t interval_ns;
+  uint64_t base_ejection_time_ns; // Doubled for each consecutive ejection
+  uint64_t max_ejection_time_ns;
+};
+
 class VersionNumber {
 public:
   VersionNumber()
@@ -161,6 +182,74 @@ public:
     return TimestampedAverage();
   }
 
+  void enable_latency_histogram(double percentile, uint64_t window_ns) {
+    if (!latency_histogram_) {
+      latency_histogram_.reset(new LatencyHistogram(percentile, window_ns));
+    }
+  }
+
+  /**
+   * Merge latencies (in microseconds) recorded by a single thread into the
+   * host's current latency window.
+   *
+   * @param from A histogram created using create_latency_histogram().
+   */
+  void merge_latencies(hdr_histogram* from) {
+    if (latency_histogram_) {
+      latency_histogram_->merge(from);
+    }
+  }
+
+  /**
+   * Get the latency percentile from the host's last complete latency window.
+   * This doesn't take a lock.
+   *
+   * @return The percentile in nanoseconds is returned in the "average" field
+   * and the number of latencies measured in the window in "num_measured".
+   */
+  TimestampedAverage get_current_percentile() const {
+    if (latency_histogram_) {
+      return latency_histogram_->get();
+    }
+    return TimestampedAverage();
+  }
+
+  static hdr_histogram* create_latency_histogram();
+
+  void enable_outlier_detection(const OutlierDetectionSettings& settings) {
+    if (!outlier_detector_) {
+      outlier_detector_.reset(new OutlierDetector(settings));
+    }
+  }
+
+  /**
+   * Record a successful execution (or a failure) for outlier detection.
+   *
+   * @param is_failure
+   * @param now The current time in nanoseconds.
+   * @return true if the host was ejected as a result of this execution.
+   */
+  bool record_execution(bool is_failure, uint64_t now) {
+    if (outlier_detector_) {
+      return outlier_detector_->record(is_failure, now);
+    }
+    return false;
+  }
+
+  bool is_ejected(uint64_t now) const {
+    if (outlier_detector_) {
+      return outlier_detector_->is_ejected(now);
+    }
+    return false;
+  }
+
+  uint64_t ejection_count() const {
+    if (outlier_detector_) {
+      return outlier_detector_->ejection_count();
+    }
+    return 0;
+  }
+
   void increment_connection_count() { connection_count_.fetch_add(1, MEMORY_ORDER_RELAXED); }
 
   void decrement_connection_count() { connection_count_.fetch_sub(1, MEMORY_ORDER_RELAXED); }
@@ -175,6 +264,12 @@ public:
     return inflight_request_count_.load(MEMORY_ORDER_RELAXED);
   }
 
+  // The session's request metrics for the host. This is set before the host
+  // is made available to the request processors so that requests don't need
+  // to look it up.
+  Metrics::HostMetrics* metrics() const { return metrics_.get(); }
+  void set_metrics(const Metrics::HostMetrics::Ptr& metrics) { metrics_ = metrics; }
+
 private:
   class LatencyTracker : public Allocated {
   public:
@@ -198,6 +293,63 @@ private:
     DISALLOW_COPY_AND_ASSIGN(LatencyTracker);
   };
 
+  class LatencyHistogram : public Allocated {
+  public:
+    LatencyHistogram(double percentile, uint64_t window_ns);
+    ~LatencyHistogram() { free(histogram_); }
+
+    void merge(hdr_histogram* from);
+
+    TimestampedAverage get() const {
+      TimestampedAverage result;
+      result.average = percentile_ns_.load(MEMORY_ORDER_ACQUIRE);
+      result.timestamp = timestamp_.load(MEMORY_ORDER_ACQUIRE);
+      result.num_measured = num_measured_.load(MEMORY_ORDER_ACQUIRE);
+      return result;
+    }
+
+  private:
+    const double percentile_;
+    const uint64_t window_ns_;
+    hdr_histogram* histogram_;
+    uint64_t window_start_;
+    Atomic<int64_t> percentile_ns_;
+    Atomic<uint64_t> timestamp_;
+    Atomic<uint64_t> num_measured_;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(LatencyHistogram);
+  };
+
+  class OutlierDetector : public Allocated {
+  public:
+    OutlierDetector(const OutlierDetectionSettings& settings);
+
+    bool record(bool is_failure, uint64_t now);
+
+    bool is_ejected(uint64_t now) const {
+      return now < ejected_until_.load(MEMORY_ORDER_ACQUIRE);
+    }
+
+    uint64_t ejection_count() const { return ejection_count_.load(MEMORY_ORDER_RELAXED); }
+
+  private:
+    void eject(uint64_t now);
+
+  private:
+    const OutlierDetectionSettings settings_;
+    uint64_t window_start_;
+    unsigned window_requests_;
+    unsigned window_failures_;
+    unsigned consecutive_failures_;
+    unsigned ejection_level_;
+    Atomic<uint64_t> ejected_until_;
+    Atomic<uint64_t> ejection_count_;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(OutlierDetector);
+  };
+
 private:
   Address address_;
   Address rpc_address_;
@@ -212,8 +364,11 @@ private:
   Vector<String> tokens_;
   Atomic<int32_t> connection_count_;
   Atomic<int32_t> inflight_request_count_;
+  Metrics::HostMetrics::Ptr metrics_;
 
   ScopedPtr<LatencyTracker> latency_tracker_;
+  ScopedPtr<LatencyHistogram> latency_histogram_;
+  ScopedPtr<OutlierDetector> outlier_detector_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Host);
@@ -26,12 +26,22 @@ using namespace datastax;
 using namespace datastax::internal;
 using namespace datastax::internal::core;
 
+LatencyAwarePolicy::~LatencyAwarePolicy() {
+  for (ThreadHistogramMap::iterator i = histograms_.begin(), end = histograms_.end(); i != end;
+       ++i) {
+    free(i->second.histogram);
+  }
+}
+
 void LatencyAwarePolicy::init(const Host::Ptr& connected_host, const HostMap& hosts, Random* random,
                               const String& local_dc) {
   hosts_->reserve(hosts.size());
   std::transform(hosts.begin(), hosts.end(), std::back_inserter(*hosts_), GetHost());
   for (HostMap::const_iterator i = hosts.begin(), end = hosts.end(); i != end; ++i) {
     i->second->enable_latency_tracking(settings_.scale_ns, settings_.min_measured);
+    if (settings_.percentile > 0.0) {
+      i->second->enable_latency_histogram(settings_.percentile, settings_.window_ns);
+    }
   }
   ChainedLoadBalancingPolicy::init(connected_host, hosts, random, local_dc);
 }
@@ -49,27 +59,72 @@ QueryPlan* LatencyAwarePolicy::new_query_plan(const String& keyspace,
 
 void LatencyAwarePolicy::on_host_added(const Host::Ptr& host) {
   host->enable_latency_tracking(settings_.scale_ns, settings_.min_measured);
+  if (settings_.percentile > 0.0) {
+    host->enable_latency_histogram(settings_.percentile, settings_.window_ns);
+  }
   add_host(hosts_, host);
   ChainedLoadBalancingPolicy::on_host_added(host);
 }
 
 void LatencyAwarePolicy::on_host_removed(const Host::Ptr& host) {
   remove_host(hosts_, host);
+  ThreadHistogramMap::iterator it = histograms_.find(host->address());
+  if (it != histograms_.end()) {
+    free(it->second.histogram);
+    histograms_.erase(it);
+  }
   ChainedLoadBalancingPolicy::on_host_removed(host);
 }
 
+void LatencyAwarePolicy::record_latency(const Host::Ptr& host, uint64_t latency_ns) {
+  if (settings_.percentile <= 0.0) return;
+
+  ThreadHistogram& entry = histograms_[host->address()];
+  if (!entry.histogram) {
+    entry.host = host;
+    entry.histogram = Host::create_latency_histogram();
+  }
+
+  // Final measurement is in microseconds
+  int64_t latency_us = static_cast<int64_t>(latency_ns / 1000);
+  if (!hdr_record_value(entry.histogram, latency_us)) {
+    // The value exceeds the highest trackable value
+    hdr_record_value(entry.histogram, entry.histogram->highest_trackable_value);
+  }
+}
+
+void LatencyAwarePolicy::merge_latencies() {
+  for (ThreadHistogramMap::iterator i = histograms_.begin(), end = histograms_.end(); i != end;
+       ++i) {
+    ThreadHistogram& entry = i->second;
+    if (entry.histogram->total_count > 0) {
+      entry.host->merge_latencies(entry.histogram);
+      hdr_reset(entry.histogram);
+    }
+  }
+}
+
+TimestampedAverage LatencyAwarePolicy::get_latency(const Host::Ptr& host) const {
+  return settings_.percentile > 0.0 ? host->get_current_percentile()
+                                    : host->get_current_average();
+}
+
 void LatencyAwarePolicy::start_timer(uv_loop_t* loop) {
   timer_.start(loop, settings_.update_rate_ms, bind_callback(&LatencyAwarePolicy::on_timer, this));
 }
 
 void LatencyAwarePolicy::on_timer(Timer* timer) {
+  if (settings_.percentile > 0.0) {
+    merge_latencies();
+  }
+
   const CopyOnWriteHostVec& hosts(hosts_);
 
   int64_t new_min_average = CASS_INT64_MAX;
   int64_t now = uv_hrtime();
 
   for (HostVec::const_iterator i = hosts->begin(), end = hosts->end(); i != end; ++i) {
-    TimestampedAverage latency = (*i)->get_current_average();
+    TimestampedAverage latency = get_latency(*i);
     if (latency.average >= 0 && latency.num_measured >= settings_.min_measured &&
         (now - latency.timestamp) <= settings_.retry_period_ns) {
       new_min_average = std::min(new_min_average, latency.average);
@@ -91,7 +146,7 @@ Host::Ptr LatencyAwarePolicy::LatencyAwareQueryPlan::compute_next() {
 
   Host::Ptr host;
   while ((host = child_plan_->compute_next())) {
-    TimestampedAverage latency = host->get_current_average();
+    TimestampedAverage latency = policy_->get_latency(host);
 
     if (min < 0 || latency.average < 0 || latency.num_measured < settings.min_measured ||
         (now - latency.timestamp) > settings.retry_period_ns) {
@@ -18,6 +18,7 @@
 #define DATASTAX_INTERNAL_LATENCY_AWARE_POLICY_HPP
 
 #include "atomic.hpp"
+#include "dense_hash_map.hpp"
 #include "load_balancing.hpp"
 #include "macros.hpp"
 #include "scoped_ptr.hpp"
@@ -33,13 +34,17 @@ public:
         , scale_ns(100LL * 1000LL * 1000LL)
         , retry_period_ns(10LL * 1000LL * 1000LL * 1000LL)
         , update_rate_ms(100LL)
-        , min_measured(50LL) {}
+        , min_measured(50LL)
+        , percentile(0.0)
+        , window_ns(1000LL * 1000LL * 1000LL) {}
 
     double exclusion_threshold;
     uint64_t scale_ns;
     uint64_t retry_period_ns;
     uint64_t update_rate_ms;
     uint64_t min_measured;
+    double percentile; // Use the moving average when not set (0.0)
+    uint64_t window_ns;
   };
 
   LatencyAwarePolicy(LoadBalancingPolicy* child_policy, const Settings& settings)
@@ -48,7 +53,7 @@ public:
       , settings_(settings)
       , hosts_(new HostVec()) {}
 
-  virtual ~LatencyAwarePolicy() {}
+  virtual ~LatencyAwarePolicy();
 
   virtual void init(const Host::Ptr& connected_host, const HostMap& hosts, Random* random,
                     const String& local_dc);
@@ -66,12 +71,24 @@ public:
   virtual void on_host_added(const Host::Ptr& host);
   virtual void on_host_removed(const Host::Ptr& host);
 
+  /**
+   * Record a latency for a host. When ranking hosts by a percentile, the
+   * latency is recorded into a histogram that is only used by the current
+   * thread and periodically merged into the host's latency window.
+   *
+   * @param host
+   * @param latency_ns
+   */
+  void record_latency(const Host::Ptr& host, uint64_t latency_ns);
+
 public:
   // Testing only
   int64_t min_average() const { return min_average_.load(); }
+  void merge_latencies();
 
 private:
   void start_timer(uv_loop_t* loop);
+  TimestampedAverage get_latency(const Host::Ptr& host) const;
 
 private:
   class LatencyAwareQueryPlan : public QueryPlan {
@@ -83,6 +100,15 @@ private:
 
     Host::Ptr compute_next();
 
+    virtual void on_execution_latency(const Host::Ptr& host, uint64_t latency_ns) {
+      policy_->record_latency(host, latency_ns);
+      child_plan_->on_execution_latency(host, latency_ns);
+    }
+
+    virtual void on_execution_error(const Host::Ptr& host, CassError code) {
+      child_plan_->on_execution_error(host, code);
+    }
+
   private:
     LatencyAwarePolicy* policy_;
     ScopedPtr<QueryPlan> child_plan_;
@@ -91,12 +117,29 @@ private:
     size_t skipped_index_;
   };
 
+  struct ThreadHistogram {
+    ThreadHistogram()
+        : histogram(NULL) {}
+
+    Host::Ptr host;
+    hdr_histogram* histogram;
+  };
+
+  class ThreadHistogramMap : public DenseHashMap<Address, ThreadHistogram> {
+  public:
+    ThreadHistogramMap() {
+      set_empty_key(Address::EMPTY_KEY);
+      set_deleted_key(Address::DELETED_KEY);
+    }
+  };
+
   void on_timer(Timer* timer);
 
   Atomic<int64_t> min_average_;
   Timer timer_;
   Settings settings_;
   CopyOnWriteHostVec hosts_;
+  ThreadHistogramMap histograms_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(LatencyAwarePolicy);
@@ -61,11 +61,33 @@ inline bool is_dc_local(CassConsistency cl) {
   return cl == CASS_CONSISTENCY_LOCAL_ONE || cl == CASS_CONSISTENCY_LOCAL_QUORUM;
 }
 
+inline bool is_serial(CassConsistency cl) {
+  return cl == CASS_CONSISTENCY_SERIAL || cl == CASS_CONSISTENCY_LOCAL_SERIAL;
+}
+
 class QueryPlan : public Allocated {
 public:
   virtual ~QueryPlan() {}
   virtual Host::Ptr compute_next() = 0;
 
+  /**
+   * Called when an execution of a request using this plan receives a result
+   * response.
+   *
+   * @param host The host that returned the response.
+   * @param latency_ns The latency of the execution in nanoseconds.
+   */
+  virtual void on_execution_latency(const Host::Ptr& host, uint64_t latency_ns) {}
+
+  /**
+   * Called when an execution of a request using this plan fails with an error
+   * response or times out.
+   *
+   * @param host The host that the execution was sent to.
+   * @param code The error code for the failure.
+   */
+  virtual void on_execution_error(const Host::Ptr& host, CassError code) {}
+
   bool compute_next(Address* address) {
     Host::Ptr host = compute_next();
     if (host) {
@@ -94,6 +116,15 @@ public:
 
   virtual CassHostDistance distance(const Host::Ptr& host) const = 0;
 
+  /**
+   * Determine if a host is in the policy's local rack (rack-aware policies
+   * only).
+   *
+   * @param host
+   * @return true if the host is in the local rack of the local data center.
+   */
+  virtual bool is_local_rack(const Host::Ptr& host) const { return false; }
+
   virtual bool is_host_up(const Address& address) const = 0;
   virtual void on_host_added(const Host::Ptr& host) = 0;
   virtual void on_host_removed(const Host::Ptr& host) = 0;
@@ -138,6 +169,10 @@ public:
     return child_policy_->is_host_up(address);
   }
 
+  virtual bool is_local_rack(const Host::Ptr& host) const {
+    return child_policy_->is_local_rack(host);
+  }
+
   virtual void on_host_added(const Host::Ptr& host) { child_policy_->on_host_added(host); }
   virtual void on_host_removed(const Host::Ptr& host) { child_policy_->on_host_removed(host); }
   virtual void on_host_up(const Host::Ptr& host) { child_policy_->on_host_up(host); }
@@ -20,12 +20,19 @@
 #ifndef DATASTAX_INTERNAL_METRICS_HPP
 #define DATASTAX_INTERNAL_METRICS_HPP
 
+#include "address.hpp"
 #include "allocated.hpp"
 #include "atomic.hpp"
 #include "constants.hpp"
+#include "map.hpp"
+#include "ref_counted.hpp"
+#include "request_timings.hpp"
 #include "scoped_lock.hpp"
 #include "scoped_ptr.hpp"
+#include "statement_metrics.hpp"
+#include "string.hpp"
 #include "utils.hpp"
+#include "vector.hpp"
 
 #include "third_party/hdr_histogram/hdr_histogram.hpp"
 
@@ -256,6 +263,7 @@ public:
     static const int64_t HIGHEST_TRACKABLE_VALUE = 3600LL * 1000LL * 1000LL;
 
     struct Snapshot {
+      int64_t count;
       int64_t min;
       int64_t max;
       int64_t mean;
@@ -268,29 +276,162 @@ public:
       int64_t percentile_999th;
     };
 
-    Histogram(ThreadState* thread_state)
+    // Sliding windows of recent values (in minutes)
+    enum Window { WINDOW_ONE_MINUTE = 1, WINDOW_FIVE_MINUTES = 5, WINDOW_FIFTEEN_MINUTES = 15 };
+
+    // The windows are made of buckets that are recorded with a lower precision
+    // to bound the memory used by the windows.
+    static const uint64_t WINDOW_BUCKET_INTERVAL_NS = 15LL * 1000LL * 1000LL * 1000LL;
+    static const size_t WINDOW_BUCKETS_PER_MINUTE = 4;
+    static const size_t WINDOW_BUCKET_COUNT = WINDOW_FIFTEEN_MINUTES * WINDOW_BUCKETS_PER_MINUTE;
+    static const int WINDOW_SIGNIFICANT_FIGURES = 2;
+
+    Histogram(ThreadState* thread_state, int significant_figures = 3, bool is_windowed = false)
         : thread_state_(thread_state)
-        , histograms_(new PerThreadHistogram[thread_state->max_threads()]) {
-      hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histogram_);
+        , histograms_(new PerThreadHistogram[thread_state->max_threads()])
+        , interval_(NULL)
+        , window_(NULL)
+        , current_bucket_(0)
+        , bucket_start_ns_(uv_hrtime()) {
+      for (size_t i = 0; i < thread_state->max_threads(); ++i) {
+        histograms_[i].init(significant_figures);
+      }
+      hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, significant_figures, &histogram_);
+      if (is_windowed) {
+        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, significant_figures, &interval_);
+        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, WINDOW_SIGNIFICANT_FIGURES, &window_);
+        buckets_.reset(new hdr_histogram*[WINDOW_BUCKET_COUNT]);
+        for (size_t i = 0; i < WINDOW_BUCKET_COUNT; ++i) {
+          hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, WINDOW_SIGNIFICANT_FIGURES, &buckets_[i]);
+        }
+      }
       uv_mutex_init(&mutex_);
     }
 
     ~Histogram() {
       free(histogram_);
+      free(interval_);
+      free(window_);
+      if (buckets_) {
+        for (size_t i = 0; i < WINDOW_BUCKET_COUNT; ++i) {
+          free(buckets_[i]);
+        }
+      }
       uv_mutex_destroy(&mutex_);
     }
 
+    bool is_windowed() const { return interval_ != NULL; }
+
     void record_value(int64_t value) {
+      if (is_windowed()) {
+        record_value(value, uv_hrtime());
+      } else {
+        histograms_[thread_state_->current_thread_id()].record_value(value);
+      }
+    }
+
+    /**
+     * Record a value at a given time. The windows are rotated before the value
+     * is recorded so that a value recorded after an idle period ends up in the
+     * current bucket.
+     *
+     * @param value The value.
+     * @param now The current time in nanoseconds.
+     */
+    void record_value(int64_t value, uint64_t now) {
+      if (is_windowed()) {
+        rotate_windows_if_necessary(now);
+      }
       histograms_[thread_state_->current_thread_id()].record_value(value);
     }
 
+    /**
+     * Move the values recorded by the threads into the windows when the
+     * current bucket has ended. This is done by a writer so that the values
+     * end up in the right bucket even when snapshots are rarely taken.
+     *
+     * @param now The current time in nanoseconds.
+     */
+    void rotate_windows_if_necessary(uint64_t now) {
+      uint64_t bucket_start_ns = bucket_start_ns_.load(MEMORY_ORDER_RELAXED);
+      if (now < bucket_start_ns || now - bucket_start_ns < WINDOW_BUCKET_INTERVAL_NS) {
+        return;
+      }
+      // Skip if a reader is already holding the lock (it also rotates the windows)
+      if (uv_mutex_trylock(&mutex_) != 0) return;
+      harvest(now);
+      uv_mutex_unlock(&mutex_);
+    }
+
+    /**
+     * Get a snapshot of all the values recorded since the histogram was
+     * created.
+     */
     void get_snapshot(Snapshot* snapshot) const {
       ScopedMutex l(&mutex_);
-      hdr_histogram* h = histogram_;
+      harvest(uv_hrtime());
+      fill_snapshot(histogram_, snapshot);
+    }
+
+    /**
+     * Get a snapshot of the values recorded during a recent window of time.
+     * The window includes the current bucket so it covers up to
+     * `WINDOW_BUCKET_INTERVAL_NS` less than the window's length. Only valid for
+     * windowed histograms.
+     *
+     * @param window The window.
+     * @param snapshot The snapshot of the window.
+     * @param now The current time in nanoseconds.
+     */
+    void get_window_snapshot(Window window, Snapshot* snapshot, uint64_t now = uv_hrtime()) const {
+      assert(is_windowed() && "Histogram doesn't have windows");
+      ScopedMutex l(&mutex_);
+      harvest(now);
+      hdr_reset(window_);
+      size_t count = static_cast<size_t>(window) * WINDOW_BUCKETS_PER_MINUTE;
+      for (size_t i = 0; i < count; ++i) {
+        size_t index = (current_bucket_ + WINDOW_BUCKET_COUNT - i) % WINDOW_BUCKET_COUNT;
+        hdr_add(window_, buckets_[index]);
+      }
+      fill_snapshot(window_, snapshot);
+    }
+
+  private:
+    // Must be called with the mutex held
+    void harvest(uint64_t now) const {
+      if (!is_windowed()) {
+        for (size_t i = 0; i < thread_state_->max_threads(); ++i) {
+          histograms_[i].add(histogram_);
+        }
+        return;
+      }
+
       for (size_t i = 0; i < thread_state_->max_threads(); ++i) {
-        histograms_[i].add(h);
+        histograms_[i].add(interval_);
       }
+      hdr_add(histogram_, interval_);
+
+      // The values were recorded during the current bucket (writers rotate
+      // the buckets before recording a value after the bucket has ended)
+      hdr_add(buckets_[current_bucket_], interval_);
+      hdr_reset(interval_);
+
+      // Another thread could have already rotated the buckets using a later time
+      uint64_t bucket_start_ns = bucket_start_ns_.load(MEMORY_ORDER_RELAXED);
+      uint64_t elapsed =
+          now > bucket_start_ns ? (now - bucket_start_ns) / WINDOW_BUCKET_INTERVAL_NS : 0;
+      if (elapsed > 0) {
+        for (uint64_t i = 0; i < elapsed && i < WINDOW_BUCKET_COUNT; ++i) {
+          current_bucket_ = (current_bucket_ + 1) % WINDOW_BUCKET_COUNT;
+          hdr_reset(buckets_[current_bucket_]);
+        }
+        bucket_start_ns_.store(bucket_start_ns + elapsed * WINDOW_BUCKET_INTERVAL_NS,
+                               MEMORY_ORDER_RELAXED);
+      }
+    }
 
+    static void fill_snapshot(hdr_histogram* h, Snapshot* snapshot) {
+      snapshot->count = h->total_count;
       if (h->total_count == 0) {
         // There is no data; default to 0 for the stats.
         snapshot->max = 0;
@@ -374,8 +515,12 @@ public:
     public:
       PerThreadHistogram()
           : active_index_(0) {
-        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histograms_[0]);
-        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histograms_[1]);
+        histograms_[0] = histograms_[1] = NULL;
+      }
+
+      void init(int significant_figures) {
+        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, significant_figures, &histograms_[0]);
+        hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, significant_figures, &histograms_[1]);
       }
 
       ~PerThreadHistogram() {
@@ -407,20 +552,172 @@ public:
     ThreadState* thread_state_;
     ScopedArray<PerThreadHistogram> histograms_;
     hdr_histogram* histogram_;
+    hdr_histogram* interval_; // The values moved from the threads (windowed histograms only)
+    hdr_histogram* window_;   // The sum of the window's buckets (windowed histograms only)
+    ScopedArray<hdr_histogram*> buckets_;
+    mutable size_t current_bucket_;
+    mutable Atomic<uint64_t> bucket_start_ns_;
     mutable uv_mutex_t mutex_;
 
   private:
     DISALLOW_COPY_AND_ASSIGN(Histogram);
   };
 
-  Metrics(size_t max_threads)
+  /**
+   * Request metrics for a single host or for all the hosts of a data center.
+   * The latencies are recorded with a lower precision than the session-wide
+   * histograms to bound the memory used for each host.
+   */
+  class RequestMetrics : public RefCounted<RequestMetrics> {
+  public:
+    typedef SharedRefPtr<RequestMetrics> Ptr;
+
+    static const int SIGNIFICANT_FIGURES = 2;
+
+    RequestMetrics(ThreadState* thread_state)
+        : latencies(thread_state, SIGNIFICANT_FIGURES)
+        , errors(thread_state)
+        , timeouts(thread_state)
+        , in_flight(thread_state)
+        , speculative_wins(thread_state) {}
+
+    Histogram latencies;
+    Counter errors;
+    Counter timeouts;
+    Counter in_flight;
+    Counter speculative_wins;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(RequestMetrics);
+  };
+
+  /**
+   * The metrics of a host. Everything recorded for the host is also recorded
+   * for the host's data center. These are only updated on the I/O threads.
+   */
+  class HostMetrics : public RefCounted<HostMetrics> {
+  public:
+    typedef SharedRefPtr<HostMetrics> Ptr;
+    typedef Vector<Ptr> Vec;
+
+    HostMetrics(const Address& address, const String& dc, const RequestMetrics::Ptr& dc_metrics,
+                ThreadState* thread_state)
+        : address_(address)
+        , dc_(dc)
+        , host_metrics_(new RequestMetrics(thread_state))
+        , dc_metrics_(dc_metrics) {}
+
+    const Address& address() const { return address_; }
+    const String& dc() const { return dc_; }
+    const RequestMetrics& host_metrics() const { return *host_metrics_; }
+
+    void start_request() {
+      host_metrics_->in_flight.inc();
+      dc_metrics_->in_flight.inc();
+    }
+
+    void finish_request() {
+      host_metrics_->in_flight.dec();
+      dc_metrics_->in_flight.dec();
+    }
+
+    void record_latency(uint64_t latency_ns) {
+      // Final measurement is in microseconds
+      host_metrics_->latencies.record_value(latency_ns / 1000);
+      dc_metrics_->latencies.record_value(latency_ns / 1000);
+    }
+
+    void record_error() {
+      host_metrics_->errors.inc();
+      dc_metrics_->errors.inc();
+    }
+
+    void record_timeout() {
+      host_metrics_->timeouts.inc();
+      dc_metrics_->timeouts.inc();
+    }
+
+    void record_speculative_win() {
+      host_metrics_->speculative_wins.inc();
+      dc_metrics_->speculative_wins.inc();
+    }
+
+  private:
+    const Address address_;
+    const String dc_;
+    RequestMetrics::Ptr host_metrics_;
+    RequestMetrics::Ptr dc_metrics_;
+  };
+
+  typedef Map<String, RequestMetrics::Ptr> DcMetricsMap;
+
+  /**
+   * The latencies between the stages of the requests' lifecycles. Each stage
+   * is measured from the end of the previous stage so they tell whether time
+   * is spent waiting in the driver's queues, on the I/O threads or on the
+   * server. The connection stage is only recorded for requests whose first
+   * execution was used because it would include the speculative execution
+   * delay or the earlier attempts.
+   */
+  class RequestStageMetrics : public Allocated {
+  public:
+    RequestStageMetrics(ThreadState* thread_state)
+        : queue(thread_state)
+        , plan(thread_state)
+        , connection(thread_state)
+        , write(thread_state)
+        , server(thread_state)
+        , decode(thread_state) {}
+
+    void record(const RequestTimings& timings) {
+      record_stage(&queue, timings, RequestTimings::STAGE_DEQUEUED);
+      record_stage(&plan, timings, RequestTimings::STAGE_PLAN_BUILT);
+      if (timings.is_first_attempt) {
+        record_stage(&connection, timings, RequestTimings::STAGE_WRITE_QUEUED);
+      }
+      record_stage(&write, timings, RequestTimings::STAGE_WRITE_FLUSHED);
+      record_stage(&server, timings, RequestTimings::STAGE_RESPONSE_RECEIVED);
+      record_stage(&decode, timings, RequestTimings::STAGE_RESPONSE_DECODED);
+    }
+
+    Histogram queue;      // Enqueued to dequeued
+    Histogram plan;       // Dequeued to query plan built
+    Histogram connection; // Query plan built to written to a connection
+    Histogram write;      // Written to a connection to flushed by the socket
+    Histogram server;     // Flushed to the first bytes of the response read
+    Histogram decode;     // First bytes of the response read to decoded
+
+  private:
+    static void record_stage(Histogram* histogram, const RequestTimings& timings,
+                             RequestTimings::Stage stage) {
+      uint64_t start = timings.times[stage - 1];
+      uint64_t end = timings.times[stage];
+      // A response can be read before the socket write callback runs
+      if (start == 0 || end < start) return;
+      // Final measurement is in microseconds
+      histogram->record_value((end - start) / 1000);
+    }
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(RequestStageMetrics);
+  };
+
+  Metrics(size_t max_threads, size_t max_statements = 0, bool record_request_stages = false)
       : thread_state_(max_threads)
-      , request_latencies(&thread_state_)
+      , request_latencies(&thread_state_, 3, true)
       , speculative_request_latencies(&thread_state_)
       , request_rates(&thread_state_)
       , total_connections(&thread_state_)
       , connection_timeouts(&thread_state_)
-      , request_timeouts(&thread_state_) {}
+      , request_timeouts(&thread_state_)
+      , statement_metrics(max_statements) {
+    uv_rwlock_init(&host_metrics_rwlock_);
+    if (record_request_stages) {
+      request_stages.reset(new RequestStageMetrics(&thread_state_));
+    }
+  }
+
+  ~Metrics() { uv_rwlock_destroy(&host_metrics_rwlock_); }
 
   void record_request(uint64_t latency_ns) {
     // Final measurement is in microseconds
@@ -434,8 +731,75 @@ public:
     request_rates.mark_speculative();
   }
 
+  /**
+   * Get (or create) the metrics for a host. This takes a lock so the result
+   * should be kept by the caller (e.g. on the host) instead of being looked up
+   * for each request.
+   *
+   * @param address The address of the host.
+   * @param dc The host's data center.
+   * @return The host's metrics.
+   */
+  HostMetrics::Ptr host_metrics(const Address& address, const String& dc) {
+    uv_rwlock_rdlock(&host_metrics_rwlock_);
+    HostMetricsMap::const_iterator it = host_metrics_.find(address);
+    if (it != host_metrics_.end()) {
+      HostMetrics::Ptr metrics(it->second);
+      uv_rwlock_rdunlock(&host_metrics_rwlock_);
+      return metrics;
+    }
+    uv_rwlock_rdunlock(&host_metrics_rwlock_);
+
+    uv_rwlock_wrlock(&host_metrics_rwlock_);
+    HostMetrics::Ptr& metrics = host_metrics_[address];
+    if (!metrics) {
+      RequestMetrics::Ptr& dc_metrics = dc_metrics_[dc];
+      if (!dc_metrics) {
+        dc_metrics.reset(new RequestMetrics(&thread_state_));
+      }
+      metrics.reset(new HostMetrics(address, dc, dc_metrics, &thread_state_));
+    }
+    HostMetrics::Ptr result(metrics);
+    uv_rwlock_wrunlock(&host_metrics_rwlock_);
+    return result;
+  }
+
+  /**
+   * Remove the metrics of a host that was removed from the cluster. Requests
+   * that are still in flight keep recording into the host's metrics (and its
+   * data center's) until they finish.
+   *
+   * @param address The address of the host.
+   */
+  void remove_host_metrics(const Address& address) {
+    uv_rwlock_wrlock(&host_metrics_rwlock_);
+    host_metrics_.erase(address);
+    uv_rwlock_wrunlock(&host_metrics_rwlock_);
+  }
+
+  void all_host_metrics(HostMetrics::Vec* output) const {
+    uv_rwlock_rdlock(&host_metrics_rwlock_);
+    output->reserve(host_metrics_.size());
+    for (HostMetricsMap::const_iterator it = host_metrics_.begin(), end = host_metrics_.end();
+         it != end; ++it) {
+      output->push_back(it->second);
+    }
+    uv_rwlock_rdunlock(&host_metrics_rwlock_);
+  }
+
+  void all_dc_metrics(DcMetricsMap* output) const {
+    uv_rwlock_rdlock(&host_metrics_rwlock_);
+    *output = dc_metrics_;
+    uv_rwlock_rdunlock(&host_metrics_rwlock_);
+  }
+
 private:
+  typedef Map<Address, HostMetrics::Ptr> HostMetricsMap;
+
   ThreadState thread_state_;
+  HostMetricsMap host_metrics_;
+  DcMetricsMap dc_metrics_;
+  mutable uv_rwlock_t host_metrics_rwlock_;
 
 public:
   Histogram request_latencies;
@@ -447,6 +811,10 @@ public:
   Counter connection_timeouts;
   Counter request_timeouts;
 
+  StatementMetrics statement_metrics;
+
+  ScopedPtr<RequestStageMetrics> request_stages; // NULL unless request timings are enabled
+
 private:
   DISALLOW_COPY_AND_ASSIGN(Metrics);
 };
@@ -0,0 +1,92 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "outlier_detection_policy.hpp"
+
+#include "logger.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+void OutlierDetectionPolicy::init(const Host::Ptr& connected_host, const HostMap& hosts,
+                                  Random* random, const String& local_dc) {
+  for (HostMap::const_iterator i = hosts.begin(), end = hosts.end(); i != end; ++i) {
+    i->second->enable_outlier_detection(settings_);
+  }
+  ChainedLoadBalancingPolicy::init(connected_host, hosts, random, local_dc);
+}
+
+QueryPlan* OutlierDetectionPolicy::new_query_plan(const String& keyspace,
+                                                  RequestHandler* request_handler,
+                                                  const TokenMap* token_map) {
+  return new OutlierDetectionQueryPlan(
+      child_policy_->new_query_plan(keyspace, request_handler, token_map));
+}
+
+void OutlierDetectionPolicy::on_host_added(const Host::Ptr& host) {
+  host->enable_outlier_detection(settings_);
+  ChainedLoadBalancingPolicy::on_host_added(host);
+}
+
+bool OutlierDetectionPolicy::is_failure(CassError code) {
+  switch (code) {
+    case CASS_ERROR_SERVER_SERVER_ERROR:
+    case CASS_ERROR_SERVER_OVERLOADED:
+    case CASS_ERROR_SERVER_WRITE_TIMEOUT:
+    case CASS_ERROR_SERVER_READ_TIMEOUT:
+    case CASS_ERROR_SERVER_READ_FAILURE:
+    case CASS_ERROR_SERVER_WRITE_FAILURE:
+    case CASS_ERROR_LIB_REQUEST_TIMED_OUT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+Host::Ptr OutlierDetectionPolicy::OutlierDetectionQueryPlan::compute_next() {
+  uint64_t now = uv_hrtime();
+
+  Host::Ptr host;
+  while ((host = child_plan_->compute_next())) {
+    if (!host->is_ejected(now)) {
+      return host;
+    }
+    // Ejected hosts are only used after all other hosts have been tried
+    skipped_.push_back(host);
+  }
+
+  if (skipped_index_ < skipped_.size()) {
+    return skipped_[skipped_index_++];
+  }
+
+  return Host::Ptr();
+}
+
+void OutlierDetectionPolicy::OutlierDetectionQueryPlan::on_execution_latency(
+    const Host::Ptr& host, uint64_t latency_ns) {
+  host->record_execution(false, uv_hrtime());
+  child_plan_->on_execution_latency(host, latency_ns);
+}
+
+void OutlierDetectionPolicy::OutlierDetectionQueryPlan::on_execution_error(const Host::Ptr& host,
+                                                                           CassError code) {
+  if (is_failure(code) && host->record_execution(true, uv_hrtime())) {
+    LOG_WARN("Host %s ejected by outlier detection after too many failures (%u ejections)",
+             host->address_string().c_str(), static_cast<unsigned>(host->ejection_count()));
+  }
+  child_plan_->on_execution_error(host, code);
+}
@@ -0,0 +1,93 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_OUTLIER_DETECTION_POLICY_HPP
+#define DATASTAX_INTERNAL_OUTLIER_DETECTION_POLICY_HPP
+
+#include "load_balancing.hpp"
+#include "macros.hpp"
+#include "scoped_ptr.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A policy that tracks overloaded errors, timeouts and read/write failures
+ * per host and temporarily ejects hosts with too many failures. Ejected hosts
+ * are moved to the end of the child policy's query plan until they're
+ * re-admitted. Each consecutive ejection doubles the ejection time (up to a
+ * maximum).
+ *
+ * The ejection state is kept on the host so that it's shared by all the
+ * instances of the policy.
+ */
+class OutlierDetectionPolicy : public ChainedLoadBalancingPolicy {
+public:
+  typedef OutlierDetectionSettings Settings;
+
+  OutlierDetectionPolicy(LoadBalancingPolicy* child_policy, const Settings& settings)
+      : ChainedLoadBalancingPolicy(child_policy)
+      , settings_(settings) {}
+
+  virtual ~OutlierDetectionPolicy() {}
+
+  virtual void init(const Host::Ptr& connected_host, const HostMap& hosts, Random* random,
+                    const String& local_dc);
+
+  virtual QueryPlan* new_query_plan(const String& keyspace, RequestHandler* request_handler,
+                                    const TokenMap* token_map);
+
+  virtual LoadBalancingPolicy* new_instance() {
+    return new OutlierDetectionPolicy(child_policy_->new_instance(), settings_);
+  }
+
+  virtual void on_host_added(const Host::Ptr& host);
+
+  /**
+   * Determine if an error should be counted as a failure for a host.
+   *
+   * @param code The error code of a failed execution.
+   * @return true if the error is caused by the host being overloaded or slow.
+   */
+  static bool is_failure(CassError code);
+
+private:
+  class OutlierDetectionQueryPlan : public QueryPlan {
+  public:
+    OutlierDetectionQueryPlan(QueryPlan* child_plan)
+        : child_plan_(child_plan)
+        , skipped_index_(0) {}
+
+    Host::Ptr compute_next();
+
+    virtual void on_execution_latency(const Host::Ptr& host, uint64_t latency_ns);
+    virtual void on_execution_error(const Host::Ptr& host, CassError code);
+
+  private:
+    ScopedPtr<QueryPlan> child_plan_;
+
+    HostVec skipped_;
+    size_t skipped_index_;
+  };
+
+  Settings settings_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(OutlierDetectionPolicy);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
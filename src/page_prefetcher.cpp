@@ -0,0 +1,69 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "page_prefetcher.hpp"
+
+#include "scoped_lock.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+PagePrefetcher::PagePrefetcher(unsigned max_pages)
+    : max_pages_(max_pages)
+    , generation_(0) {
+  uv_mutex_init(&mutex_);
+}
+
+PagePrefetcher::~PagePrefetcher() { uv_mutex_destroy(&mutex_); }
+
+uint64_t PagePrefetcher::start() {
+  ScopedMutex lock(&mutex_);
+  pages_.clear();
+  deferred_paging_state_.clear();
+  return ++generation_;
+}
+
+bool PagePrefetcher::reserve(uint64_t generation, const String& paging_state,
+                             const Future::Ptr& future) {
+  ScopedMutex lock(&mutex_);
+  if (generation != generation_ || pages_.find(paging_state) != pages_.end()) {
+    return false;
+  }
+  if (pages_.size() >= max_pages_) {
+    deferred_paging_state_ = paging_state;
+    return false;
+  }
+  pages_[paging_state] = future;
+  return true;
+}
+
+Future::Ptr PagePrefetcher::take(const String& paging_state, uint64_t* generation,
+                                 String* deferred_paging_state) {
+  ScopedMutex lock(&mutex_);
+  FutureMap::iterator it = pages_.find(paging_state);
+  if (it == pages_.end()) {
+    return Future::Ptr();
+  }
+  Future::Ptr future(it->second);
+  pages_.erase(it);
+  *generation = generation_;
+  if (!deferred_paging_state_.empty()) {
+    *deferred_paging_state = deferred_paging_state_;
+    deferred_paging_state_.clear();
+  }
+  return future;
+}
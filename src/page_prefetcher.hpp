@@ -0,0 +1,97 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_PAGE_PREFETCHER_HPP
+#define DATASTAX_INTERNAL_PAGE_PREFETCHER_HPP
+
+#include "future.hpp"
+#include "map.hpp"
+#include "ref_counted.hpp"
+#include "string.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * Tracks the pages that have been requested ahead of the application for a
+ * paged statement. Prefetched pages are keyed by the paging state used to
+ * request them so that re-executing the statement with that paging state
+ * returns the page that's already in flight (or already received).
+ *
+ * The number of prefetched pages that haven't been taken by the application
+ * is bounded. When the limit is reached the next page is deferred until the
+ * application takes one of the prefetched pages.
+ */
+class PagePrefetcher : public RefCounted<PagePrefetcher> {
+public:
+  typedef SharedRefPtr<PagePrefetcher> Ptr;
+
+  PagePrefetcher(unsigned max_pages);
+  ~PagePrefetcher();
+
+  unsigned max_pages() const { return max_pages_; }
+
+  /**
+   * Starts a new sequence of pages. Previously prefetched pages are discarded
+   * and pages still in flight from previous sequences are not prefetched
+   * further.
+   *
+   * @return The generation of the new sequence.
+   */
+  uint64_t start();
+
+  /**
+   * Reserves a prefetch of the page that follows a received page.
+   *
+   * @param generation The sequence of the received page.
+   * @param paging_state The paging state of the received page.
+   * @param future The future of the request for the next page.
+   * @return true if the next page should be requested, false if the sequence
+   * is stale, the page was already reserved or the look-ahead limit was reached
+   * (the page is then deferred).
+   */
+  bool reserve(uint64_t generation, const String& paging_state, const Future::Ptr& future);
+
+  /**
+   * Takes a prefetched page.
+   *
+   * @param paging_state The paging state of the page to take.
+   * @param generation The sequence of the prefetched page.
+   * @param deferred_paging_state The paging state of a deferred page that
+   * should now be reserved and requested, otherwise it's left empty.
+   * @return The prefetched page's future or an empty pointer if the page
+   * wasn't prefetched.
+   */
+  Future::Ptr take(const String& paging_state, uint64_t* generation,
+                   String* deferred_paging_state);
+
+private:
+  typedef Map<String, Future::Ptr> FutureMap;
+
+  const unsigned max_pages_;
+  uv_mutex_t mutex_;
+  uint64_t generation_;
+  FutureMap pages_;
+  String deferred_paging_state_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PagePrefetcher);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
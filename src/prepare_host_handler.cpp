@@ -26,92 +26,156 @@
 using namespace datastax;
 using namespace datastax::internal::core;
 
-struct CompareEntryKeyspace {
-  bool operator()(const PreparedMetadata::Entry::Ptr& lhs,
-                  const PreparedMetadata::Entry::Ptr& rhs) const {
-    return lhs->keyspace() < rhs->keyspace();
+namespace {
+
+// A snapshot of an entry's last used time so that the order stays consistent
+// while sorting (the entries can be used concurrently by other threads).
+struct PrepareOrder {
+  PrepareOrder(const PreparedMetadata::Entry::Ptr& entry, uint64_t hot_since_ms)
+      : entry(entry)
+      , last_used_ms(entry->last_used_ms())
+      , is_hot(last_used_ms > 0 && last_used_ms >= hot_since_ms) {}
+
+  // Hot statements are first, then the statements are grouped by keyspace to
+  // minimize the number of times the keyspace needs to be changed, and finally
+  // the most recently used statements are first.
+  bool operator<(const PrepareOrder& other) const {
+    if (is_hot != other.is_hot) return is_hot;
+    if (entry->keyspace() != other.entry->keyspace()) {
+      return entry->keyspace() < other.entry->keyspace();
+    }
+    return last_used_ms > other.last_used_ms;
   }
+
+  PreparedMetadata::Entry::Ptr entry;
+  uint64_t last_used_ms;
+  bool is_hot;
 };
 
+} // namespace
+
 PrepareHostHandler::PrepareHostHandler(
     const Host::Ptr& host, const PreparedMetadata::Entry::Vec& prepared_metadata_entries,
-    const Callback& callback, ProtocolVersion protocol_version, unsigned max_requests_per_flush)
+    const Callback& callback, ProtocolVersion protocol_version, unsigned max_concurrent_prepares,
+    unsigned max_prepares_per_second, const PrepareHostMetrics::Ptr& metrics)
     : host_(host)
     , protocol_version_(protocol_version)
     , callback_(callback)
+    , is_ready_(false)
+    , is_finished_(false)
     , connection_(NULL)
     , prepares_outstanding_(0)
-    , max_prepares_outstanding_(CASS_MAX_STREAMS)
-    , prepared_metadata_entries_(prepared_metadata_entries) {
-
-  // Sort by keyspace to minimize the number of times the keyspace
-  // needs to be changed.
-  std::sort(prepared_metadata_entries_.begin(), prepared_metadata_entries_.end(),
-            CompareEntryKeyspace());
+    , max_prepares_outstanding_(
+          std::max(1, std::min(static_cast<int>(max_concurrent_prepares), CASS_MAX_STREAMS)))
+    , max_prepares_per_second_(max_prepares_per_second)
+    , permits_(max_prepares_per_second)
+    , last_refill_ms_(0)
+    , metrics_(metrics)
+    , hot_count_(0)
+    , next_index_(0)
+    , prepared_count_(0) {
+  uint64_t now_ms = uv_hrtime() / (1000 * 1000);
+  uint64_t hot_since_ms = now_ms > CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST_HOT_WINDOW_MS
+                              ? now_ms - CASS_DEFAULT_PREPARE_ON_UP_OR_ADD_HOST_HOT_WINDOW_MS
+                              : 0;
+
+  Vector<PrepareOrder> order;
+  order.reserve(prepared_metadata_entries.size());
+  for (PreparedMetadata::Entry::Vec::const_iterator it = prepared_metadata_entries.begin(),
+                                                    end = prepared_metadata_entries.end();
+       it != end; ++it) {
+    order.push_back(PrepareOrder(*it, hot_since_ms));
+  }
+  std::sort(order.begin(), order.end());
 
-  current_entry_it_ = prepared_metadata_entries_.begin();
+  prepared_metadata_entries_.reserve(order.size());
+  for (Vector<PrepareOrder>::const_iterator it = order.begin(), end = order.end(); it != end;
+       ++it) {
+    prepared_metadata_entries_.push_back(it->entry);
+    if (it->is_hot) hot_count_++;
+  }
+  hot_remaining_ = hot_count_;
 }
 
 void PrepareHostHandler::prepare(uv_loop_t* loop, const ConnectionSettings& settings) {
   if (prepared_metadata_entries_.empty()) {
-    callback_(this);
+    is_finished_ = true;
+    notify_ready();
     return;
   }
 
   inc_ref(); // Reference for the event loop
 
-  Connector::Ptr connector(new Connector(host_, protocol_version_,
-                                         bind_callback(&PrepareHostHandler::on_connect, this)));
+  if (metrics_) {
+    metrics_->hosts_preparing.fetch_add(1);
+    metrics_->pending_statements.fetch_add(static_cast<int64_t>(prepared_metadata_entries_.size()));
+  }
 
-  connector->with_settings(settings)->with_listener(this)->connect(loop);
+  // Don't delay the host if none of the statements have been used recently
+  if (hot_count_ == 0) {
+    notify_ready();
+  }
+
+  connector_.reset(new Connector(host_, protocol_version_,
+                                  bind_callback(&PrepareHostHandler::on_connect, this)));
+
+  connector_->with_settings(settings)->with_listener(this)->connect(loop);
 }
 
-void PrepareHostHandler::on_close(Connection* connection) {
-  callback_(this);
+void PrepareHostHandler::close() {
+  timer_.stop();
+  if (connection_) {
+    connection_->close();
+  } else if (connector_) {
+    connector_->cancel();
+  }
+}
 
-  dec_ref(); // The event loop is done with this handler
+void PrepareHostHandler::on_close(Connection* connection) {
+  timer_.stop();
+  finish();
 }
 
 void PrepareHostHandler::on_connect(Connector* connector) {
+  connector_.reset();
   if (connector->is_ok()) {
     connection_ = connector->release_connection().get();
     prepare_next();
   } else {
-    callback_(this);
-    dec_ref(); // The event loop is done with this handler
+    finish();
   }
 }
 
+void PrepareHostHandler::on_timeout(Timer* timer) { prepare_next(); }
+
 // This is the main loop for preparing statements. It's called after each
 // request successfully completes, either setting the keyspace or preparing
-// a statement. It attempts to group prepare requests into a single batch as
-// long as the keyspace is the same and the number of outstanding requests is
-// under the maximum.
+// a statement, and when the rate limit allows more prepare requests. It keeps
+// writing prepare requests as long as the keyspace is the same and the number
+// of outstanding requests is under the maximum.
 void PrepareHostHandler::prepare_next() {
-  // Finish current prepares before continuing
-  if (--prepares_outstanding_ > 0) {
-    return;
-  }
-
   // Check to see if we're done
   if (is_done()) {
-    close();
+    if (prepares_outstanding_ == 0) {
+      close();
+    }
     return;
   }
 
-  prepares_outstanding_ = 0;
-
   // Write prepare requests until there's no more left, the keyspace changes,
-  // or the maximum number of outstanding prepares is reached.
-  while (!is_done() && check_and_set_keyspace() &&
-         prepares_outstanding_ < max_prepares_outstanding_) {
-    const String& query((*current_entry_it_)->query());
+  // the maximum number of outstanding prepares is reached or the rate limit
+  // is exceeded.
+  bool is_written = false;
+  while (!is_done() && prepares_outstanding_ < max_prepares_outstanding_ &&
+         check_and_set_keyspace() && acquire_permit()) {
+    const String& query(prepared_metadata_entries_[next_index_]->query());
     PrepareRequest::Ptr prepare_request(new PrepareRequest(query));
 
     // Set the keyspace in case per request keyspaces are supported
     prepare_request->set_keyspace(current_keyspace_);
 
-    PrepareCallback::Ptr callback(new PrepareCallback(prepare_request, Ptr(this)));
+    PrepareCallback::Ptr callback(
+        new PrepareCallback(prepare_request, Ptr(this), next_index_ < hot_count_));
     if (connection_->write(callback) < 0) {
       LOG_WARN("Failed to write prepare request while preparing all queries on host %s",
                host_->address_string().c_str());
@@ -119,11 +183,14 @@ void PrepareHostHandler::prepare_next() {
       return;
     }
 
+    is_written = true;
     prepares_outstanding_++;
-    current_entry_it_++;
+    next_index_++;
   }
 
-  connection_->flush();
+  if (is_written) {
+    connection_->flush();
+  }
 }
 
 bool PrepareHostHandler::check_and_set_keyspace() {
@@ -131,9 +198,14 @@ bool PrepareHostHandler::check_and_set_keyspace() {
     return true;
   }
 
-  const String& keyspace((*current_entry_it_)->keyspace());
+  const String& keyspace(prepared_metadata_entries_[next_index_]->keyspace());
 
   if (keyspace != current_keyspace_) {
+    // The keyspace is per connection so wait for the outstanding prepares
+    // using the current keyspace to finish.
+    if (prepares_outstanding_ > 0) {
+      return false;
+    }
     PrepareCallback::Ptr callback(new SetKeyspaceCallback(keyspace, Ptr(this)));
     if (connection_->write_and_flush(callback) < 0) {
       LOG_WARN("Failed to write \"USE\" keyspace request while preparing all queries on host %s",
@@ -141,6 +213,7 @@ bool PrepareHostHandler::check_and_set_keyspace() {
       close();
       return false;
     }
+    prepares_outstanding_++;
     current_keyspace_ = keyspace;
     return false;
   }
@@ -148,33 +221,103 @@ bool PrepareHostHandler::check_and_set_keyspace() {
   return true;
 }
 
-bool PrepareHostHandler::is_done() const {
-  return current_entry_it_ == prepared_metadata_entries_.end();
+bool PrepareHostHandler::acquire_permit() {
+  if (max_prepares_per_second_ == 0) {
+    return true;
+  }
+
+  // Token bucket that allows a burst of up to a second's worth of prepares
+  uint64_t now_ms = uv_now(connection_->loop());
+  if (last_refill_ms_ != 0) {
+    permits_ = std::min(static_cast<double>(max_prepares_per_second_),
+                        permits_ + static_cast<double>(now_ms - last_refill_ms_) *
+                                       max_prepares_per_second_ / 1000.0);
+  }
+  last_refill_ms_ = now_ms;
+
+  if (permits_ >= 1.0) {
+    permits_ -= 1.0;
+    return true;
+  }
+
+  if (!timer_.is_running()) {
+    uint64_t delay_ms =
+        static_cast<uint64_t>((1.0 - permits_) * 1000.0 / max_prepares_per_second_) + 1;
+    timer_.start(connection_->loop(), delay_ms,
+                 bind_callback(&PrepareHostHandler::on_timeout, this));
+  }
+  return false;
+}
+
+void PrepareHostHandler::on_prepared(bool is_hot) {
+  prepares_outstanding_--;
+  prepared_count_++;
+  if (metrics_) {
+    metrics_->pending_statements.fetch_sub(1);
+    metrics_->prepared_statements.fetch_add(1);
+  }
+  if (is_hot && --hot_remaining_ == 0) {
+    LOG_DEBUG("Prepared %u recently used statement(s) on host %s",
+              static_cast<unsigned>(hot_count_), host_->address_string().c_str());
+    notify_ready();
+  }
+  prepare_next();
+}
+
+void PrepareHostHandler::on_keyspace_set() {
+  prepares_outstanding_--;
+  prepare_next();
+}
+
+void PrepareHostHandler::notify_ready() {
+  if (!is_ready_) {
+    is_ready_ = true;
+    callback_(this);
+  }
+}
+
+void PrepareHostHandler::finish() {
+  is_finished_ = true;
+  notify_ready();
+
+  if (metrics_) {
+    metrics_->pending_statements.fetch_sub(
+        static_cast<int64_t>(prepared_metadata_entries_.size() - prepared_count_));
+    metrics_->hosts_preparing.fetch_sub(1);
+  }
+
+  dec_ref(); // The event loop is done with this handler
 }
 
-void PrepareHostHandler::close() { connection_->close(); }
+bool PrepareHostHandler::is_done() const {
+  return next_index_ == prepared_metadata_entries_.size();
+}
 
 PrepareHostHandler::PrepareCallback::PrepareCallback(
-    const PrepareRequest::ConstPtr& prepare_request, const PrepareHostHandler::Ptr& handler)
+    const PrepareRequest::ConstPtr& prepare_request, const PrepareHostHandler::Ptr& handler,
+    bool is_hot)
     : SimpleRequestCallback(prepare_request)
-    , handler_(handler) {}
+    , handler_(handler)
+    , is_hot_(is_hot) {}
 
 void PrepareHostHandler::PrepareCallback::on_internal_set(ResponseMessage* response) {
   LOG_DEBUG("Successfully prepared query \"%s\" on host %s while preparing all queries",
             static_cast<const PrepareRequest*>(request())->query().c_str(),
             handler_->host()->address_string().c_str());
-  handler_->prepare_next();
+  handler_->on_prepared(is_hot_);
 }
 
 void PrepareHostHandler::PrepareCallback::on_internal_error(CassError code, const String& message) {
   LOG_WARN("Prepare request failed on host %s while attempting to prepare all queries: %s (%s)",
            handler_->host_->address_string().c_str(), message.c_str(), cass_error_desc(code));
+  if (handler_->metrics_) handler_->metrics_->failed_statements.fetch_add(1);
   handler_->close();
 }
 
 void PrepareHostHandler::PrepareCallback::on_internal_timeout() {
   LOG_WARN("Prepare request timed out on host %s while attempting to prepare all queries",
            handler_->host_->address_string().c_str());
+  if (handler_->metrics_) handler_->metrics_->failed_statements.fetch_add(1);
   handler_->close();
 }
 
@@ -186,7 +329,7 @@ PrepareHostHandler::SetKeyspaceCallback::SetKeyspaceCallback(const String& keysp
 void PrepareHostHandler::SetKeyspaceCallback::on_internal_set(ResponseMessage* response) {
   LOG_TRACE("Successfully set keyspace to \"%s\" on host %s while preparing all queries",
             handler_->current_keyspace_.c_str(), handler_->host()->address_string().c_str());
-  handler_->prepare_next();
+  handler_->on_keyspace_set();
 }
 
 void PrepareHostHandler::SetKeyspaceCallback::on_internal_error(CassError code,
@@ -17,19 +17,45 @@
 #ifndef DATASTAX_INTERNAL_PREPARE_HOST_HANDLER_HPP
 #define DATASTAX_INTERNAL_PREPARE_HOST_HANDLER_HPP
 
+#include "atomic.hpp"
 #include "callback.hpp"
 #include "connector.hpp"
 #include "host.hpp"
 #include "prepared.hpp"
 #include "ref_counted.hpp"
 #include "string.hpp"
+#include "timer.hpp"
 
 namespace datastax { namespace internal { namespace core {
 
 class Connector;
 
 /**
- * A handler for pre-preparing statements on a newly available host.
+ * Metrics for preparing statements on hosts that are brought up or added
+ * (thread-safe).
+ */
+class PrepareHostMetrics : public RefCounted<PrepareHostMetrics> {
+public:
+  typedef SharedRefPtr<PrepareHostMetrics> Ptr;
+
+  PrepareHostMetrics()
+      : hosts_preparing(0)
+      , pending_statements(0)
+      , prepared_statements(0)
+      , failed_statements(0) {}
+
+  Atomic<int64_t> hosts_preparing;
+  Atomic<int64_t> pending_statements;
+  Atomic<uint64_t> prepared_statements;
+  Atomic<uint64_t> failed_statements;
+};
+
+/**
+ * A handler for pre-preparing statements on a newly available host. The most
+ * recently used ("hot") statements are prepared first and the callback is
+ * called as soon as they're prepared. The remaining statements are prepared
+ * in the background with a bounded number of outstanding requests and an
+ * optional rate limit.
  */
 class PrepareHostHandler
     : public RefCounted<PrepareHostHandler>
@@ -38,20 +64,30 @@ public:
   typedef internal::Callback<void, const PrepareHostHandler*> Callback;
 
   typedef SharedRefPtr<PrepareHostHandler> Ptr;
+  typedef Vector<Ptr> Vec;
 
   PrepareHostHandler(const Host::Ptr& host,
                      const PreparedMetadata::Entry::Vec& prepared_metadata_entries,
                      const Callback& callback, ProtocolVersion protocol_version,
-                     unsigned max_requests_per_flush);
+                     unsigned max_concurrent_prepares, unsigned max_prepares_per_second = 0,
+                     const PrepareHostMetrics::Ptr& metrics = PrepareHostMetrics::Ptr());
 
   const Host::Ptr host() const { return host_; }
 
   void prepare(uv_loop_t* loop, const ConnectionSettings& settings);
 
+  /**
+   * Stop preparing statements and close the temporary connection.
+   */
+  void close();
+
+  bool is_finished() const { return is_finished_; }
+
 private:
   virtual void on_close(Connection* connection);
 
   void on_connect(Connector* connector);
+  void on_timeout(Timer* timer);
 
 private:
   /**
@@ -62,7 +98,7 @@ private:
   class PrepareCallback : public SimpleRequestCallback {
   public:
     PrepareCallback(const PrepareRequest::ConstPtr& prepare_request,
-                    const PrepareHostHandler::Ptr& handler);
+                    const PrepareHostHandler::Ptr& handler, bool is_hot);
 
     virtual void on_internal_set(ResponseMessage* response);
 
@@ -72,6 +108,7 @@ private:
 
   private:
     PrepareHostHandler::Ptr handler_;
+    bool is_hot_;
   };
 
   /**
@@ -101,20 +138,41 @@ private:
   // Returns true if the keyspace is current or using protocol v5/DSEv2
   bool check_and_set_keyspace();
 
-  bool is_done() const;
+  // Returns true if the rate limit allows another prepare request, otherwise
+  // it schedules a timer to continue once it does.
+  bool acquire_permit();
 
-  void close();
+  void on_prepared(bool is_hot);
+  void on_keyspace_set();
+
+  // Calls the callback once the hot statements are prepared (or on failure)
+  void notify_ready();
+
+  void finish();
+
+  bool is_done() const;
 
 private:
   const Host::Ptr host_;
   const ProtocolVersion protocol_version_;
   Callback callback_;
+  bool is_ready_;
+  bool is_finished_;
+  Connector::Ptr connector_;
   Connection* connection_;
   String current_keyspace_;
   int prepares_outstanding_;
   const int max_prepares_outstanding_;
+  const unsigned max_prepares_per_second_;
+  double permits_;
+  uint64_t last_refill_ms_;
+  Timer timer_;
+  PrepareHostMetrics::Ptr metrics_;
   PreparedMetadata::Entry::Vec prepared_metadata_entries_;
-  PreparedMetadata::Entry::Vec::const_iterator current_entry_it_;
+  size_t hot_count_;
+  size_t hot_remaining_;
+  size_t next_index_;
+  size_t prepared_count_;
 };
 
 }}} // namespace datastax::internal::core
@@ -76,12 +76,14 @@ const CassDataType* cass_prepared_parameter_data_type_by_name_n(const CassPrepar
 
 Prepared::Prepared(const ResultResponse::Ptr& result,
                    const PrepareRequest::ConstPtr& prepare_request,
-                   const Metadata::SchemaSnapshot& schema_metadata)
+                   const Metadata::SchemaSnapshot& schema_metadata,
+                   const PreparedMetadata::Entry::Ptr& metadata_entry)
     : result_(result)
     , id_(result->prepared_id().to_string())
     , query_(prepare_request->query())
     , keyspace_(prepare_request->keyspace())
-    , request_settings_(prepare_request->settings()) {
+    , request_settings_(prepare_request->settings())
+    , metadata_entry_(metadata_entry) {
   assert(result->protocol_version() > 0 && "The protocol version should be set");
   if (result->protocol_version() >= CASS_PROTOCOL_VERSION_V4) {
     key_indices_ = result->pk_indices();
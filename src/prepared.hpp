@@ -17,6 +17,7 @@
 #ifndef DATASTAX_INTERNAL_PREPARED_HPP
 #define DATASTAX_INTERNAL_PREPARED_HPP
 
+#include "atomic.hpp"
 #include "buffer.hpp"
 #include "dense_hash_map.hpp"
 #include "external.hpp"
@@ -33,29 +34,6 @@
 
 namespace datastax { namespace internal { namespace core {
 
-class Prepared : public RefCounted<Prepared> {
-public:
-  typedef SharedRefPtr<const Prepared> ConstPtr;
-
-  Prepared(const ResultResponse::Ptr& result, const PrepareRequest::ConstPtr& prepare_request,
-           const Metadata::SchemaSnapshot& schema_metadata);
-
-  const ResultResponse::ConstPtr& result() const { return result_; }
-  const String& id() const { return id_; }
-  const String& query() const { return query_; }
-  const String& keyspace() const { return keyspace_; }
-  const RequestSettings& request_settings() const { return request_settings_; }
-  const ResultResponse::PKIndexVec& key_indices() const { return key_indices_; }
-
-private:
-  ResultResponse::ConstPtr result_;
-  String id_;
-  String query_;
-  String keyspace_;
-  RequestSettings request_settings_;
-  ResultResponse::PKIndexVec key_indices_;
-};
-
 class PreparedMetadata {
 public:
   class Entry : public RefCounted<Entry> {
@@ -64,25 +42,49 @@ public:
     typedef Vector<Ptr> Vec;
 
     Entry(const String& query, const String& keyspace, const String& result_metadata_id,
-          const ResultResponse::ConstPtr& result)
+          const ResultResponse::ConstPtr& result, const String& request_keyspace = String())
         : query_(query)
         , keyspace_(keyspace)
+        , request_keyspace_(request_keyspace)
         , result_metadata_id_(sizeof(uint16_t) + result_metadata_id.size())
-        , result_(result) {
+        , result_(result)
+        , is_stale_(false)
+        , last_used_ms_(0) {
       result_metadata_id_.encode_string(0, result_metadata_id.data(),
                                         static_cast<uint16_t>(result_metadata_id.size()));
     }
 
     const String& query() const { return query_; }
     const String& keyspace() const { return keyspace_; }
+    // The keyspace the statement was prepared in. This is empty if it was
+    // prepared in the connection's keyspace.
+    const String& request_keyspace() const { return request_keyspace_; }
     const Buffer& result_metadata_id() const { return result_metadata_id_; }
     const ResultResponse::ConstPtr& result() const { return result_; }
 
+    // An entry is stale once it's been replaced by a newer entry for the same
+    // prepared ID (e.g. after the statement's result metadata changed).
+    bool is_stale() const { return is_stale_.load(MEMORY_ORDER_ACQUIRE); }
+    void mark_stale() const { is_stale_.store(true, MEMORY_ORDER_RELEASE); }
+
+    // The last time (monotonic, in milliseconds) the statement was executed.
+    // It's only updated when it changes by at least a second to avoid
+    // contention between the threads executing the statement.
+    uint64_t last_used_ms() const { return last_used_ms_.load(MEMORY_ORDER_RELAXED); }
+    void mark_used(uint64_t now_ms) const {
+      if (now_ms >= last_used_ms_.load(MEMORY_ORDER_RELAXED) + 1000) {
+        last_used_ms_.store(now_ms, MEMORY_ORDER_RELAXED);
+      }
+    }
+
   private:
     String query_;
     String keyspace_;
+    String request_keyspace_;
     Buffer result_metadata_id_;
     ResultResponse::ConstPtr result_;
+    mutable Atomic<bool> is_stale_;
+    mutable Atomic<uint64_t> last_used_ms_;
   };
 
   PreparedMetadata() {
@@ -103,7 +105,17 @@ public:
 
   void set(const String& prepared_id, const PreparedMetadata::Entry::Ptr& entry) {
     ScopedWriteLock wl(&rwlock_);
-    metadata_[prepared_id] = entry;
+    Entry::Ptr& current = metadata_[prepared_id];
+    if (current && current.get() != entry.get()) {
+      // The result metadata ID is a hash of the result metadata (v5+ only) so
+      // the current entry is still valid if the IDs are the same.
+      if (!is_same_result_metadata(current, entry)) {
+        current->mark_stale();
+        current = entry;
+      }
+    } else {
+      current = entry;
+    }
   }
 
   Entry::Vec copy() const {
@@ -119,10 +131,47 @@ public:
 private:
   typedef DenseHashMap<String, Entry::Ptr> Map;
 
+  static bool is_same_result_metadata(const Entry::Ptr& lhs, const Entry::Ptr& rhs) {
+    const Buffer& lhs_id(lhs->result_metadata_id());
+    const Buffer& rhs_id(rhs->result_metadata_id());
+    return lhs_id.size() > sizeof(uint16_t) && lhs_id.size() == rhs_id.size() &&
+           memcmp(lhs_id.data(), rhs_id.data(), lhs_id.size()) == 0;
+  }
+
   mutable uv_rwlock_t rwlock_;
   Map metadata_;
 };
 
+class Prepared : public RefCounted<Prepared> {
+public:
+  typedef SharedRefPtr<const Prepared> ConstPtr;
+
+  Prepared(const ResultResponse::Ptr& result, const PrepareRequest::ConstPtr& prepare_request,
+           const Metadata::SchemaSnapshot& schema_metadata,
+           const PreparedMetadata::Entry::Ptr& metadata_entry = PreparedMetadata::Entry::Ptr());
+
+  const ResultResponse::ConstPtr& result() const { return result_; }
+  const String& id() const { return id_; }
+  const String& query() const { return query_; }
+  const String& keyspace() const { return keyspace_; }
+  const RequestSettings& request_settings() const { return request_settings_; }
+  const ResultResponse::PKIndexVec& key_indices() const { return key_indices_; }
+
+  // The metadata entry recorded when the statement was prepared. It can be
+  // used for executing the statement without looking up the entry until it's
+  // marked as stale.
+  const PreparedMetadata::Entry::Ptr& metadata_entry() const { return metadata_entry_; }
+
+private:
+  ResultResponse::ConstPtr result_;
+  String id_;
+  String query_;
+  String keyspace_;
+  RequestSettings request_settings_;
+  ResultResponse::PKIndexVec key_indices_;
+  PreparedMetadata::Entry::Ptr metadata_entry_;
+};
+
 }}} // namespace datastax::internal::core
 
 EXTERNAL_TYPE(datastax::internal::core::Prepared, CassPrepared)
@@ -0,0 +1,151 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "prepared_cache.hpp"
+
+#include "logger.hpp"
+#include "request_handler.hpp"
+#include "scoped_lock.hpp"
+#include "scoped_ptr.hpp"
+#include "statement.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+struct PreparedCache::PendingPrepare : public Allocated {
+  PendingPrepare(const PreparedCache::Ptr& cache, const String& key, uint64_t generation)
+      : cache(cache)
+      , key(key)
+      , generation(generation) {}
+
+  PreparedCache::Ptr cache;
+  String key;
+  uint64_t generation;
+};
+
+PreparedCache::PreparedCache(size_t capacity, const String& keyspace)
+    : capacity_(capacity)
+    , keyspace_(keyspace)
+    , generation_(0) {
+  uv_mutex_init(&mutex_);
+}
+
+PreparedCache::~PreparedCache() {
+  clear();
+  uv_mutex_destroy(&mutex_);
+}
+
+String PreparedCache::key(const Statement* statement) {
+  return key(statement->keyspace(), statement->query());
+}
+
+String PreparedCache::key(const String& keyspace, const String& query) {
+  // Statements with the same query can be executed in different keyspaces
+  String key(keyspace);
+  key.push_back('\0');
+  key.append(query);
+  return key;
+}
+
+Prepared::ConstPtr PreparedCache::find(const String& key) {
+  ScopedMutex l(&mutex_);
+  EntryMap::iterator it = entries_.find(key);
+  if (it == entries_.end()) {
+    return Prepared::ConstPtr();
+  }
+  Entry* entry = it->second;
+  lru_.remove(entry);
+  lru_.add_to_front(entry);
+  return entry->prepared;
+}
+
+bool PreparedCache::reserve(const String& key, uint64_t* generation) {
+  ScopedMutex l(&mutex_);
+  if (entries_.find(key) != entries_.end() || !pending_.insert(key).second) {
+    return false;
+  }
+  *generation = generation_;
+  return true;
+}
+
+void PreparedCache::add_when_prepared(const SharedRefPtr<ResponseFuture>& future,
+                                      const String& key, uint64_t generation) {
+  future->set_callback(on_prepared, new PendingPrepare(Ptr(this), key, generation));
+}
+
+void PreparedCache::set_keyspace(const String& keyspace) {
+  ScopedMutex l(&mutex_);
+  if (keyspace_ != keyspace) {
+    keyspace_ = keyspace;
+    clear();
+  }
+}
+
+size_t PreparedCache::size() {
+  ScopedMutex l(&mutex_);
+  return entries_.size();
+}
+
+void PreparedCache::on_prepared(CassFuture* future, void* data) {
+  ScopedPtr<PendingPrepare> pending(static_cast<PendingPrepare*>(data));
+  pending->cache->add(pending->key, pending->generation,
+                      static_cast<ResponseFuture*>(future->from()));
+}
+
+void PreparedCache::add(const String& key, uint64_t generation, ResponseFuture* future) {
+  Prepared::ConstPtr prepared;
+  if (future->error() == NULL) {
+    SharedRefPtr<ResultResponse> result(future->response());
+    if (result && result->kind() == CASS_RESULT_KIND_PREPARED) {
+      prepared.reset(new Prepared(result, future->prepare_request, *future->schema_metadata,
+                                  future->prepared_metadata_entry));
+    }
+  } else {
+    LOG_DEBUG("Unable to prepare cached statement: %s", future->error()->message.c_str());
+  }
+
+  ScopedMutex l(&mutex_);
+  if (generation != generation_) {
+    return; // The cache was cleared so the reservation is already released
+  }
+  pending_.erase(key);
+  if (!prepared || entries_.find(key) != entries_.end()) {
+    return;
+  }
+
+  if (entries_.size() >= capacity_) {
+    Entry* lru = lru_.back();
+    lru_.remove(lru);
+    entries_.erase(lru->key);
+    delete lru;
+  }
+
+  Entry* entry = new Entry(key, prepared);
+  entries_[key] = entry;
+  lru_.add_to_front(entry);
+}
+
+void PreparedCache::clear() {
+  while (!lru_.is_empty()) {
+    Entry* entry = lru_.front();
+    lru_.remove(entry);
+    delete entry;
+  }
+  entries_.clear();
+  pending_.clear();
+  generation_++;
+}
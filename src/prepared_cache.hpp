@@ -0,0 +1,144 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_PREPARED_CACHE_HPP
+#define DATASTAX_INTERNAL_PREPARED_CACHE_HPP
+
+#include "cassandra.h"
+#include "list.hpp"
+#include "macros.hpp"
+#include "map.hpp"
+#include "prepared.hpp"
+#include "ref_counted.hpp"
+#include "set.hpp"
+#include "string.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+class ResponseFuture;
+class Statement;
+
+/**
+ * A bounded, least recently used cache of prepared statements keyed by the
+ * query text of simple statements. Cacheable simple statements are executed
+ * as bound statements once their query has been prepared (in the background)
+ * so that the server doesn't have to parse the query again.
+ */
+class PreparedCache : public RefCounted<PreparedCache> {
+public:
+  typedef SharedRefPtr<PreparedCache> Ptr;
+
+  /**
+   * Constructor.
+   *
+   * @param capacity The maximum number of prepared statements.
+   * @param keyspace The session's keyspace.
+   */
+  PreparedCache(size_t capacity, const String& keyspace);
+  ~PreparedCache();
+
+  /**
+   * Get the cache key for a simple statement.
+   */
+  static String key(const Statement* statement);
+
+  /**
+   * Get the cache key for a query executed in a keyspace.
+   */
+  static String key(const String& keyspace, const String& query);
+
+  /**
+   * Find the prepared statement for a query and mark it as the most recently
+   * used.
+   *
+   * @param key The statement's cache key.
+   * @return The prepared statement or an empty pointer if it isn't cached.
+   */
+  Prepared::ConstPtr find(const String& key);
+
+  /**
+   * Reserve the preparation of a query that isn't cached.
+   *
+   * @param key The statement's cache key.
+   * @param generation The current generation of the cache.
+   * @return true if the query should be prepared, false if it's already being
+   * prepared.
+   */
+  bool reserve(const String& key, uint64_t* generation);
+
+  /**
+   * Add the prepared statement for a reserved query when its prepare request
+   * finishes. The least recently used statement is evicted if the cache is
+   * full. A failed prepare request releases the reservation so that the query
+   * is prepared again the next time it's executed.
+   *
+   * @param future The future of the prepare request.
+   * @param key The statement's cache key.
+   * @param generation The generation of the reservation. Statements prepared
+   * before the cache was cleared are ignored.
+   */
+  void add_when_prepared(const SharedRefPtr<ResponseFuture>& future, const String& key,
+                         uint64_t generation);
+
+  /**
+   * Update the session's keyspace. This clears the cache if the keyspace
+   * changed because queries without a keyspace depend on it.
+   *
+   * @param keyspace The session's new keyspace.
+   */
+  void set_keyspace(const String& keyspace);
+
+  size_t size();
+
+private:
+  struct Entry
+      : public List<Entry>::Node
+      , public Allocated {
+    Entry(const String& key, const Prepared::ConstPtr& prepared)
+        : key(key)
+        , prepared(prepared) {}
+
+    const String key;
+    const Prepared::ConstPtr prepared;
+  };
+
+  struct PendingPrepare;
+
+  typedef Map<String, Entry*> EntryMap;
+
+  static void on_prepared(CassFuture* future, void* data);
+
+  void add(const String& key, uint64_t generation, ResponseFuture* future);
+  void clear();
+
+private:
+  uv_mutex_t mutex_;
+  const size_t capacity_;
+  String keyspace_;
+  uint64_t generation_;
+  EntryMap entries_;
+  List<Entry> lru_; // Most recently used first
+  Set<String> pending_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(PreparedCache);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
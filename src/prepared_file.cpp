@@ -0,0 +1,182 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "prepared_file.hpp"
+
+#include "buffer.hpp"
+#include "constants.hpp"
+#include "decoder.hpp"
+#include "logger.hpp"
+
+#include <stdio.h>
+#include <string.h>
+
+#define PREPARED_FILE_MAGIC "CASSPREP"
+#define PREPARED_FILE_MAGIC_SIZE (sizeof(PREPARED_FILE_MAGIC) - 1)
+#define PREPARED_FILE_VERSION 1
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+class File {
+public:
+  File(const String& path, const char* mode)
+      : file_(fopen(path.c_str(), mode)) {}
+
+  ~File() {
+    if (file_ != NULL) fclose(file_);
+  }
+
+  FILE* get() const { return file_; }
+
+  bool close() {
+    int rc = fclose(file_);
+    file_ = NULL;
+    return rc == 0;
+  }
+
+private:
+  FILE* file_;
+};
+
+bool read_file(const String& path, String* contents) {
+  File file(path, "rb");
+  if (file.get() == NULL) {
+    return false;
+  }
+
+  char buf[4096];
+  size_t size;
+  while ((size = fread(buf, 1, sizeof(buf), file.get())) > 0) {
+    contents->append(buf, size);
+  }
+  return ferror(file.get()) == 0;
+}
+
+bool decode_record(Decoder& decoder, ProtocolVersion protocol_version,
+                   PreparedFile::Record* record) {
+  const char* query;
+  size_t query_size;
+  StringRef keyspace;
+  StringRef body;
+  CHECK_RESULT(decoder.decode_long_string(&query, query_size));
+  CHECK_RESULT(decoder.decode_string(&keyspace));
+  CHECK_RESULT(decoder.decode_bytes(&body));
+
+  // The result references its buffer so it needs its own copy of the body
+  ResultResponse::Ptr result(new ResultResponse());
+  result->set_buffer(body.size());
+  memcpy(result->data(), body.data(), body.size());
+  Decoder result_decoder(result->data(), body.size(), protocol_version);
+  if (!result->decode(result_decoder) || result->kind() != CASS_RESULT_KIND_PREPARED) {
+    return false;
+  }
+
+  record->query.assign(query, query_size);
+  record->keyspace = keyspace.to_string();
+  record->result = ResultResponse::ConstPtr(result);
+  return true;
+}
+
+} // namespace
+
+bool PreparedFile::read(const String& path, ProtocolVersion protocol_version,
+                        const String& keyspace, RecordVec* records) {
+  String contents;
+  if (!read_file(path, &contents)) {
+    LOG_DEBUG("Unable to read prepared statements file \"%s\"", path.c_str());
+    return false;
+  }
+
+  if (contents.size() < PREPARED_FILE_MAGIC_SIZE ||
+      memcmp(contents.data(), PREPARED_FILE_MAGIC, PREPARED_FILE_MAGIC_SIZE) != 0) {
+    LOG_WARN("Ignoring invalid prepared statements file \"%s\"", path.c_str());
+    return false;
+  }
+
+  Decoder decoder(contents.data() + PREPARED_FILE_MAGIC_SIZE,
+                  contents.size() - PREPARED_FILE_MAGIC_SIZE, protocol_version);
+  decoder.set_type("prepared statements file");
+
+  int32_t version = 0;
+  uint8_t file_protocol_version = 0;
+  StringRef file_keyspace;
+  int32_t count = 0;
+  if (!decoder.decode_int32(version) || version != PREPARED_FILE_VERSION ||
+      !decoder.decode_byte(file_protocol_version) || !decoder.decode_string(&file_keyspace) ||
+      !decoder.decode_int32(count)) {
+    LOG_WARN("Ignoring prepared statements file \"%s\" with an unsupported format",
+             path.c_str());
+    return false;
+  }
+
+  // Prepared results are encoded differently by each protocol version and
+  // unqualified queries depend on the keyspace they were prepared in.
+  if (file_protocol_version != protocol_version.value() || file_keyspace != keyspace) {
+    LOG_INFO("Ignoring prepared statements file \"%s\" written by a session with a different "
+             "protocol version or keyspace",
+             path.c_str());
+    return false;
+  }
+
+  RecordVec temp;
+  temp.reserve(count > 0 ? count : 0);
+  for (int32_t i = 0; i < count; ++i) {
+    Record record;
+    if (!decode_record(decoder, protocol_version, &record)) {
+      LOG_WARN("Ignoring corrupt prepared statements file \"%s\"", path.c_str());
+      return false;
+    }
+    temp.push_back(record);
+  }
+
+  records->swap(temp);
+  return true;
+}
+
+bool PreparedFile::write(const String& path, ProtocolVersion protocol_version,
+                         const String& keyspace, const RecordVec& records) {
+  size_t size = PREPARED_FILE_MAGIC_SIZE + sizeof(int32_t) + sizeof(uint8_t) + sizeof(uint16_t) +
+                keyspace.size() + sizeof(int32_t);
+  for (RecordVec::const_iterator it = records.begin(), end = records.end(); it != end; ++it) {
+    size += sizeof(int32_t) + it->query.size() + sizeof(uint16_t) + it->keyspace.size() +
+            sizeof(int32_t) + it->result->encoded_prepared().size();
+  }
+
+  Buffer buf(size);
+  size_t pos = buf.copy(0, PREPARED_FILE_MAGIC, PREPARED_FILE_MAGIC_SIZE);
+  pos = buf.encode_int32(pos, PREPARED_FILE_VERSION);
+  pos = buf.encode_byte(pos, static_cast<uint8_t>(protocol_version.value()));
+  pos = buf.encode_string(pos, keyspace.data(), static_cast<uint16_t>(keyspace.size()));
+  pos = buf.encode_int32(pos, static_cast<int32_t>(records.size()));
+  for (RecordVec::const_iterator it = records.begin(), end = records.end(); it != end; ++it) {
+    StringRef body(it->result->encoded_prepared());
+    pos = buf.encode_long_string(pos, it->query.data(), static_cast<int32_t>(it->query.size()));
+    pos = buf.encode_string(pos, it->keyspace.data(), static_cast<uint16_t>(it->keyspace.size()));
+    pos = buf.encode_bytes(pos, body.data(), static_cast<int32_t>(body.size()));
+  }
+
+  File file(path, "wb");
+  if (file.get() == NULL || fwrite(buf.data(), 1, buf.size(), file.get()) != buf.size() ||
+      !file.close()) {
+    LOG_WARN("Unable to write prepared statements file \"%s\"", path.c_str());
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,81 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_PREPARED_FILE_HPP
+#define DATASTAX_INTERNAL_PREPARED_FILE_HPP
+
+#include "protocol.hpp"
+#include "result_response.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * A file of prepared statements that's used to avoid preparing the same
+ * statements every time an application is restarted. The file contains a
+ * versioned header followed by a record for each prepared statement (its
+ * query, keyspace and prepared result) encoded using the native protocol's
+ * notation.
+ */
+class PreparedFile {
+public:
+  struct Record {
+    Record() {}
+
+    Record(const String& query, const String& keyspace, const ResultResponse::ConstPtr& result)
+        : query(query)
+        , keyspace(keyspace)
+        , result(result) {}
+
+    String query;
+    String keyspace;
+    ResultResponse::ConstPtr result;
+  };
+
+  typedef Vector<Record> RecordVec;
+
+  /**
+   * Read the prepared statements from a file. The file is ignored if it was
+   * written using a different file format, protocol version or session
+   * keyspace.
+   *
+   * @param path The path of the file.
+   * @param protocol_version The session's protocol version.
+   * @param keyspace The session's keyspace.
+   * @param records The prepared statements read from the file.
+   * @return true if the file was read, otherwise false.
+   */
+  static bool read(const String& path, ProtocolVersion protocol_version, const String& keyspace,
+                   RecordVec* records);
+
+  /**
+   * Write prepared statements to a file (replacing its contents).
+   *
+   * @param path The path of the file.
+   * @param protocol_version The session's protocol version.
+   * @param keyspace The session's keyspace.
+   * @param records The prepared statements to write. The results must be
+   * prepared results.
+   * @return true if the file was written, otherwise false.
+   */
+  static bool write(const String& path, ProtocolVersion protocol_version, const String& keyspace,
+                    const RecordVec& records);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -27,6 +27,7 @@
 #include "retry_policy.hpp"
 #include "socket.hpp"
 #include "string_ref.hpp"
+#include "vector.hpp"
 
 #include <stdint.h>
 #include <utility>
@@ -39,6 +40,12 @@ class CustomPayload : public RefCounted<CustomPayload> {
 public:
   typedef SharedRefPtr<const CustomPayload> ConstPtr;
 
+  CustomPayload() {}
+
+  CustomPayload(const CustomPayload& other)
+      : RefCounted<CustomPayload>()
+      , items_(other.items_) {}
+
   virtual ~CustomPayload() {}
 
   void set(const char* name, size_t name_length, const uint8_t* value, size_t value_size);
@@ -76,6 +83,7 @@ struct RequestSettings {
 class Request : public RefCounted<Request> {
 public:
   typedef SharedRefPtr<const Request> ConstPtr;
+  typedef Vector<ConstPtr> ConstVec;
 
   enum {
     REQUEST_ERROR_UNSUPPORTED_PROTOCOL = SocketRequest::SOCKET_REQUEST_ERROR_LAST_ENTRY,
@@ -187,8 +195,32 @@ public:
   void set_host(const Address& host) { host_.reset(new Address(host)); }
   const Address* host() const { return host_.get(); }
 
+  // A ring token used by token-aware routing instead of hashing the routing key
+  void set_routing_token(const String& token) { routing_token_ = token; }
+  const String& routing_token() const { return routing_token_; }
+
+  // Identifies the request in the per-statement latency statistics
+  void set_label(const String& label) { label_ = label; }
+  const String& label() const { return label_; }
+
   virtual int encode(ProtocolVersion version, RequestCallback* callback, BufferVec* bufs) const = 0;
 
+protected:
+  // Copies the settings and options of another request (used to execute a
+  // request as a different type of request).
+  Request(uint8_t opcode, const Request& request)
+      : opcode_(opcode)
+      , flags_(request.flags_)
+      , settings_(request.settings_)
+      , timestamp_(request.timestamp_)
+      , record_attempted_addresses_(request.record_attempted_addresses_)
+      , custom_payload_(request.custom_payload_)
+      , custom_payload_extra_(request.custom_payload_extra_)
+      , profile_name_(request.profile_name_)
+      , host_(request.host_ ? new Address(*request.host_) : NULL)
+      , routing_token_(request.routing_token_)
+      , label_(request.label_) {}
+
 private:
   uint8_t opcode_;
   uint8_t flags_;
@@ -199,6 +231,8 @@ private:
   CustomPayload custom_payload_extra_;
   String profile_name_;
   ScopedPtr<Address> host_;
+  String routing_token_;
+  String label_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(Request);
@@ -210,6 +244,10 @@ public:
       : Request(opcode) {}
 
   virtual bool get_routing_key(String* routing_key) const = 0;
+
+protected:
+  RoutableRequest(uint8_t opcode, const Request& request)
+      : Request(opcode, request) {}
 };
 
 }}} // namespace datastax::internal::core
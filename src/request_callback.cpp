@@ -62,6 +62,11 @@ int32_t RequestCallback::encode(BufferVec* bufs) {
     return Request::REQUEST_ERROR_UNSUPPORTED_PROTOCOL;
   }
 
+  if (is_continuous_paging() && !version.is_dse()) {
+    on_error(CASS_ERROR_LIB_MESSAGE_ENCODE, "Continuous paging requires a DSE protocol version");
+    return Request::REQUEST_ERROR_UNSUPPORTED_PROTOCOL;
+  }
+
   size_t index = bufs->size();
   bufs->push_back(Buffer()); // Placeholder
 
@@ -61,7 +61,8 @@ public:
       , consistency_(CASS_DEFAULT_CONSISTENCY)
       , serial_consistency_(CASS_DEFAULT_SERIAL_CONSISTENCY)
       , request_timeout_ms_(request_timeout_ms)
-      , timestamp_(CASS_INT64_MIN) {}
+      , timestamp_(CASS_INT64_MIN)
+      , is_continuous_paging_(false) {}
 
   void set_prepared_metadata(const PreparedMetadata::Entry::Ptr& entry);
 
@@ -108,6 +109,18 @@ public:
     return prepared_metadata_entry_;
   }
 
+  // Overrides the statement's paging state (used for prefetched pages)
+  const String& paging_state() const { return paging_state_; }
+
+  void set_paging_state(const String& paging_state) { paging_state_ = paging_state; }
+
+  // Requests the results as a continuous stream of pages (DSE only)
+  bool is_continuous_paging() const { return is_continuous_paging_; }
+
+  void set_is_continuous_paging(bool is_continuous_paging) {
+    is_continuous_paging_ = is_continuous_paging;
+  }
+
 private:
   Request::ConstPtr request_;
   CassConsistency consistency_;
@@ -116,6 +129,8 @@ private:
   int64_t timestamp_;
   RetryPolicy::Ptr retry_policy_;
   PreparedMetadata::Entry::Ptr prepared_metadata_entry_;
+  String paging_state_;
+  bool is_continuous_paging_;
 };
 
 class RequestCallback
@@ -153,6 +168,9 @@ protected:
   virtual void on_write(Connection* connection) = 0;
 
 public:
+  // Called after a request has been flushed to the socket
+  virtual void on_flush() {}
+
   // Called to finish a request
   virtual void on_set(ResponseMessage* response) = 0;
   virtual void on_error(CassError code, const String& message) = 0;
@@ -176,6 +194,10 @@ public:
 
   int64_t timestamp() { return wrapper_.timestamp(); }
 
+  const String& paging_state() const { return wrapper_.paging_state(); }
+
+  bool is_continuous_paging() const { return wrapper_.is_continuous_paging(); }
+
   const RetryPolicy::Ptr& retry_policy() { return wrapper_.retry_policy(); }
 
   const PreparedMetadata::Entry::Ptr& prepared_metadata_entry() const {
@@ -27,8 +27,11 @@
 #include "protocol.hpp"
 #include "response.hpp"
 #include "result_response.hpp"
+#include "result_stream.hpp"
+#include "revise_request.hpp"
 #include "row.hpp"
 #include "session.hpp"
+#include "statement.hpp"
 
 #include <uv.h>
 
@@ -127,6 +130,32 @@ void PrepareCallback::on_internal_error(CassError code, const String& message) {
 
 void PrepareCallback::on_internal_timeout() { request_execution_->on_retry_next_host(); }
 
+class ReviseCallback : public SimpleRequestCallback {
+public:
+  ReviseCallback(int32_t revision_type, int32_t stream, int32_t next_pages,
+                 uint64_t request_timeout_ms)
+      : SimpleRequestCallback(
+            Request::ConstPtr(new ReviseRequest(revision_type, stream, next_pages)),
+            request_timeout_ms) {}
+
+private:
+  virtual void on_internal_set(ResponseMessage* response) {
+    if (response->opcode() == CQL_OPCODE_ERROR) {
+      ErrorResponse* error = static_cast<ErrorResponse*>(response->response_body().get());
+      LOG_WARN("Unable to revise continuous paging request: %s",
+               error->message().to_string().c_str());
+    }
+  }
+
+  virtual void on_internal_error(CassError code, const String& message) {
+    LOG_WARN("Unable to revise continuous paging request: %s", message.c_str());
+  }
+
+  virtual void on_internal_timeout() {
+    LOG_WARN("Timed out revising continuous paging request");
+  }
+};
+
 class NopRequestListener : public RequestListener {
 public:
   virtual void on_prepared_metadata_changed(const String& id,
@@ -151,6 +180,13 @@ public:
     return false;
   }
 
+  virtual void on_prefetch_page(const RequestHandler::Ptr& request_handler) {
+    request_handler->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Unable to prefetch page");
+  }
+
+  virtual void on_revise_continuous_paging(const RequestHandler::Ptr& request_handler,
+                                           int32_t revision_type, int32_t next_pages) {}
+
   virtual void on_done() {}
 };
 
@@ -165,7 +201,10 @@ RequestHandler::RequestHandler(const Request::ConstPtr& request, const ResponseF
     , start_time_ns_(uv_hrtime())
     , listener_(&nop_request_listener__)
     , manager_(NULL)
-    , metrics_(metrics) {}
+    , metrics_(metrics)
+    , timings_(metrics && metrics->request_stages && future ? future->enable_timings() : NULL)
+    , prefetch_generation_(0)
+    , is_initialized_(false) {}
 
 RequestHandler::~RequestHandler() {
   if (Logger::log_level() >= CASS_LOG_TRACE) {
@@ -189,6 +228,36 @@ void RequestHandler::set_prepared_metadata(const PreparedMetadata::Entry::Ptr& e
   wrapper_.set_prepared_metadata(entry);
 }
 
+void RequestHandler::set_result_stream(const ResultStream::Ptr& result_stream) {
+  result_stream_ = result_stream;
+  wrapper_.set_is_continuous_paging(true);
+}
+
+void RequestHandler::revise_continuous_paging_async(int32_t revision_type, int32_t next_pages) {
+  RequestListener* listener;
+  {
+    ScopedSpinlock l(SpinlockPool<RequestHandler>::get_spinlock(this));
+    if (!is_initialized_) { // The listener isn't known until the request is initialized
+      pending_revisions_.push_back(Revision(revision_type, next_pages));
+      return;
+    }
+    listener = listener_;
+  }
+  listener->on_revise_continuous_paging(Ptr(this), revision_type, next_pages);
+}
+
+void RequestHandler::revise_continuous_paging(int32_t revision_type, int32_t next_pages) {
+  if (is_done_) return;
+
+  if (continuous_execution_) {
+    continuous_execution_->revise_continuous_paging(revision_type, next_pages);
+  }
+
+  if (revision_type == CASS_REVISION_CANCEL_CONTINUOUS_PAGING) {
+    set_error(CASS_ERROR_LIB_INVALID_STATE, "Continuous paging was cancelled");
+  }
+}
+
 void RequestHandler::init(const ExecutionProfile& profile, ConnectionPoolManager* manager,
                           const TokenMap* token_map, TimestampGenerator* timestamp_generator,
                           RequestListener* listener) {
@@ -210,19 +279,65 @@ void RequestHandler::init(const ExecutionProfile& profile, ConnectionPoolManager
 
   execution_plan_.reset(
       profile.speculative_execution_policy()->new_plan(keyspace, wrapper_.request().get()));
+
+  if (wrapper_.is_continuous_paging()) {
+    RevisionVec revisions;
+    {
+      ScopedSpinlock l(SpinlockPool<RequestHandler>::get_spinlock(this));
+      is_initialized_ = true; // Publishes the listener to the threads revising the request
+      revisions.swap(pending_revisions_);
+    }
+    // This is run on the request's event loop (e.g. a cancellation finishes
+    // the request before it's executed)
+    for (RevisionVec::const_iterator it = revisions.begin(), end = revisions.end(); it != end;
+         ++it) {
+      revise_continuous_paging(it->type, it->next_pages);
+    }
+  }
 }
 
 void RequestHandler::execute() {
-  RequestExecution::Ptr request_execution(new RequestExecution(this));
+  // Executions started while another execution is still running are speculative
+  RequestExecution::Ptr request_execution(new RequestExecution(this, running_executions_ > 0));
   running_executions_++;
   internal_retry(request_execution.get());
 }
 
 void RequestHandler::retry(RequestExecution* request_execution, Protected) {
+  if (continuous_execution_) {
+    // Pages have already been streamed to the application so retrying would
+    // return duplicate rows.
+    set_error(CASS_ERROR_LIB_INVALID_STATE,
+              "Unable to retry a continuous paging request after pages have been received");
+    return;
+  }
   internal_retry(request_execution);
 }
 
-void RequestHandler::start_request(uv_loop_t* loop, Protected) {
+void RequestHandler::set_continuous_page(RequestExecution* request_execution,
+                                         const Response::Ptr& response, Protected) {
+  if (is_done_ || !result_stream_->push(ResultResponse::Ptr(
+                                    static_cast<ResultResponse*>(response.get())))) {
+    // The request has already finished or the application is no longer
+    // interested in the results so stop the server from sending more pages.
+    request_execution->revise_continuous_paging(CASS_REVISION_CANCEL_CONTINUOUS_PAGING, 0);
+    if (!is_done_) {
+      set_error(CASS_ERROR_LIB_INVALID_STATE, "Continuous paging was cancelled");
+    }
+    return;
+  }
+
+  continuous_execution_.reset(request_execution);
+
+  // The request timeout applies to each page
+  if (timer_.is_running()) {
+    timer_.start(timer_.loop(), wrapper_.request_timeout_ms(),
+                 bind_callback(&RequestHandler::on_timeout, this));
+  }
+}
+
+void RequestHandler::start_request(uv_loop_t* loop, const Host::Ptr& current_host, Protected) {
+  last_host_ = current_host;
   if (!timer_.is_running()) {
     uint64_t request_timeout_ms = wrapper_.request_timeout_ms();
     if (request_timeout_ms > 0) { // 0 means no timeout
@@ -237,6 +352,42 @@ int64_t RequestHandler::next_execution(const Host::Ptr& current_host, Protected)
   return execution_plan_->next_execution(current_host);
 }
 
+void RequestHandler::execute_next(Protected) {
+  if (!is_done_ && !execution_plan_->acquire_execution()) {
+    LOG_DEBUG("Skipping speculative execution for request (%p) because the speculative execution "
+              "budget has been exhausted",
+              static_cast<void*>(this));
+    return;
+  }
+  execute();
+}
+
+void RequestHandler::record_execution_latency(const Host::Ptr& current_host, uint64_t latency_ns,
+                                              Protected) {
+  query_plan_->on_execution_latency(current_host, latency_ns);
+  execution_plan_->on_execution_latency(current_host, latency_ns);
+}
+
+void RequestHandler::record_execution_error(const Host::Ptr& current_host, CassError code,
+                                            Protected) {
+  query_plan_->on_execution_error(current_host, code);
+}
+
+void RequestHandler::record_execution_timings(const RequestTimings& timings, Protected) {
+  // The timings of executions that finish after the request is done are ignored
+  if (is_done_ || !timings_) return;
+  for (int i = RequestTimings::STAGE_WRITE_QUEUED; i <= RequestTimings::STAGE_RESPONSE_DECODED;
+       ++i) {
+    timings_->times[i] = timings.times[i];
+  }
+  timings_->is_first_attempt = timings.is_first_attempt;
+}
+
+Metrics::HostMetrics* RequestHandler::host_metrics(const Host::Ptr& current_host, Protected) {
+  if (!metrics_ || !current_host) return NULL;
+  return current_host->metrics();
+}
+
 void RequestHandler::add_attempted_address(const Address& address, Protected) {
   future_->add_attempted_address(address);
 }
@@ -246,8 +397,14 @@ void RequestHandler::notify_result_metadata_changed(const String& prepared_id, c
                                                     const String& result_metadata_id,
                                                     const ResultResponse::ConstPtr& result_response,
                                                     Protected) {
-  PreparedMetadata::Entry::Ptr entry(
-      new PreparedMetadata::Entry(query, keyspace, result_metadata_id, result_response));
+  PreparedMetadata::Entry::Ptr entry(new PreparedMetadata::Entry(
+      query, keyspace, result_metadata_id, result_response,
+      request()->opcode() == CQL_OPCODE_PREPARE ? request()->keyspace() : String()));
+  // Only the first response is used because the future can already be set
+  // when the responses of other executions arrive.
+  if (request()->opcode() == CQL_OPCODE_PREPARE && !future_->prepared_metadata_entry) {
+    future_->prepared_metadata_entry = entry;
+  }
   listener_->on_prepared_metadata_changed(prepared_id, entry);
 }
 
@@ -271,13 +428,29 @@ bool RequestHandler::prepare_all(const Host::Ptr& current_host, const Response::
   return listener_->on_prepare_all(Ptr(this), current_host, response);
 }
 
-void RequestHandler::set_response(const Host::Ptr& host, const Response::Ptr& response) {
+void RequestHandler::set_response(const Host::Ptr& host, const Response::Ptr& response,
+                                  bool is_speculative) {
+  // The next page is reserved before the response is visible to the application and requested
+  // before this request is done so that the request processor isn't able to close in between.
+  if (!future_->ready()) {
+    RequestHandler::Ptr next_page(prefetch_next_page(response));
+    if (next_page) {
+      listener_->on_prefetch_page(next_page);
+    }
+  }
+
   stop_request();
   running_executions_--;
 
   if (future_->set_response(host->address(), response)) {
     if (metrics_) {
-      metrics_->record_request(uv_hrtime() - start_time_ns_);
+      uint64_t latency_ns = uv_hrtime() - start_time_ns_;
+      metrics_->record_request(latency_ns);
+      metrics_->statement_metrics.record(request(), latency_ns);
+      if (timings_) metrics_->request_stages->record(*timings_);
+      if (is_speculative && host->metrics()) {
+        host->metrics()->record_speculative_win();
+      }
     }
   } else {
     // This request is a speculative execution for whom we already processed
@@ -293,6 +466,34 @@ void RequestHandler::set_response(const Host::Ptr& host, const Response::Ptr& re
   }
 }
 
+RequestHandler::Ptr RequestHandler::prefetch_next_page(const Response::Ptr& response) {
+  if (!response || response->opcode() != CQL_OPCODE_RESULT ||
+      (request()->opcode() != CQL_OPCODE_QUERY && request()->opcode() != CQL_OPCODE_EXECUTE)) {
+    return RequestHandler::Ptr();
+  }
+
+  const PagePrefetcher::Ptr& prefetcher =
+      static_cast<const Statement*>(request())->page_prefetcher();
+  const ResultResponse* result = static_cast<const ResultResponse*>(response.get());
+  if (!prefetcher || result->kind() != CASS_RESULT_KIND_ROWS || !result->has_more_pages()) {
+    return RequestHandler::Ptr();
+  }
+
+  String paging_state(result->paging_state().to_string());
+  ResponseFuture::Ptr future(new ResponseFuture());
+  if (!prefetcher->reserve(prefetch_generation_, paging_state, future)) {
+    return RequestHandler::Ptr();
+  }
+
+  // The page's callbacks run the same way as the callbacks of the page that requested it
+  future->set_callback_executor(future_->callback_executor());
+  RequestHandler::Ptr request_handler(new RequestHandler(wrapper_.request(), future, metrics_));
+  request_handler->set_prepared_metadata(wrapper_.prepared_metadata_entry());
+  request_handler->set_paging_state(paging_state);
+  request_handler->set_prefetch_generation(prefetch_generation_);
+  return request_handler;
+}
+
 void RequestHandler::set_error(CassError code, const String& message) {
   stop_request();
   bool skip = (code == CASS_ERROR_LIB_NO_HOSTS_AVAILABLE && --running_executions_ > 0);
@@ -332,6 +533,12 @@ void RequestHandler::stop_timer() { timer_.stop(); }
 void RequestHandler::on_timeout(Timer* timer) {
   if (metrics_) {
     metrics_->request_timeouts.inc();
+    if (last_host_ && last_host_->metrics()) {
+      last_host_->metrics()->record_timeout();
+    }
+  }
+  if (last_host_) {
+    query_plan_->on_execution_error(last_host_, CASS_ERROR_LIB_REQUEST_TIMED_OUT);
   }
   set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Request timed out");
   LOG_DEBUG("Request timed out");
@@ -343,6 +550,9 @@ void RequestHandler::stop_request() {
     is_done_ = true;
   }
   timer_.stop();
+  // Break the reference cycles with the continuous paging execution and stream
+  continuous_execution_.reset();
+  result_stream_.reset();
 }
 
 void RequestHandler::internal_retry(RequestExecution* request_execution) {
@@ -408,19 +618,29 @@ void RequestHandler::internal_retry(RequestExecution* request_execution) {
   }
 }
 
-RequestExecution::RequestExecution(RequestHandler* request_handler)
+RequestExecution::RequestExecution(RequestHandler* request_handler, bool is_speculative)
     : RequestCallback(request_handler->wrapper())
     , request_handler_(request_handler)
     , current_host_(request_handler->next_host(RequestHandler::Protected()))
+    , host_metrics_(NULL)
     , num_retries_(0)
-    , start_time_ns_(uv_hrtime()) {}
+    , is_continuous_paging_cancelled_(false)
+    , is_speculative_(is_speculative)
+    , start_time_ns_(uv_hrtime())
+    , timings_(request_handler->has_timings() ? new RequestTimings() : NULL) {}
 
-void RequestExecution::on_execute_next(Timer* timer) { request_handler_->execute(); }
+void RequestExecution::on_execute_next(Timer* timer) {
+  request_handler_->execute_next(RequestHandler::Protected());
+}
 
 void RequestExecution::on_retry_current_host() { retry_current_host(); }
 
 void RequestExecution::on_retry_next_host() {
   if (current_host_) current_host_->decrement_inflight_requests();
+  if (host_metrics_) {
+    host_metrics_->finish_request();
+    host_metrics_ = NULL;
+  }
   retry_next_host();
 }
 
@@ -438,13 +658,22 @@ void RequestExecution::retry_next_host() {
 
 void RequestExecution::on_write(Connection* connection) {
   assert(current_host_ && "Tried to start on a non-existent host");
+  if (timings_) {
+    if (is_speculative_ || timings_->times[RequestTimings::STAGE_WRITE_QUEUED] != 0) {
+      timings_->is_first_attempt = false; // Speculative or retried
+    }
+    timings_->times[RequestTimings::STAGE_WRITE_QUEUED] = uv_hrtime();
+  }
   current_host_->increment_inflight_requests();
+  host_metrics_ = request_handler_->host_metrics(current_host_, RequestHandler::Protected());
+  if (host_metrics_) host_metrics_->start_request();
   connection_ = connection;
   if (request()->record_attempted_addresses()) {
     request_handler_->add_attempted_address(current_host_->address(), RequestHandler::Protected());
   }
-  request_handler_->start_request(connection->loop(), RequestHandler::Protected());
-  if (request()->is_idempotent()) {
+  request_handler_->start_request(connection->loop(), current_host_, RequestHandler::Protected());
+  // Speculative executions of a continuous paging request would stream duplicate pages
+  if (request()->is_idempotent() && !is_continuous_paging()) {
     int64_t timeout = request_handler_->next_execution(current_host_, RequestHandler::Protected());
     if (timeout == 0) {
       request_handler_->execute();
@@ -455,18 +684,42 @@ void RequestExecution::on_write(Connection* connection) {
   }
 }
 
+void RequestExecution::on_flush() {
+  if (timings_) timings_->times[RequestTimings::STAGE_WRITE_FLUSHED] = uv_hrtime();
+}
+
 void RequestExecution::on_set(ResponseMessage* response) {
   assert(connection_ != NULL);
   assert(current_host_ && "Tried to set on a non-existent host");
 
+  if (timings_) {
+    timings_->times[RequestTimings::STAGE_RESPONSE_RECEIVED] = response->received_time_ns();
+    timings_->times[RequestTimings::STAGE_RESPONSE_DECODED] = uv_hrtime();
+    request_handler_->record_execution_timings(*timings_, RequestHandler::Protected());
+  }
+
+  if (response->has_more_continuous_pages()) {
+    on_continuous_page(response);
+    return;
+  }
+
   current_host_->decrement_inflight_requests();
   Connection* connection = connection_;
+  Metrics::HostMetrics* host_metrics = host_metrics_;
+  host_metrics_ = NULL;
+  if (host_metrics) host_metrics->finish_request();
 
   switch (response->opcode()) {
-    case CQL_OPCODE_RESULT:
+    case CQL_OPCODE_RESULT: {
+      uint64_t latency_ns = uv_hrtime() - start_time_ns_;
+      if (host_metrics) host_metrics->record_latency(latency_ns);
+      request_handler_->record_execution_latency(current_host_, latency_ns,
+                                                 RequestHandler::Protected());
       on_result_response(connection, response);
       break;
+    }
     case CQL_OPCODE_ERROR:
+      if (host_metrics) host_metrics->record_error();
       on_error_response(connection, response);
       break;
     default:
@@ -478,6 +731,11 @@ void RequestExecution::on_set(ResponseMessage* response) {
 
 void RequestExecution::on_error(CassError code, const String& message) {
   if (current_host_) current_host_->decrement_inflight_requests();
+  if (host_metrics_) {
+    host_metrics_->finish_request();
+    host_metrics_->record_error();
+    host_metrics_ = NULL;
+  }
   set_error(code, message);
 }
 
@@ -521,6 +779,38 @@ void RequestExecution::notify_prepared_id_mismatch(const String& expected_id,
   request_handler_->set_error(CASS_ERROR_LIB_UNEXPECTED_RESPONSE, message);
 }
 
+void RequestExecution::revise_continuous_paging(int32_t revision_type, int32_t next_pages) {
+  if (connection_ == NULL || is_continuous_paging_cancelled_) return;
+  if (revision_type == CASS_REVISION_CANCEL_CONTINUOUS_PAGING) {
+    is_continuous_paging_cancelled_ = true;
+  }
+
+  RequestCallback::Ptr callback(
+      new ReviseCallback(revision_type, stream(), next_pages, request_timeout_ms()));
+  if (connection_->write_and_flush(callback) < 0) {
+    LOG_WARN("Unable to write continuous paging revision to host %s",
+             connection_->address_string().c_str());
+  }
+}
+
+void RequestExecution::on_continuous_page(ResponseMessage* response) {
+  ResultResponse* result = static_cast<ResultResponse*>(response->response_body().get());
+
+  if (result->kind() == CASS_RESULT_KIND_ROWS && request()->opcode() == CQL_OPCODE_EXECUTE &&
+      result->no_metadata()) {
+    if (!skip_metadata()) {
+      revise_continuous_paging(CASS_REVISION_CANCEL_CONTINUOUS_PAGING, 0);
+      request_handler_->set_error(current_host_, CASS_ERROR_LIB_UNEXPECTED_RESPONSE,
+                                  "Expected metadata but no metadata in response");
+      return;
+    }
+    result->set_metadata(prepared_metadata_entry()->result()->result_metadata());
+  }
+
+  request_handler_->set_continuous_page(this, response->response_body(),
+                                        RequestHandler::Protected());
+}
+
 void RequestExecution::on_result_response(Connection* connection, ResponseMessage* response) {
   ResultResponse* result = static_cast<ResultResponse*>(response->response_body().get());
 
@@ -579,6 +869,10 @@ void RequestExecution::on_result_response(Connection* connection, ResponseMessag
 void RequestExecution::on_error_response(Connection* connection, ResponseMessage* response) {
   ErrorResponse* error = static_cast<ErrorResponse*>(response->response_body().get());
 
+  request_handler_->record_execution_error(
+      current_host_, static_cast<CassError>(CASS_ERROR(CASS_ERROR_SOURCE_SERVER, error->code())),
+      RequestHandler::Protected());
+
   RetryPolicy::RetryDecision decision = RetryPolicy::RetryDecision::return_error();
 
   switch (error->code()) {
@@ -692,7 +986,7 @@ void RequestExecution::on_error_unprepared(Connection* connection, ErrorResponse
 }
 
 void RequestExecution::set_response(const Response::Ptr& response) {
-  request_handler_->set_response(current_host_, response);
+  request_handler_->set_response(current_host_, response, is_speculative_);
 }
 
 void RequestExecution::set_error(CassError code, const String& message) {
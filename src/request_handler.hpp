@@ -17,23 +17,28 @@
 #ifndef DATASTAX_INTERNAL_REQUEST_HANDLER_HPP
 #define DATASTAX_INTERNAL_REQUEST_HANDLER_HPP
 
+#include "atomic.hpp"
 #include "constants.hpp"
 #include "error_response.hpp"
 #include "future.hpp"
 #include "host.hpp"
 #include "load_balancing.hpp"
 #include "metadata.hpp"
+#include "metrics.hpp"
 #include "prepare_request.hpp"
 #include "request.hpp"
 #include "request_callback.hpp"
+#include "request_timings.hpp"
 #include "response.hpp"
 #include "result_response.hpp"
 #include "retry_policy.hpp"
 #include "scoped_ptr.hpp"
 #include "small_vector.hpp"
 #include "speculative_execution.hpp"
+#include "spin_lock.hpp"
 #include "string.hpp"
 #include "timestamp_generator.hpp"
+#include "vector.hpp"
 
 #include <uv.h>
 
@@ -74,11 +79,13 @@ public:
   typedef SharedRefPtr<ResponseFuture> Ptr;
 
   ResponseFuture()
-      : Future(FUTURE_TYPE_RESPONSE) {}
+      : Future(FUTURE_TYPE_RESPONSE)
+      , callback_invoked_ns_(0) {}
 
   ResponseFuture(const Metadata::SchemaSnapshot& schema_metadata)
       : Future(FUTURE_TYPE_RESPONSE)
-      , schema_metadata(new Metadata::SchemaSnapshot(schema_metadata)) {}
+      , schema_metadata(new Metadata::SchemaSnapshot(schema_metadata))
+      , callback_invoked_ns_(0) {}
 
   bool set_response(Address address, const Response::Ptr& response) {
     ScopedMutex lock(&mutex_);
@@ -132,8 +139,39 @@ public:
     return attempted_addresses_;
   }
 
+  // Request timings are only recorded if they're enabled before the request
+  // is executed.
+  RequestTimings* enable_timings() {
+    timings_.reset(new RequestTimings());
+    return timings_.get();
+  }
+
+  /**
+   * Get the times at which the request reached each stage of its lifecycle.
+   * This waits for the future to be set.
+   *
+   * @param timings The request's timings.
+   * @return false if request timings aren't enabled for the request.
+   */
+  bool timings(RequestTimings* timings) {
+    ScopedMutex lock(&mutex_);
+    internal_wait(lock);
+    if (!timings_) return false;
+    *timings = *timings_;
+    timings->times[RequestTimings::STAGE_CALLBACK_INVOKED] =
+        callback_invoked_ns_.load(MEMORY_ORDER_ACQUIRE);
+    return true;
+  }
+
+  virtual void on_callback_invoked() {
+    // The callback can be run on an application thread after the future is
+    // set so this doesn't use the future's timings.
+    if (timings_) callback_invoked_ns_.store(uv_hrtime(), MEMORY_ORDER_RELEASE);
+  }
+
   PrepareRequest::ConstPtr prepare_request;
   ScopedPtr<Metadata::SchemaSnapshot> schema_metadata;
+  PreparedMetadata::Entry::Ptr prepared_metadata_entry;
 
 private:
   friend class RequestHandler;
@@ -147,16 +185,21 @@ private:
   Address address_;
   Response::Ptr response_;
   AddressVec attempted_addresses_;
+  // Only updated by the request handler before the future is set
+  ScopedPtr<RequestTimings> timings_;
+  Atomic<uint64_t> callback_invoked_ns_;
 };
 
 class RequestExecution;
 class RequestListener;
+class ResultStream;
 
 class RequestHandler : public RefCounted<RequestHandler> {
   friend class Memory;
 
 public:
   typedef SharedRefPtr<RequestHandler> Ptr;
+  typedef Vector<Ptr> Vec;
 
   RequestHandler(const Request::ConstPtr& request, const ResponseFuture::Ptr& future,
                  Metrics* metrics = NULL);
@@ -164,6 +207,25 @@ public:
 
   void set_prepared_metadata(const PreparedMetadata::Entry::Ptr& entry);
 
+  // Used by statements that prefetch pages
+  void set_paging_state(const String& paging_state) { wrapper_.set_paging_state(paging_state); }
+  void set_prefetch_generation(uint64_t generation) { prefetch_generation_ = generation; }
+
+  // Used by statements that stream their pages using continuous paging (DSE only)
+  void set_result_stream(const SharedRefPtr<ResultStream>& result_stream);
+
+  /**
+   * Revise the in-flight continuous paging request. This is thread-safe; the
+   * revision is sent from the request's event loop. Revisions made before the
+   * request processor has initialized the request are applied when it's
+   * initialized.
+   *
+   * @param revision_type Either cancel or request more pages.
+   * @param next_pages The number of additional pages requested.
+   */
+  void revise_continuous_paging_async(int32_t revision_type, int32_t next_pages = 0);
+  void revise_continuous_paging(int32_t revision_type, int32_t next_pages);
+
   void init(const ExecutionProfile& profile, ConnectionPoolManager* manager,
             const TokenMap* token_map, TimestampGenerator* timestamp_generator,
             RequestListener* listener);
@@ -173,6 +235,15 @@ public:
   const RequestWrapper& wrapper() const { return wrapper_; }
   const Request* request() const { return wrapper_.request().get(); }
   CassConsistency consistency() const { return wrapper_.consistency(); }
+  uint64_t start_time_ns() const { return start_time_ns_; }
+
+  bool has_timings() const { return timings_ != NULL; }
+
+  // Record the time the request reached a stage of its lifecycle (if request
+  // timings are enabled).
+  void record_stage(RequestTimings::Stage stage) {
+    if (timings_) timings_->times[stage] = uv_hrtime();
+  }
 
 public:
   class Protected {
@@ -183,10 +254,19 @@ public:
 
   void retry(RequestExecution* request_execution, Protected);
 
+  void set_continuous_page(RequestExecution* request_execution, const Response::Ptr& response,
+                           Protected);
+
   Host::Ptr next_host(Protected);
   int64_t next_execution(const Host::Ptr& current_host, Protected);
+  void execute_next(Protected);
+  void record_execution_latency(const Host::Ptr& current_host, uint64_t latency_ns, Protected);
+  void record_execution_error(const Host::Ptr& current_host, CassError code, Protected);
+  void record_execution_timings(const RequestTimings& timings, Protected);
+
+  Metrics::HostMetrics* host_metrics(const Host::Ptr& current_host, Protected);
 
-  void start_request(uv_loop_t* loop, Protected);
+  void start_request(uv_loop_t* loop, const Host::Ptr& current_host, Protected);
 
   void add_attempted_address(const Address& address, Protected);
 
@@ -202,7 +282,8 @@ public:
 
   bool prepare_all(const Host::Ptr& current_host, const Response::Ptr& response);
 
-  void set_response(const Host::Ptr& host, const Response::Ptr& response);
+  void set_response(const Host::Ptr& host, const Response::Ptr& response,
+                    bool is_speculative = false);
   void set_error(CassError code, const String& message);
   void set_error(const Host::Ptr& host, CassError code, const String& message);
   void set_error_with_error_response(const Host::Ptr& host, const Response::Ptr& error,
@@ -216,8 +297,20 @@ private:
 private:
   void stop_request();
   void internal_retry(RequestExecution* request_execution);
+  RequestHandler::Ptr prefetch_next_page(const Response::Ptr& response);
 
 private:
+  struct Revision {
+    Revision(int32_t type, int32_t next_pages)
+        : type(type)
+        , next_pages(next_pages) {}
+
+    int32_t type;
+    int32_t next_pages;
+  };
+
+  typedef Vector<Revision> RevisionVec;
+
   RequestWrapper wrapper_;
   SharedRefPtr<ResponseFuture> future_;
 
@@ -227,12 +320,21 @@ private:
   ScopedPtr<QueryPlan> query_plan_;
   ScopedPtr<SpeculativeExecutionPlan> execution_plan_;
   Timer timer_;
+  Host::Ptr last_host_; // The host of the most recently started execution
 
   const uint64_t start_time_ns_;
   RequestListener* listener_;
   ConnectionPoolManager* manager_;
 
   Metrics* const metrics_;
+  RequestTimings* const timings_; // Owned by the future (NULL if request timings are disabled)
+  uint64_t prefetch_generation_;
+  SharedRefPtr<ResultStream> result_stream_;
+  SharedRefPtr<RequestExecution> continuous_execution_;
+  // Guarded by the handler's spinlock (continuous paging only) because
+  // revisions are made by application threads.
+  bool is_initialized_;
+  RevisionVec pending_revisions_;
 
   RequestTryVec request_tries_;
 };
@@ -285,6 +387,25 @@ public:
   virtual bool on_prepare_all(const RequestHandler::Ptr& request_handler,
                               const Host::Ptr& current_host, const Response::Ptr& response) = 0;
 
+  /**
+   * A callback called to request the next page of a statement that prefetches
+   * pages.
+   *
+   * @param request_handler The request handler for the next page.
+   */
+  virtual void on_prefetch_page(const RequestHandler::Ptr& request_handler) = 0;
+
+  /**
+   * A callback called, from any thread, to revise an in-flight continuous
+   * paging request on the request handler's event loop.
+   *
+   * @param request_handler The request handler of the continuous paging request.
+   * @param revision_type Either cancel or request more pages.
+   * @param next_pages The number of additional pages requested.
+   */
+  virtual void on_revise_continuous_paging(const RequestHandler::Ptr& request_handler,
+                                           int32_t revision_type, int32_t next_pages) = 0;
+
   virtual void on_done() = 0;
 };
 
@@ -292,7 +413,7 @@ class RequestExecution : public RequestCallback {
 public:
   typedef SharedRefPtr<RequestExecution> Ptr;
 
-  RequestExecution(RequestHandler* request_handler);
+  RequestExecution(RequestHandler* request_handler, bool is_speculative);
 
   const Host::Ptr& current_host() const { return current_host_; }
   void next_host() { current_host_ = request_handler_->next_host(RequestHandler::Protected()); }
@@ -300,6 +421,8 @@ public:
   void notify_result_metadata_changed(const Request* request, ResultResponse* result_response);
   void notify_prepared_id_mismatch(const String& expected_id, const String& received_id);
 
+  void revise_continuous_paging(int32_t revision_type, int32_t next_pages);
+
   virtual void on_retry_current_host();
   virtual void on_retry_next_host();
 
@@ -310,10 +433,12 @@ private:
   void retry_next_host();
 
   virtual void on_write(Connection* connection);
+  virtual void on_flush();
 
   virtual void on_set(ResponseMessage* response);
   virtual void on_error(CassError code, const String& message);
 
+  void on_continuous_page(ResponseMessage* response);
   void on_result_response(Connection* connection, ResponseMessage* response);
   void on_error_response(Connection* connection, ResponseMessage* response);
   void on_error_unprepared(Connection* connection, ErrorResponse* error);
@@ -327,10 +452,14 @@ private:
 private:
   RequestHandler::Ptr request_handler_;
   Host::Ptr current_host_;
+  Metrics::HostMetrics* host_metrics_; // The metrics of the host the request was written to
   Connection* connection_;
   Timer schedule_timer_;
   int num_retries_;
+  bool is_continuous_paging_cancelled_;
+  const bool is_speculative_;
   const uint64_t start_time_ns_;
+  ScopedPtr<RequestTimings> timings_; // The times of this execution's stages (if enabled)
 };
 
 }}} // namespace datastax::internal::core
@@ -118,6 +118,24 @@ private:
   KeyspaceChangedHandler::Ptr handler_;
 };
 
+class ReviseContinuousPaging : public Task {
+public:
+  ReviseContinuousPaging(const RequestHandler::Ptr& request_handler, int32_t revision_type,
+                         int32_t next_pages)
+      : request_handler_(request_handler)
+      , revision_type_(revision_type)
+      , next_pages_(next_pages) {}
+
+  virtual void run(EventLoop* event_loop) {
+    request_handler_->revise_continuous_paging(revision_type_, next_pages_);
+  }
+
+private:
+  const RequestHandler::Ptr request_handler_;
+  const int32_t revision_type_;
+  const int32_t next_pages_;
+};
+
 class NopRequestProcessorListener : public RequestProcessorListener {
 public:
   virtual void on_pool_up(const Address& address) {}
@@ -193,12 +211,15 @@ RequestProcessor::RequestProcessor(RequestProcessorListener* listener, EventLoop
   inc_ref(); // For the connection pool manager
   connection_pool_manager_->set_listener(this);
 
-  // Build/Assign the load balancing policies from the execution profiles
+  // Build/Assign the load balancing and speculative execution policies from the
+  // execution profiles
   default_profile_.build_load_balancing_policy();
+  default_profile_.build_speculative_execution_policy();
   load_balancing_policies_.push_back(default_profile_.load_balancing_policy());
   for (ExecutionProfile::Map::iterator it = profiles_.begin(), end = profiles_.end(); it != end;
        ++it) {
     it->second.build_load_balancing_policy();
+    it->second.build_speculative_execution_policy();
     const LoadBalancingPolicy::Ptr& load_balancing_policy = it->second.load_balancing_policy();
     if (load_balancing_policy) {
       LOG_TRACE("Built load balancing policy for '%s' execution profile", it->first.c_str());
@@ -259,6 +280,7 @@ void RequestProcessor::notify_token_map_updated(const TokenMap::Ptr& token_map)
 
 void RequestProcessor::process_request(const RequestHandler::Ptr& request_handler) {
   request_handler->inc_ref(); // Queue reference
+  request_handler->record_stage(RequestTimings::STAGE_ENQUEUED);
 
   if (request_queue_->enqueue(request_handler.get())) {
     request_count_.fetch_add(1);
@@ -275,6 +297,32 @@ void RequestProcessor::process_request(const RequestHandler::Ptr& request_handle
   }
 }
 
+void RequestProcessor::process_requests(const RequestHandler::Vec& request_handlers, size_t offset,
+                                        size_t count) {
+  size_t enqueued = 0;
+  for (size_t i = offset, end = offset + count; i < end; ++i) {
+    const RequestHandler::Ptr& request_handler(request_handlers[i]);
+    request_handler->inc_ref(); // Queue reference
+    request_handler->record_stage(RequestTimings::STAGE_ENQUEUED);
+    if (request_queue_->enqueue(request_handler.get())) {
+      enqueued++;
+    } else {
+      request_handler->dec_ref();
+      request_handler->set_error(CASS_ERROR_LIB_REQUEST_QUEUE_FULL,
+                                 "The request queue has reached capacity");
+    }
+  }
+
+  if (enqueued > 0) {
+    request_count_.fetch_add(static_cast<int>(enqueued));
+    bool expected = false;
+    if (!is_processing_.load(MEMORY_ORDER_RELAXED) &&
+        is_processing_.compare_exchange_strong(expected, true)) {
+      async_.send();
+    }
+  }
+}
+
 int RequestProcessor::init(Protected) {
   int rc = async_.start(event_loop_->loop(), bind_callback(&RequestProcessor::on_async, this));
   if (rc != 0) return rc;
@@ -387,6 +435,19 @@ bool RequestProcessor::on_prepare_all(const RequestHandler::Ptr& request_handler
   return true;
 }
 
+void RequestProcessor::on_prefetch_page(const RequestHandler::Ptr& request_handler) {
+  if (is_closing_) {
+    request_handler->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Session is closing");
+    return;
+  }
+  process_request(request_handler);
+}
+
+void RequestProcessor::on_revise_continuous_paging(const RequestHandler::Ptr& request_handler,
+                                                   int32_t revision_type, int32_t next_pages) {
+  event_loop_->add(new ReviseContinuousPaging(request_handler, revision_type, next_pages));
+}
+
 void RequestProcessor::on_done() {
 #ifdef CASS_INTERNAL_DIAGNOSTICS
   reads_during_coalesce_++;
@@ -545,6 +606,7 @@ int RequestProcessor::process_requests(uint64_t processing_time) {
   RequestHandler* request_handler = NULL;
   while (request_queue_->dequeue(request_handler)) {
     if (request_handler) {
+      request_handler->record_stage(RequestTimings::STAGE_DEQUEUED);
       const String& profile_name = request_handler->request()->execution_profile_name();
       const ExecutionProfile* profile(execution_profile(profile_name));
       if (profile) {
@@ -553,6 +615,7 @@ int RequestProcessor::process_requests(uint64_t processing_time) {
         }
         request_handler->init(*profile, connection_pool_manager_.get(), token_map_.get(),
                               settings_.timestamp_generator.get(), this);
+        request_handler->record_stage(RequestTimings::STAGE_PLAN_BUILT);
         request_handler->execute();
         processed++;
       } else {
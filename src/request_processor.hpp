@@ -247,6 +247,17 @@ public:
    */
   void process_request(const RequestHandler::Ptr& request_handler);
 
+  /**
+   * Enqueue several requests to be processed. The processor's event loop is
+   * signaled at most once for the whole range of requests.
+   * (thread-safe, asynchronous).
+   *
+   * @param request_handlers
+   * @param offset The index of the first request to enqueue.
+   * @param count The number of requests to enqueue.
+   */
+  void process_requests(const RequestHandler::Vec& request_handlers, size_t offset, size_t count);
+
   /**
    * Get the number of requests the processor is handling
    *
@@ -292,6 +303,9 @@ private:
                                             const Response::Ptr& response);
   virtual bool on_prepare_all(const RequestHandler::Ptr& request_handler,
                               const Host::Ptr& current_host, const Response::Ptr& response);
+  virtual void on_prefetch_page(const RequestHandler::Ptr& request_handler);
+  virtual void on_revise_continuous_paging(const RequestHandler::Ptr& request_handler,
+                                           int32_t revision_type, int32_t next_pages);
   virtual void on_done();
 
 private:
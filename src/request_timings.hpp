@@ -0,0 +1,60 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_REQUEST_TIMINGS_HPP
+#define DATASTAX_INTERNAL_REQUEST_TIMINGS_HPP
+
+#include "allocated.hpp"
+
+#include <stdint.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * The times (from `uv_hrtime()`) at which a request reached each stage of its
+ * lifecycle. A time of zero means the request didn't reach the stage. The
+ * stages that happen on a connection are the ones of the execution whose
+ * response was used.
+ */
+struct RequestTimings : public Allocated {
+  enum Stage {
+    STAGE_ENQUEUED,          // Added to a request processor's queue
+    STAGE_DEQUEUED,          // Removed from the queue by the processor's event loop
+    STAGE_PLAN_BUILT,        // The query plan (and the rest of the request's state) is built
+    STAGE_WRITE_QUEUED,      // Written to a connection's outgoing buffers
+    STAGE_WRITE_FLUSHED,     // The socket write has finished
+    STAGE_RESPONSE_RECEIVED, // The first bytes of the response have been read
+    STAGE_RESPONSE_DECODED,  // The response has been decoded
+    STAGE_CALLBACK_INVOKED,  // The future's callback has started running
+    STAGE_COUNT
+  };
+
+  RequestTimings()
+      : is_first_attempt(true) {
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+      times[i] = 0;
+    }
+  }
+
+  uint64_t times[STAGE_COUNT];
+  // False if the stages on a connection are from a speculative execution or
+  // a retry (the time before it was written includes the earlier attempts).
+  bool is_first_attempt;
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -57,6 +57,12 @@ bool Response::decode_custom_payload(Decoder& decoder) {
 
 bool Response::decode_warnings(Decoder& decoder) { return decoder.decode_warnings(warnings_); }
 
+bool ResponseMessage::has_more_continuous_pages() const {
+  if (opcode_ != CQL_OPCODE_RESULT || !response_body_) return false;
+  const ResultResponse* result = static_cast<const ResultResponse*>(response_body_.get());
+  return result->is_continuous_page() && !result->is_last_continuous_page();
+}
+
 bool ResponseMessage::allocate_body(int8_t opcode) {
   response_body_.reset();
   switch (opcode) {
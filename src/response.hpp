@@ -89,7 +89,8 @@ public:
       , header_buffer_pos_(header_buffer_)
       , is_body_ready_(false)
       , is_body_error_(false)
-      , body_buffer_pos_(NULL) {}
+      , body_buffer_pos_(NULL)
+      , received_time_ns_(0) {}
 
   uint8_t flags() const { return flags_; }
 
@@ -101,6 +102,12 @@ public:
 
   bool is_body_ready() const { return is_body_ready_; }
 
+  uint64_t received_time_ns() const { return received_time_ns_; }
+  void set_received_time_ns(uint64_t time_ns) { received_time_ns_ = time_ns; }
+
+  // A continuous page that's followed by more pages on the same stream
+  bool has_more_continuous_pages() const;
+
   ssize_t decode(const char* input, size_t size);
 
 private:
@@ -123,6 +130,7 @@ private:
   bool is_body_error_;
   Response::Ptr response_body_;
   char* body_buffer_pos_;
+  uint64_t received_time_ns_; // When the first bytes of the response were read
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ResponseMessage);
@@ -189,6 +189,7 @@ private:
 
 void ResultResponse::set_metadata(const ResultMetadata::Ptr& metadata) {
   metadata_ = metadata;
+  first_row_.values.clear(); // The row's values borrow data types from the metadata
   decode_first_row();
 }
 
@@ -196,6 +197,7 @@ bool ResultResponse::decode(Decoder& decoder) {
   protocol_version_ = decoder.protocol_version();
   decoder.set_type("result");
   bool is_valid = false;
+  const char* start = decoder.buffer();
 
   CHECK_RESULT(decoder.decode_int32(kind_));
 
@@ -214,6 +216,9 @@ bool ResultResponse::decode(Decoder& decoder) {
 
     case CASS_RESULT_KIND_PREPARED:
       is_valid = decode_prepared(decoder);
+      if (is_valid) {
+        encoded_prepared_ = StringRef(start, decoder.buffer() - start);
+      }
       break;
 
     case CASS_RESULT_KIND_SCHEMA_CHANGE:
@@ -264,6 +269,11 @@ bool ResultResponse::decode_metadata(Decoder& decoder, ResultMetadata::Ptr* meta
     has_more_pages_ = false;
   }
 
+  if (flags & CASS_RESULT_FLAG_CONTINUOUS_PAGING) {
+    CHECK_RESULT(decoder.decode_int32(continuous_page_number_));
+    is_last_continuous_page_ = (flags & CASS_RESULT_FLAG_LAST_CONTINUOUS_PAGE) != 0;
+  }
+
   if (!(flags & CASS_RESULT_FLAG_NO_METADATA)) {
     bool global_table_spec = flags & CASS_RESULT_FLAG_GLOBAL_TABLESPEC;
 
@@ -311,6 +321,7 @@ bool ResultResponse::decode_rows(Decoder& decoder) {
   CHECK_RESULT(decode_metadata(decoder, &metadata_));
   CHECK_RESULT(decoder.decode_int32(row_count_));
   row_decoder_ = decoder;
+  first_row_.values.clear(); // The row's values borrow data types from the metadata
   CHECK_RESULT(decode_first_row());
   return true;
 }
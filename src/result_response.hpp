@@ -40,6 +40,8 @@ public:
       : Response(CQL_OPCODE_RESULT)
       , kind_(CASS_RESULT_KIND_VOID)
       , has_more_pages_(false)
+      , continuous_page_number_(-1)
+      , is_last_continuous_page_(false)
       , row_count_(0) {
     first_row_.set_result(this);
   }
@@ -50,6 +52,11 @@ public:
 
   bool has_more_pages() const { return has_more_pages_; }
 
+  // Continuous paging (DSE only)
+  bool is_continuous_page() const { return continuous_page_number_ >= 0; }
+  int32_t continuous_page_number() const { return continuous_page_number_; }
+  bool is_last_continuous_page() const { return is_last_continuous_page_; }
+
   int32_t column_count() const { return (metadata_ ? metadata_->column_count() : 0); }
 
   bool no_metadata() const { return !metadata_; }
@@ -63,6 +70,8 @@ public:
   StringRef paging_state() const { return paging_state_; }
   StringRef prepared_id() const { return prepared_id_; }
   StringRef result_metadata_id() const { return result_metadata_id_; }
+  // The encoded body of a prepared result (used to persist prepared statements)
+  StringRef encoded_prepared() const { return encoded_prepared_; }
   StringRef keyspace() const { return keyspace_; }
   StringRef table() const { return table_; }
 
@@ -102,11 +111,14 @@ private:
   int32_t kind_;
   ProtocolVersion protocol_version_;
   bool has_more_pages_; // row data
+  int32_t continuous_page_number_;
+  bool is_last_continuous_page_;
   ResultMetadata::Ptr metadata_;
   ResultMetadata::Ptr result_metadata_;
   StringRef paging_state_;       // row paging
   StringRef prepared_id_;        // prepared result
   StringRef result_metadata_id_; // prepared result, protocol v5/DSEv2
+  StringRef encoded_prepared_;   // prepared result
   StringRef change_;             // schema change
   StringRef keyspace_;           // rows, set keyspace, and schema change
   StringRef table_;              // rows, and schema change
@@ -0,0 +1,178 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "result_stream.hpp"
+
+#include "scoped_lock.hpp"
+#include "session.hpp"
+#include "statement.hpp"
+
+#include <algorithm>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassResultStream* cass_session_execute_continuous(CassSession* session,
+                                                  const CassStatement* statement) {
+  ResultStream::Ptr stream(session->execute_continuous(Request::ConstPtr(statement->from())));
+  stream->inc_ref();
+  return CassResultStream::to(stream.get());
+}
+
+const CassResult* cass_result_stream_next(CassResultStream* stream) {
+  ResultResponse::Ptr page(stream->next());
+  if (!page) return NULL;
+  page->inc_ref();
+  return CassResult::to(page.get());
+}
+
+CassError cass_result_stream_error_code(CassResultStream* stream) {
+  const Future::Error* error = stream->error();
+  return error != NULL ? error->code : CASS_OK;
+}
+
+void cass_result_stream_error_message(CassResultStream* stream, const char** message,
+                                      size_t* message_length) {
+  const Future::Error* error = stream->error();
+  if (error != NULL) {
+    *message = error->message.data();
+    *message_length = error->message.length();
+  } else {
+    *message = "";
+    *message_length = 0;
+  }
+}
+
+void cass_result_stream_free(CassResultStream* stream) {
+  stream->cancel();
+  stream->dec_ref();
+}
+
+} // extern "C"
+
+ResultStream::ResultStream(const ResponseFuture::Ptr& future, int32_t max_enqueued_pages)
+    : future_(future)
+    , max_enqueued_pages_(max_enqueued_pages)
+    , consumed_pages_(0)
+    , is_finished_(false)
+    , is_cancelled_(false)
+    , is_last_page_taken_(false) {
+  uv_mutex_init(&mutex_);
+  uv_cond_init(&cond_);
+}
+
+ResultStream::~ResultStream() {
+  uv_mutex_destroy(&mutex_);
+  uv_cond_destroy(&cond_);
+}
+
+void ResultStream::init(const RequestHandler::Ptr& request_handler) {
+  request_handler_ = request_handler;
+  inc_ref(); // Released when the request finishes
+  future_->set_callback(on_future_set, this);
+}
+
+bool ResultStream::push(const ResultResponse::Ptr& page) {
+  ScopedMutex l(&mutex_);
+  if (is_cancelled_) return false;
+  pages_.push_back(page);
+  uv_cond_signal(&cond_);
+  return true;
+}
+
+ResultResponse::Ptr ResultStream::next() {
+  ScopedMutex l(&mutex_);
+  while (pages_.empty() && !is_finished_ && !is_cancelled_) {
+    uv_cond_wait(&cond_, l.get());
+  }
+
+  if (!pages_.empty()) {
+    ResultResponse::Ptr page(pages_.front());
+    pages_.pop_front();
+
+    // Request more pages from the server once half of the pages it was allowed
+    // to send ahead have been consumed (DSEv2 and higher only).
+    RequestHandler::Ptr request_handler;
+    int32_t next_pages = 0;
+    if (page->protocol_version() >= CASS_PROTOCOL_VERSION_DSEV2 && !is_finished_) {
+      if (++consumed_pages_ >= std::max(max_enqueued_pages_ / 2, 1)) {
+        request_handler = request_handler_;
+        next_pages = consumed_pages_;
+        consumed_pages_ = 0;
+      }
+    }
+    l.unlock();
+
+    if (request_handler) {
+      request_handler->revise_continuous_paging_async(CASS_REVISION_MORE_CONTINUOUS_PAGES,
+                                                      next_pages);
+    }
+    return page;
+  }
+
+  if (is_cancelled_ || is_last_page_taken_) {
+    return ResultResponse::Ptr();
+  }
+  is_last_page_taken_ = true;
+  l.unlock();
+
+  // The final page is the response of the request
+  if (future_->error() != NULL) {
+    return ResultResponse::Ptr();
+  }
+  const Response::Ptr& response(future_->response());
+  if (!response || response->opcode() != CQL_OPCODE_RESULT) {
+    return ResultResponse::Ptr();
+  }
+  ResultResponse::Ptr result(static_cast<ResultResponse*>(response.get()));
+  if (result->kind() != CASS_RESULT_KIND_ROWS) {
+    return ResultResponse::Ptr();
+  }
+  return result;
+}
+
+void ResultStream::cancel() {
+  ScopedMutex l(&mutex_);
+  if (is_cancelled_ || is_finished_) return;
+  is_cancelled_ = true;
+  pages_.clear();
+  RequestHandler::Ptr request_handler(request_handler_);
+  uv_cond_broadcast(&cond_);
+  l.unlock();
+
+  if (request_handler) {
+    request_handler->revise_continuous_paging_async(CASS_REVISION_CANCEL_CONTINUOUS_PAGING);
+  }
+}
+
+Future::Error* ResultStream::error() {
+  if (!future_->ready()) return NULL;
+  return future_->error();
+}
+
+void ResultStream::on_future_set(CassFuture* future, void* data) {
+  ResultStream* stream = static_cast<ResultStream*>(data);
+  {
+    ScopedMutex l(&stream->mutex_);
+    stream->is_finished_ = true;
+    stream->request_handler_.reset();
+    uv_cond_broadcast(&stream->cond_);
+  }
+  stream->dec_ref();
+}
@@ -0,0 +1,108 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_RESULT_STREAM_HPP
+#define DATASTAX_INTERNAL_RESULT_STREAM_HPP
+
+#include "cassandra.h"
+#include "deque.hpp"
+#include "external.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "request_handler.hpp"
+#include "result_response.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+/**
+ * The pages of a continuous paging request (DSE only). Pages are pushed from
+ * the request's event loop as the server streams them and they're taken by
+ * the application in order. The number of pages the server sends ahead of the
+ * application is bounded for DSEv2 and higher by requesting more pages as
+ * pages are consumed.
+ */
+class ResultStream : public RefCounted<ResultStream> {
+public:
+  typedef SharedRefPtr<ResultStream> Ptr;
+
+  ResultStream(const ResponseFuture::Ptr& future,
+               int32_t max_enqueued_pages = CASS_DEFAULT_CONTINUOUS_PAGING_MAX_ENQUEUED_PAGES);
+  ~ResultStream();
+
+  /**
+   * Associate the stream with the request that produces its pages. This must
+   * be called before the request is executed.
+   *
+   * @param request_handler The request handler of the continuous paging request.
+   */
+  void init(const RequestHandler::Ptr& request_handler);
+
+  /**
+   * Add a page to the stream (called from the request's event loop).
+   *
+   * @param page A page that's followed by more pages.
+   * @return false if the stream was cancelled, otherwise true.
+   */
+  bool push(const ResultResponse::Ptr& page);
+
+  /**
+   * Take the next page, blocking until it's available.
+   *
+   * @return The next page or an empty pointer when there are no more pages or
+   * the request failed.
+   */
+  ResultResponse::Ptr next();
+
+  /**
+   * Stop the stream and ask the server to stop sending pages.
+   */
+  void cancel();
+
+  /**
+   * Get the error of the request without blocking.
+   *
+   * @return The error or NULL if the request hasn't finished or succeeded.
+   */
+  Future::Error* error();
+
+private:
+  static void on_future_set(CassFuture* future, void* data);
+
+private:
+  typedef Deque<ResultResponse::Ptr> PageDeque;
+
+  uv_mutex_t mutex_;
+  uv_cond_t cond_;
+  ResponseFuture::Ptr future_;
+  RequestHandler::Ptr request_handler_;
+  PageDeque pages_;
+  const int32_t max_enqueued_pages_;
+  int32_t consumed_pages_;
+  bool is_finished_;
+  bool is_cancelled_;
+  bool is_last_page_taken_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ResultStream);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::ResultStream, CassResultStream)
+
+#endif
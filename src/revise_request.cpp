@@ -0,0 +1,40 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "revise_request.hpp"
+
+#include "serialization.hpp"
+
+using namespace datastax::internal::core;
+
+int ReviseRequest::encode(ProtocolVersion version, RequestCallback* callback,
+                          BufferVec* bufs) const {
+  // <revision_type> [int] <stream> [int] [<next_pages> [int]]
+  size_t length = 2 * sizeof(int32_t);
+  if (revision_type_ == CASS_REVISION_MORE_CONTINUOUS_PAGES) {
+    length += sizeof(int32_t);
+  }
+
+  bufs->push_back(Buffer(length));
+  Buffer& buf = bufs->back();
+  size_t pos = buf.encode_int32(0, revision_type_);
+  pos = buf.encode_int32(pos, target_stream_);
+  if (revision_type_ == CASS_REVISION_MORE_CONTINUOUS_PAGES) {
+    buf.encode_int32(pos, next_pages_);
+  }
+
+  return length;
+}
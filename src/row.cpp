@@ -50,13 +50,14 @@ const CassValue* cass_row_get_column_by_name_n(const CassRow* row, const char* n
 namespace datastax { namespace internal { namespace core {
 
 bool decode_row(Decoder& decoder, const ResultResponse* result, OutputValueVec& output) {
-  output.clear();
-  output.reserve(result->column_count());
-  for (int i = 0; i < result->column_count(); ++i) {
-    Value value;
-    const ColumnDefinition& def = result->metadata()->get_column_definition(i);
-    CHECK_RESULT(decoder.decode_value(def.data_type, value));
-    output.push_back(value);
+  const ResultMetadata* metadata = result->metadata().get();
+  size_t column_count = metadata->column_count();
+  // The values are decoded in place (and reused when iterating) and only
+  // borrow their data types from the result's metadata.
+  output.resize(column_count);
+  for (size_t i = 0; i < column_count; ++i) {
+    const ColumnDefinition& def = metadata->get_column_definition(i);
+    CHECK_RESULT(decoder.decode_borrowed_value(def.data_type, output[i]));
   }
 
   return true;
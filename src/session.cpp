@@ -28,11 +28,47 @@
 #include "prepare_request.hpp"
 #include "request_processor_initializer.hpp"
 #include "scoped_lock.hpp"
+#include "set.hpp"
 #include "statement.hpp"
+#include "statement_template.hpp"
 
 using namespace datastax;
 using namespace datastax::internal::core;
 
+static void copy_dc_name(const String& dc, char* output) {
+  size_t length = std::min(dc.size(), static_cast<size_t>(CASS_METRICS_DC_NAME_LENGTH - 1));
+  memcpy(output, dc.data(), length);
+  output[length] = '\0';
+}
+
+static void copy_latency_snapshot(const Metrics::Histogram::Snapshot& snapshot,
+                                  CassLatencyMetrics* output) {
+  output->count = snapshot.count;
+  output->min = snapshot.min;
+  output->max = snapshot.max;
+  output->mean = snapshot.mean;
+  output->stddev = snapshot.stddev;
+  output->median = snapshot.median;
+  output->percentile_75th = snapshot.percentile_75th;
+  output->percentile_95th = snapshot.percentile_95th;
+  output->percentile_98th = snapshot.percentile_98th;
+  output->percentile_99th = snapshot.percentile_99th;
+  output->percentile_999th = snapshot.percentile_999th;
+}
+
+static void copy_request_metrics(const Metrics::RequestMetrics& metrics,
+                                 CassRequestMetrics* output) {
+  Metrics::Histogram::Snapshot snapshot;
+  metrics.latencies.get_snapshot(&snapshot);
+  copy_latency_snapshot(snapshot, &output->latency);
+
+  int64_t in_flight = metrics.in_flight.sum();
+  output->errors = metrics.errors.sum();
+  output->timeouts = metrics.timeouts.sum();
+  output->in_flight = in_flight > 0 ? in_flight : 0;
+  output->speculative_wins = metrics.speculative_wins.sum();
+}
+
 extern "C" {
 
 CassSession* cass_session_new() {
@@ -93,12 +129,48 @@ CassFuture* cass_session_execute(CassSession* session, const CassStatement* stat
   return CassFuture::to(future.get());
 }
 
+void cass_session_execute_many(CassSession* session, const CassStatement* const* statements,
+                               size_t count, CassFuture** futures) {
+  Request::ConstVec requests;
+  requests.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    requests.push_back(Request::ConstPtr(statements[i]->from()));
+  }
+
+  Future::Vec results;
+  session->execute_many(requests, &results);
+  for (size_t i = 0; i < count; ++i) {
+    results[i]->inc_ref();
+    futures[i] = CassFuture::to(results[i].get());
+  }
+}
+
 CassFuture* cass_session_execute_batch(CassSession* session, const CassBatch* batch) {
   Future::Ptr future(session->execute(Request::ConstPtr(batch->from())));
   future->inc_ref();
   return CassFuture::to(future.get());
 }
 
+CassError cass_session_execute_with_completion_queue(CassSession* session,
+                                                     const CassStatement* statement,
+                                                     CassCompletionQueue* queue, void* tag) {
+  CompletionQueue::Ptr completion_queue(queue->from());
+  if (!completion_queue->reserve()) {
+    return CASS_ERROR_LIB_REQUEST_QUEUE_FULL;
+  }
+  Future::Ptr future(session->execute(Request::ConstPtr(statement->from())));
+  future->set_completion_queue(completion_queue, tag);
+  return CASS_OK;
+}
+
+CassFuture* cass_session_execute_template(CassSession* session,
+                                          const CassStatementTemplate* statement_template) {
+  Future::Ptr future(
+      session->execute(Request::ConstPtr(new ExecuteRequest(statement_template->from()))));
+  future->inc_ref();
+  return CassFuture::to(future.get());
+}
+
 const CassSchemaMeta* cass_session_get_schema_meta(const CassSession* session) {
   return CassSchemaMeta::to(new Metadata::SchemaSnapshot(session->cluster()->schema_snapshot()));
 }
@@ -140,6 +212,62 @@ void cass_session_get_metrics(const CassSession* session, CassMetrics* metrics)
   metrics->errors.request_timeouts = internal_metrics->request_timeouts.sum();
 }
 
+void cass_session_get_windowed_metrics(const CassSession* session, CassMetricsWindow window,
+                                       CassLatencyMetrics* output) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get windowed metrics before connecting session object");
+    memset(output, 0, sizeof(CassLatencyMetrics));
+    return;
+  }
+
+  Metrics::Histogram::Window internal_window;
+  switch (window) {
+    case CASS_METRICS_WINDOW_FIVE_MINUTES:
+      internal_window = Metrics::Histogram::WINDOW_FIVE_MINUTES;
+      break;
+    case CASS_METRICS_WINDOW_FIFTEEN_MINUTES:
+      internal_window = Metrics::Histogram::WINDOW_FIFTEEN_MINUTES;
+      break;
+    default:
+      internal_window = Metrics::Histogram::WINDOW_ONE_MINUTE;
+      break;
+  }
+
+  Metrics::Histogram::Snapshot snapshot;
+  internal_metrics->request_latencies.get_window_snapshot(internal_window, &snapshot);
+  copy_latency_snapshot(snapshot, output);
+}
+
+void cass_session_get_request_stage_metrics(const CassSession* session,
+                                            CassRequestStageMetrics* output) {
+  memset(output, 0, sizeof(CassRequestStageMetrics));
+
+  const Metrics* internal_metrics = session->metrics();
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get request stage metrics before connecting session object");
+    return;
+  }
+
+  const Metrics::RequestStageMetrics* stages = internal_metrics->request_stages.get();
+  if (stages == NULL) return; // Request timings are disabled
+
+  Metrics::Histogram::Snapshot snapshot;
+  stages->queue.get_snapshot(&snapshot);
+  copy_latency_snapshot(snapshot, &output->queue);
+  stages->plan.get_snapshot(&snapshot);
+  copy_latency_snapshot(snapshot, &output->plan);
+  stages->connection.get_snapshot(&snapshot);
+  copy_latency_snapshot(snapshot, &output->connection);
+  stages->write.get_snapshot(&snapshot);
+  copy_latency_snapshot(snapshot, &output->write);
+  stages->server.get_snapshot(&snapshot);
+  copy_latency_snapshot(snapshot, &output->server);
+  stages->decode.get_snapshot(&snapshot);
+  copy_latency_snapshot(snapshot, &output->decode);
+}
+
 void cass_session_get_speculative_execution_metrics(const CassSession* session,
                                                     CassSpeculativeExecutionMetrics* metrics) {
   const Metrics* internal_metrics = session->metrics();
@@ -167,6 +295,124 @@ void cass_session_get_speculative_execution_metrics(const CassSession* session,
   metrics->percentage = internal_metrics->request_rates.speculative_request_percent();
 }
 
+void cass_session_get_outlier_detection_metrics(const CassSession* session,
+                                                CassOutlierDetectionMetrics* metrics) {
+  memset(metrics, 0, sizeof(CassOutlierDetectionMetrics));
+
+  if (!session->cluster()) {
+    LOG_WARN("Attempted to get outlier detection metrics before connecting session object");
+    return;
+  }
+
+  uint64_t now = uv_hrtime();
+  HostMap hosts(session->cluster()->hosts());
+  for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
+    if (it->second->is_ejected(now)) {
+      metrics->ejected_hosts++;
+    }
+    metrics->ejections += it->second->ejection_count();
+  }
+}
+
+void cass_session_get_callback_metrics(const CassSession* session, CassCallbackMetrics* metrics) {
+  session->callback_executor()->get_metrics(metrics);
+}
+
+void cass_session_get_prepare_host_metrics(const CassSession* session,
+                                           CassPrepareHostMetrics* metrics) {
+  memset(metrics, 0, sizeof(CassPrepareHostMetrics));
+
+  if (!session->cluster()) {
+    LOG_WARN("Attempted to get prepare host metrics before connecting session object");
+    return;
+  }
+
+  const PrepareHostMetrics& prepare_host_metrics = session->cluster()->prepare_host_metrics();
+  int64_t hosts_preparing = prepare_host_metrics.hosts_preparing.load();
+  int64_t pending_statements = prepare_host_metrics.pending_statements.load();
+  metrics->hosts_preparing = hosts_preparing > 0 ? hosts_preparing : 0;
+  metrics->pending_statements = pending_statements > 0 ? pending_statements : 0;
+  metrics->prepared_statements = prepare_host_metrics.prepared_statements.load();
+  metrics->failed_statements = prepare_host_metrics.failed_statements.load();
+}
+
+size_t cass_session_get_host_metrics(const CassSession* session, CassHostMetrics* output,
+                                     size_t count) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get host metrics before connecting session object");
+    return 0;
+  }
+
+  Metrics::HostMetrics::Vec hosts;
+  internal_metrics->all_host_metrics(&hosts);
+  for (size_t i = 0; i < hosts.size() && i < count; ++i) {
+    const Metrics::HostMetrics* host = hosts[i].get();
+    CassHostMetrics* metrics = &output[i];
+    metrics->address.address_length = host->address().to_inet(metrics->address.address);
+    metrics->port = host->address().port();
+    copy_dc_name(host->dc(), metrics->dc);
+    copy_request_metrics(host->host_metrics(), &metrics->requests);
+  }
+  return hosts.size();
+}
+
+size_t cass_session_get_dc_metrics(const CassSession* session, CassDcMetrics* output,
+                                   size_t count) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get data center metrics before connecting session object");
+    return 0;
+  }
+
+  Metrics::DcMetricsMap dcs;
+  internal_metrics->all_dc_metrics(&dcs);
+  size_t i = 0;
+  for (Metrics::DcMetricsMap::const_iterator it = dcs.begin(), end = dcs.end();
+       it != end && i < count; ++it, ++i) {
+    copy_dc_name(it->first, output[i].dc);
+    copy_request_metrics(*it->second, &output[i].requests);
+  }
+  return dcs.size();
+}
+
+size_t cass_session_get_statement_metrics(const CassSession* session,
+                                          CassStatementMetricsOrder order,
+                                          CassStatementMetrics* output, size_t count) {
+  const Metrics* internal_metrics = session->metrics();
+
+  if (internal_metrics == NULL) {
+    LOG_WARN("Attempted to get statement metrics before connecting session object");
+    return 0;
+  }
+
+  StatementMetrics::SnapshotVec snapshots;
+  internal_metrics->statement_metrics.get_top(order == CASS_STATEMENT_METRICS_ORDER_TOTAL_TIME
+                                                  ? StatementMetrics::SORT_BY_TOTAL_TIME
+                                                  : StatementMetrics::SORT_BY_P99,
+                                              count, &snapshots);
+  for (size_t i = 0; i < snapshots.size(); ++i) {
+    const StatementMetrics::Snapshot& snapshot = snapshots[i];
+    CassStatementMetrics* metrics = &output[i];
+    size_t length = std::min(snapshot.name.size(),
+                             static_cast<size_t>(CASS_METRICS_STATEMENT_NAME_LENGTH - 1));
+    memcpy(metrics->name, snapshot.name.data(), length);
+    metrics->name[length] = '\0';
+    metrics->count = snapshot.count;
+    metrics->total_time = snapshot.total_time;
+    metrics->min = snapshot.min;
+    metrics->max = snapshot.max;
+    metrics->mean = snapshot.mean;
+    metrics->median = snapshot.median;
+    metrics->percentile_95th = snapshot.percentile_95th;
+    metrics->percentile_99th = snapshot.percentile_99th;
+    metrics->percentile_999th = snapshot.percentile_999th;
+  }
+  return snapshots.size();
+}
+
 CassUuid cass_session_get_client_id(CassSession* session) { return session->client_id(); }
 
 } // extern "C"
@@ -276,7 +522,10 @@ private:
 
 Session::Session()
     : request_processor_count_(0)
-    , is_closing_(false) {
+    , is_closing_(false)
+    , is_keyspace_changed_(false)
+    , default_callback_executor_(new CallbackExecutor())
+    , callback_executor_(default_callback_executor_) {
   uv_mutex_init(&mutex_);
 }
 
@@ -286,14 +535,7 @@ Session::~Session() {
 }
 
 Future::Ptr Session::prepare(const char* statement, size_t length) {
-  PrepareRequest::Ptr prepare(new PrepareRequest(String(statement, length)));
-
-  ResponseFuture::Ptr future(new ResponseFuture(cluster()->schema_snapshot()));
-  future->prepare_request = PrepareRequest::ConstPtr(prepare);
-
-  execute(RequestHandler::Ptr(new RequestHandler(prepare, future, metrics())));
-
-  return future;
+  return prepare(PrepareRequest::Ptr(new PrepareRequest(String(statement, length))));
 }
 
 Future::Ptr Session::prepare(const Statement* statement) {
@@ -311,27 +553,185 @@ Future::Ptr Session::prepare(const Statement* statement) {
   // inherited by bound statements.
   prepare->set_settings(statement->settings());
 
+  return this->prepare(prepare);
+}
+
+Future::Ptr Session::prepare(const PrepareRequest::Ptr& prepare) {
   ResponseFuture::Ptr future(new ResponseFuture(cluster()->schema_snapshot()));
   future->prepare_request = PrepareRequest::ConstPtr(prepare);
+  future->set_callback_executor(callback_executor_);
+
+  ResultResponse::ConstPtr persisted;
+  { // Lock for persisted prepared statements
+    ScopedMutex l(&mutex_);
+    if (!persisted_prepared_.empty()) {
+      // Unqualified queries are prepared in the session's keyspace
+      String keyspace(prepare->keyspace().empty() ? connect_keyspace() : prepare->keyspace());
+      Map<String, PreparedFile::Record>::const_iterator it =
+          persisted_prepared_.find(PreparedCache::key(keyspace, prepare->query()));
+      if (it != persisted_prepared_.end()) {
+        persisted = it->second.result;
+      }
+    }
+  }
+
+  if (persisted) {
+    // The prepared result is immutable so it can be shared by several futures
+    future->prepared_metadata_entry = cluster()->prepared(persisted->prepared_id().to_string());
+    future->set_response(Address(),
+                         ResultResponse::Ptr(const_cast<ResultResponse*>(persisted.get())));
+    return future;
+  }
 
   execute(RequestHandler::Ptr(new RequestHandler(prepare, future, metrics())));
 
   return future;
 }
 
-Future::Ptr Session::execute(const Request::ConstPtr& request) {
+Future::Ptr Session::execute(const Request::ConstPtr& original_request) {
+  Request::ConstPtr request(auto_prepare(original_request));
+  uint64_t prefetch_generation = 0;
+
+  if (request->opcode() == CQL_OPCODE_QUERY || request->opcode() == CQL_OPCODE_EXECUTE) {
+    const Statement* statement = static_cast<const Statement*>(request.get());
+    const PagePrefetcher::Ptr& prefetcher(statement->page_prefetcher());
+    if (prefetcher) {
+      // Use the page if it was already prefetched, otherwise this starts a new
+      // sequence of pages.
+      String deferred_paging_state;
+      Future::Ptr future(prefetcher->take(statement->paging_state(), &prefetch_generation,
+                                          &deferred_paging_state));
+      if (future) {
+        if (!deferred_paging_state.empty()) {
+          ResponseFuture::Ptr next_page(new ResponseFuture());
+          if (prefetcher->reserve(prefetch_generation, deferred_paging_state, next_page)) {
+            RequestHandler::Ptr request_handler(new_request_handler(request, next_page));
+            request_handler->set_paging_state(deferred_paging_state);
+            request_handler->set_prefetch_generation(prefetch_generation);
+            execute(request_handler);
+          }
+        }
+        return future;
+      }
+      prefetch_generation = prefetcher->start();
+    }
+  }
+
+  ResponseFuture::Ptr future(new ResponseFuture());
+  RequestHandler::Ptr request_handler(new_request_handler(request, future));
+  request_handler->set_prefetch_generation(prefetch_generation);
+  execute(request_handler);
+
+  return future;
+}
+
+void Session::execute_many(const Request::ConstVec& requests, Future::Vec* futures) {
+  RequestHandler::Vec request_handlers;
+  request_handlers.reserve(requests.size());
+  futures->reserve(futures->size() + requests.size());
+
+  for (Request::ConstVec::const_iterator it = requests.begin(), end = requests.end(); it != end;
+       ++it) {
+    const Request::ConstPtr& original_request(*it);
+    if (original_request->opcode() == CQL_OPCODE_QUERY ||
+        original_request->opcode() == CQL_OPCODE_EXECUTE) {
+      // Prefetched pages are tracked per statement so they take the regular path
+      const Statement* statement = static_cast<const Statement*>(original_request.get());
+      if (statement->page_prefetcher()) {
+        futures->push_back(execute(original_request));
+        continue;
+      }
+    }
+
+    ResponseFuture::Ptr future(new ResponseFuture());
+    request_handlers.push_back(new_request_handler(auto_prepare(original_request), future));
+    futures->push_back(future);
+  }
+
+  if (request_handlers.empty()) return;
+
+  if (state() != SESSION_STATE_CONNECTED) {
+    for (RequestHandler::Vec::const_iterator it = request_handlers.begin(),
+                                             end = request_handlers.end();
+         it != end; ++it) {
+      (*it)->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Session is not connected");
+    }
+    return;
+  }
+
+  // Split the requests into a contiguous chunk per processor starting with the
+  // least busy processor. See `execute()` for why the processors aren't locked.
+  size_t processor_count = request_processors_.size();
+  size_t index =
+      std::min_element(request_processors_.begin(), request_processors_.end(), least_busy_comp) -
+      request_processors_.begin();
+  size_t chunk_size = (request_handlers.size() + processor_count - 1) / processor_count;
+  for (size_t offset = 0; offset < request_handlers.size(); offset += chunk_size) {
+    size_t count = std::min(chunk_size, request_handlers.size() - offset);
+    request_processors_[index]->process_requests(request_handlers, offset, count);
+    index = (index + 1) % processor_count;
+  }
+}
+
+Request::ConstPtr Session::auto_prepare(const Request::ConstPtr& request) {
+  if (!prepared_cache_ || request->opcode() != CQL_OPCODE_QUERY) {
+    return request;
+  }
+
+  const Statement* statement = static_cast<const Statement*>(request.get());
+  if (!statement->is_cacheable() || statement->has_names_for_values()) {
+    return request;
+  }
+
+  String key(PreparedCache::key(statement));
+  Prepared::ConstPtr prepared(prepared_cache_->find(key));
+  if (prepared) {
+    if (static_cast<size_t>(prepared->result()->column_count()) != statement->elements().size()) {
+      return request; // The values don't match the prepared statement's bind markers
+    }
+    return Request::ConstPtr(new ExecuteRequest(prepared.get(), *statement));
+  }
+
+  // The query is executed as a simple statement while it's being prepared
+  uint64_t generation;
+  if (prepared_cache_->reserve(key, &generation)) {
+    Future::Ptr future(prepare(statement));
+    prepared_cache_->add_when_prepared(
+        ResponseFuture::Ptr(static_cast<ResponseFuture*>(future.get())), key, generation);
+  }
+  return request;
+}
+
+ResultStream::Ptr Session::execute_continuous(const Request::ConstPtr& request) {
   ResponseFuture::Ptr future(new ResponseFuture());
+  ResultStream::Ptr stream(new ResultStream(future));
+  RequestHandler::Ptr request_handler(new_request_handler(request, future));
+  request_handler->set_result_stream(stream);
+  stream->init(request_handler);
+  execute(request_handler);
+  return stream;
+}
 
+RequestHandler::Ptr Session::new_request_handler(const Request::ConstPtr& request,
+                                                 const ResponseFuture::Ptr& future) {
   RequestHandler::Ptr request_handler(new RequestHandler(request, future, metrics()));
+  future->set_callback_executor(callback_executor_);
 
   if (request_handler->request()->opcode() == CQL_OPCODE_EXECUTE) {
     const ExecuteRequest* execute = static_cast<const ExecuteRequest*>(request_handler->request());
-    request_handler->set_prepared_metadata(cluster()->prepared(execute->prepared()->id()));
+    // Avoid looking up the metadata entry (which requires a lock) unless it
+    // has changed since the statement was prepared.
+    PreparedMetadata::Entry::Ptr entry(execute->prepared()->metadata_entry());
+    if (!entry || entry->is_stale()) {
+      entry = cluster()->prepared(execute->prepared()->id());
+    }
+    if (entry) { // Used to prioritize re-preparing the statement on hosts
+      entry->mark_used(request_handler->start_time_ns() / (1000 * 1000));
+    }
+    request_handler->set_prepared_metadata(entry);
   }
 
-  execute(request_handler);
-
-  return future;
+  return request_handler;
 }
 
 void Session::execute(const RequestHandler::Ptr& request_handler) {
@@ -349,6 +749,16 @@ void Session::execute(const RequestHandler::Ptr& request_handler) {
   request_processor->process_request(request_handler);
 }
 
+TokenMap::Ptr Session::token_map() {
+  ScopedMutex l(&mutex_);
+  return token_map_;
+}
+
+CallbackExecutor::Ptr Session::callback_executor() const {
+  ScopedMutex l(&mutex_);
+  return callback_executor_;
+}
+
 void Session::join() {
   if (event_loop_group_) {
     event_loop_group_->close_handles();
@@ -357,6 +767,32 @@ void Session::join() {
   }
 }
 
+void Session::on_connecting() {
+  // The executor is set before any requests can be executed so that it can be
+  // read without a lock when creating their futures.
+  {
+    ScopedMutex l(&mutex_);
+    callback_executor_ =
+        config().callback_executor() ? config().callback_executor() : default_callback_executor_;
+  }
+
+  // The load balancing policies are built for each copy of the config (and
+  // each request processor) so invalid settings are only reported here.
+  if (config().default_profile().is_order_replicas_by_latency_ignored()) {
+    LOG_WARN("Ordering replicas by latency requires latency-aware routing to be enabled "
+             "with a percentile. Replicas won't be ordered by latency.");
+  }
+  for (ExecutionProfile::Map::const_iterator it = config().profiles().begin(),
+                                             end = config().profiles().end();
+       it != end; ++it) {
+    if (it->second.is_order_replicas_by_latency_ignored()) {
+      LOG_WARN("Ordering replicas by latency for execution profile '%s' requires latency-aware "
+               "routing to be enabled with a percentile. Replicas won't be ordered by latency.",
+               it->first.c_str());
+    }
+  }
+}
+
 void Session::on_connect(const Host::Ptr& connected_host, ProtocolVersion protocol_version,
                          const HostMap& hosts, const TokenMap::Ptr& token_map,
                          const String& local_dc) {
@@ -384,6 +820,7 @@ void Session::on_connect(const Host::Ptr& connected_host, ProtocolVersion protoc
 
   for (HostMap::const_iterator it = hosts.begin(), end = hosts.end(); it != end; ++it) {
     const Host::Ptr& host = it->second;
+    host->set_metrics(metrics()->host_metrics(host->address(), host->dc()));
     config().host_listener()->on_host_added(host);
     config().host_listener()->on_host_up(
         host); // If host is down it will be marked down later in the connection process
@@ -392,6 +829,18 @@ void Session::on_connect(const Host::Ptr& connected_host, ProtocolVersion protoc
   request_processors_.clear();
   request_processor_count_ = 0;
   is_closing_ = false;
+  { // Lock for token map
+    ScopedMutex l(&mutex_);
+    token_map_ = token_map;
+  }
+  protocol_version_ = protocol_version;
+  is_keyspace_changed_ = false;
+  load_prepared_statements(protocol_version);
+  if (config().prepared_cache_size() > 0) {
+    prepared_cache_.reset(new PreparedCache(config().prepared_cache_size(), connect_keyspace()));
+  } else {
+    prepared_cache_.reset();
+  }
   SessionInitializer::Ptr initializer(new SessionInitializer(this));
   initializer->initialize(connected_host, protocol_version, hosts, token_map, local_dc);
 }
@@ -399,16 +848,99 @@ void Session::on_connect(const Host::Ptr& connected_host, ProtocolVersion protoc
 void Session::on_close() {
   // If there are request processors still connected those need to be closed
   // first before sending the close notification.
+  PreparedFile::RecordVec records;
+  bool is_saving;
+  {
+    ScopedMutex l(&mutex_);
+    is_closing_ = true;
+    if (request_processor_count_ == 0) {
+      notify_closed();
+      return;
+    }
+    is_saving = prepared_statements_to_save(&records);
+  }
+
+  // Write the file without holding the lock. The request processors are
+  // closed afterwards so the session can't be closed (and freed) meanwhile.
+  if (is_saving) save_prepared_statements(records);
+
   ScopedMutex l(&mutex_);
-  is_closing_ = true;
-  if (request_processor_count_ > 0) {
-    for (RequestProcessor::Vec::const_iterator it = request_processors_.begin(),
-                                               end = request_processors_.end();
-         it != end; ++it) {
-      (*it)->close();
+  for (RequestProcessor::Vec::const_iterator it = request_processors_.begin(),
+                                             end = request_processors_.end();
+       it != end; ++it) {
+    (*it)->close();
+  }
+}
+
+void Session::load_prepared_statements(ProtocolVersion protocol_version) {
+  const String& path = config().prepared_statements_file();
+  PreparedFile::RecordVec records;
+  if (path.empty() || !PreparedFile::read(path, protocol_version, connect_keyspace(), &records)) {
+    return;
+  }
+
+  ScopedMutex l(&mutex_);
+  persisted_prepared_.clear();
+  for (PreparedFile::RecordVec::const_iterator it = records.begin(), end = records.end();
+       it != end; ++it) {
+    // The result metadata can only be skipped if the server is able to
+    // validate it using the result metadata ID.
+    if (protocol_version.supports_result_metadata_id()) {
+      cluster()->prepared(it->result->prepared_id().to_string(),
+                          PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                              it->query, it->keyspace,
+                              it->result->result_metadata_id().to_string(), it->result,
+                              it->keyspace)));
     }
-  } else {
-    notify_closed();
+    persisted_prepared_[PreparedCache::key(it->keyspace, it->query)] = *it;
+  }
+  LOG_INFO("Loaded %u prepared statements from \"%s\"", static_cast<unsigned>(records.size()),
+           path.c_str());
+}
+
+bool Session::prepared_statements_to_save(PreparedFile::RecordVec* records) {
+  const String& path = config().prepared_statements_file();
+  if (path.empty()) return false;
+
+  if (is_keyspace_changed_) {
+    LOG_INFO("Not writing prepared statements to \"%s\" because the session's keyspace changed",
+             path.c_str());
+    return false;
+  }
+
+  Set<String> keys;
+  PreparedMetadata::Entry::Vec entries(cluster()->prepared_metadata_entries());
+  for (PreparedMetadata::Entry::Vec::const_iterator it = entries.begin(), end = entries.end();
+       it != end; ++it) {
+    const PreparedMetadata::Entry::Ptr& entry(*it);
+    // Entries with changed result metadata are prepared again after restarting
+    if (entry->result()->kind() != CASS_RESULT_KIND_PREPARED) continue;
+    // Records are found using the keyspace the statement was prepared in, not
+    // the keyspace of its result metadata (e.g. "ks2" for "SELECT * FROM ks2.t"),
+    // so unqualified statements use the session's keyspace.
+    String keyspace(entry->request_keyspace().empty() ? connect_keyspace()
+                                                      : entry->request_keyspace());
+    if (keys.insert(PreparedCache::key(keyspace, entry->query())).second) {
+      records->push_back(PreparedFile::Record(entry->query(), keyspace, entry->result()));
+    }
+  }
+
+  // Statements from the file that haven't been prepared by this session
+  for (Map<String, PreparedFile::Record>::const_iterator it = persisted_prepared_.begin(),
+                                                         end = persisted_prepared_.end();
+       it != end; ++it) {
+    if (keys.insert(it->first).second) {
+      records->push_back(it->second);
+    }
+  }
+  return true;
+}
+
+void Session::save_prepared_statements(const PreparedFile::RecordVec& records) {
+  const String& path = config().prepared_statements_file();
+  if (PreparedFile::write(path, protocol_version_, connect_keyspace(), records)) {
+    LOG_INFO("Wrote %u prepared statements to \"%s\"", static_cast<unsigned>(records.size()),
+             path.c_str());
   }
 }
 
@@ -433,6 +965,7 @@ void Session::on_host_down(const Host::Ptr& host) {
 }
 
 void Session::on_host_added(const Host::Ptr& host) {
+  host->set_metrics(metrics()->host_metrics(host->address(), host->dc()));
   { // Lock for request processor
     ScopedMutex l(&mutex_);
     for (RequestProcessor::Vec::const_iterator it = request_processors_.begin(),
@@ -453,11 +986,13 @@ void Session::on_host_removed(const Host::Ptr& host) {
       (*it)->notify_host_removed(host);
     }
   }
+  metrics()->remove_host_metrics(host->address());
   config().host_listener()->on_host_removed(host);
 }
 
 void Session::on_token_map_updated(const TokenMap::Ptr& token_map) {
   ScopedMutex l(&mutex_);
+  token_map_ = token_map;
   for (RequestProcessor::Vec::const_iterator it = request_processors_.begin(),
                                              end = request_processors_.end();
        it != end; ++it) {
@@ -494,7 +1029,15 @@ void Session::on_pool_critical_error(const Address& address, Connector::Connecti
 
 void Session::on_keyspace_changed(const String& keyspace,
                                   const KeyspaceChangedHandler::Ptr& handler) {
+  if (prepared_cache_) {
+    prepared_cache_->set_keyspace(keyspace);
+  }
   ScopedMutex l(&mutex_);
+  if (keyspace != connect_keyspace()) {
+    // The persisted statements were prepared in the connect keyspace
+    persisted_prepared_.clear();
+    is_keyspace_changed_ = true;
+  }
   for (RequestProcessor::Vec::const_iterator it = request_processors_.begin(),
                                              end = request_processors_.end();
        it != end; ++it) {
@@ -20,7 +20,10 @@
 #include "allocated.hpp"
 #include "metrics.hpp"
 #include "mpmc_queue.hpp"
+#include "prepared_cache.hpp"
+#include "prepared_file.hpp"
 #include "request_processor.hpp"
+#include "result_stream.hpp"
 #include "session_base.hpp"
 
 #include <uv.h>
@@ -44,14 +47,46 @@ public:
 
   Future::Ptr execute(const Request::ConstPtr& request);
 
+  /**
+   * Execute several requests. The requests are handed off to the request
+   * processors in contiguous chunks so that each processor is signaled at most
+   * once.
+   *
+   * @param requests The requests to execute.
+   * @param futures The resulting futures, in the same order as the requests.
+   */
+  void execute_many(const Request::ConstVec& requests, Future::Vec* futures);
+  ResultStream::Ptr execute_continuous(const Request::ConstPtr& request);
+
+  /**
+   * Get the current token map (thread-safe).
+   *
+   * @return The token map or a null object pointer if token-aware routing
+   * is not available.
+   */
+  TokenMap::Ptr token_map();
+
+  /**
+   * Get the executor that runs the application's callbacks (thread-safe).
+   *
+   * @return The configured callback executor or the default executor that
+   * runs callbacks on the I/O threads.
+   */
+  CallbackExecutor::Ptr callback_executor() const;
+
 private:
   void execute(const RequestHandler::Ptr& request_handler);
 
+  RequestHandler::Ptr new_request_handler(const Request::ConstPtr& request,
+                                          const ResponseFuture::Ptr& future);
+
   void join();
 
 private:
   // Session base methods
 
+  virtual void on_connecting();
+
   virtual void on_connect(const Host::Ptr& connected_host, ProtocolVersion protocol_version,
                           const HostMap& hosts, const TokenMap::Ptr& token_map,
                           const String& local_dc);
@@ -100,12 +135,29 @@ private:
 private:
   friend class SessionInitializer;
 
+  Request::ConstPtr auto_prepare(const Request::ConstPtr& request);
+
+  Future::Ptr prepare(const PrepareRequest::Ptr& prepare);
+
+  void load_prepared_statements(ProtocolVersion protocol_version);
+  // Must be called with the lock held. Returns false if the statements
+  // aren't saved.
+  bool prepared_statements_to_save(PreparedFile::RecordVec* records);
+  void save_prepared_statements(const PreparedFile::RecordVec& records);
+
 private:
   ScopedPtr<RoundRobinEventLoopGroup> event_loop_group_;
-  uv_mutex_t mutex_;
+  mutable uv_mutex_t mutex_;
   RequestProcessor::Vec request_processors_;
   size_t request_processor_count_;
   bool is_closing_;
+  TokenMap::Ptr token_map_;
+  PreparedCache::Ptr prepared_cache_;
+  ProtocolVersion protocol_version_;
+  bool is_keyspace_changed_;
+  Map<String, PreparedFile::Record> persisted_prepared_; // Keyed by keyspace and query
+  CallbackExecutor::Ptr default_callback_executor_; // Runs callbacks on the I/O threads
+  CallbackExecutor::Ptr callback_executor_;
 };
 
 }}} // namespace datastax::internal::core
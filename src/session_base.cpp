@@ -97,7 +97,10 @@ Future::Ptr SessionBase::connect(const Config& config, const String& keyspace) {
     random_.reset();
   }
 
-  metrics_.reset(new Metrics(config.thread_count_io() + 1));
+  metrics_.reset(new Metrics(config.thread_count_io() + 1, config.statement_metrics_size(),
+                             config.request_timings()));
+
+  on_connecting();
 
   cluster_.reset();
   ClusterConnector::Ptr connector(
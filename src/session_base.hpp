@@ -76,6 +76,7 @@ public:
   String connect_keyspace() const { return connect_keyspace_; }
   const Config& config() const { return config_; }
   Cluster::Ptr cluster() const { return cluster_; }
+  EventLoop* event_loop() const { return event_loop_.get(); }
   Random* random() const { return random_.get(); }
   Metrics* metrics() const { return metrics_.get(); }
   State state() const { return state_; }
@@ -101,6 +102,15 @@ protected:
   void notify_closed();
 
 protected:
+  /**
+   * A callback called on the thread calling `connect()` (with the session
+   * locked) before the session starts connecting. The session's
+   * configuration is available and requests can't be executed until the
+   * session is connected so state initialized here doesn't change while
+   * requests are running.
+   */
+  virtual void on_connecting() {}
+
   /**
    * A callback called after the control connection successfully connects.
    * By default this just notifies the connection future. Override to handle
@@ -0,0 +1,83 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "speculative_execution.hpp"
+
+#include "logger.hpp"
+
+#include <algorithm>
+#include <stdlib.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+AdaptiveSpeculativeExecutionPolicy::AdaptiveSpeculativeExecutionPolicy(const Settings& settings)
+    : settings_(settings)
+    , window_start_ns_(uv_hrtime())
+    , delay_ms_(-1)
+    , budget_(0.0)
+    , max_budget_(std::max(100.0, settings.max_speculative_percent * MAX_BUDGET_REQUESTS)) {
+  hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, 3, &histogram_);
+}
+
+AdaptiveSpeculativeExecutionPolicy::~AdaptiveSpeculativeExecutionPolicy() { free(histogram_); }
+
+SpeculativeExecutionPlan* AdaptiveSpeculativeExecutionPolicy::new_plan(const String& keyspace,
+                                                                       const Request* request) {
+  record_request(uv_hrtime());
+  return new AdaptiveSpeculativeExecutionPlan(this);
+}
+
+void AdaptiveSpeculativeExecutionPolicy::record_request(uint64_t now) {
+  roll_window_if_necessary(now);
+  budget_ = std::min(budget_ + settings_.max_speculative_percent, max_budget_);
+}
+
+void AdaptiveSpeculativeExecutionPolicy::record_latency(uint64_t latency_ns, uint64_t now) {
+  roll_window_if_necessary(now);
+  // Final measurement is in microseconds
+  hdr_record_value(histogram_, static_cast<int64_t>(latency_ns / 1000));
+}
+
+bool AdaptiveSpeculativeExecutionPolicy::acquire_execution() {
+  // Only allow a new speculative execution if the requests have added
+  // enough to the budget for a whole execution.
+  if (budget_ < 100.0) {
+    return false;
+  }
+  budget_ -= 100.0;
+  return true;
+}
+
+void AdaptiveSpeculativeExecutionPolicy::roll_window_if_necessary(uint64_t now) {
+  if (now - window_start_ns_ < settings_.window_ms * 1000LL * 1000LL) {
+    return;
+  }
+
+  // Keep accumulating latencies across windows until there are enough
+  // measurements to provide a meaningful percentile.
+  if (static_cast<uint64_t>(histogram_->total_count) >= settings_.min_measured) {
+    int64_t value_us = hdr_lowest_equivalent_value(
+        histogram_, hdr_value_at_percentile(histogram_, settings_.percentile));
+    delay_ms_ = (value_us + 999LL) / 1000LL; // Round up to the nearest millisecond
+    LOG_TRACE("Calculated new speculative execution delay: %lld ms (p%f)",
+              static_cast<long long>(delay_ms_), settings_.percentile);
+    hdr_reset(histogram_);
+  }
+
+  window_start_ns_ = now;
+}
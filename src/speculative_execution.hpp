@@ -19,10 +19,14 @@
 
 #include "allocated.hpp"
 #include "host.hpp"
+#include "macros.hpp"
 #include "ref_counted.hpp"
 #include "string.hpp"
 
+#include "third_party/hdr_histogram/hdr_histogram.hpp"
+
 #include <stdint.h>
+#include <uv.h>
 
 namespace datastax { namespace internal { namespace core {
 
@@ -33,6 +37,22 @@ public:
   virtual ~SpeculativeExecutionPlan() {}
 
   virtual int64_t next_execution(const Host::Ptr& current_host) = 0;
+
+  /**
+   * Called when a scheduled speculative execution is about to be started.
+   *
+   * @return true if the speculative execution should be started, otherwise
+   * it's skipped.
+   */
+  virtual bool acquire_execution() { return true; }
+
+  /**
+   * Called when an execution of the request receives a result response.
+   *
+   * @param host The host that returned the response.
+   * @param latency_ns The latency of the execution in nanoseconds.
+   */
+  virtual void on_execution_latency(const Host::Ptr& host, uint64_t latency_ns) {}
 };
 
 class SpeculativeExecutionPolicy : public RefCounted<SpeculativeExecutionPolicy> {
@@ -93,6 +113,99 @@ public:
   const int max_speculative_executions_;
 };
 
+/**
+ * A speculative execution policy that derives the delay from a configured
+ * percentile of recently observed execution latencies. Latencies are recorded
+ * into a histogram that is rolled over on a fixed window and the number of
+ * speculative executions is capped at a percentage of the requests started.
+ * Each request adds its share to a budget that's carried across windows (up
+ * to a limit) and each speculative execution spends one execution from it.
+ *
+ * The latencies and the budget are per instance, so they're per I/O thread.
+ *
+ * Note: An instance is not thread-safe and is expected to be used by a single
+ * event loop (see ExecutionProfile::build_speculative_execution_policy()).
+ */
+class AdaptiveSpeculativeExecutionPolicy : public SpeculativeExecutionPolicy {
+public:
+  static const int64_t HIGHEST_TRACKABLE_VALUE = 3600LL * 1000LL * 1000LL;
+
+  // The budget saved while there are no speculative executions is limited to
+  // the share of this many requests (or a single execution if it's less).
+  static const int MAX_BUDGET_REQUESTS = 100;
+
+  struct Settings {
+    Settings()
+        : percentile(99.0)
+        , max_speculative_executions(1)
+        , max_speculative_percent(10.0)
+        , window_ms(1000LL)
+        , min_measured(100LL) {}
+
+    double percentile;
+    int max_speculative_executions;
+    double max_speculative_percent;
+    uint64_t window_ms;
+    uint64_t min_measured;
+  };
+
+  AdaptiveSpeculativeExecutionPolicy(const Settings& settings);
+  virtual ~AdaptiveSpeculativeExecutionPolicy();
+
+  virtual SpeculativeExecutionPlan* new_plan(const String& keyspace, const Request* request);
+
+  virtual SpeculativeExecutionPolicy* new_instance() {
+    return new AdaptiveSpeculativeExecutionPolicy(settings_);
+  }
+
+  const Settings& settings() const { return settings_; }
+
+  void record_request(uint64_t now);
+  void record_latency(uint64_t latency_ns, uint64_t now);
+  bool acquire_execution();
+
+public:
+  // Testing only
+  int64_t delay_ms() const { return delay_ms_; }
+
+private:
+  class AdaptiveSpeculativeExecutionPlan : public SpeculativeExecutionPlan {
+  public:
+    // The plan keeps a reference to the policy because a request can
+    // outlive the request processor (and the profile) that started it.
+    AdaptiveSpeculativeExecutionPlan(AdaptiveSpeculativeExecutionPolicy* policy)
+        : policy_(policy)
+        , count_(policy->settings_.max_speculative_executions) {}
+
+    virtual int64_t next_execution(const Host::Ptr& current_host) {
+      return --count_ >= 0 ? policy_->delay_ms_ : -1;
+    }
+
+    virtual bool acquire_execution() { return policy_->acquire_execution(); }
+
+    virtual void on_execution_latency(const Host::Ptr& host, uint64_t latency_ns) {
+      policy_->record_latency(latency_ns, uv_hrtime());
+    }
+
+  private:
+    SharedRefPtr<AdaptiveSpeculativeExecutionPolicy> policy_;
+    int count_;
+  };
+
+  void roll_window_if_necessary(uint64_t now);
+
+private:
+  const Settings settings_;
+  hdr_histogram* histogram_;
+  uint64_t window_start_ns_;
+  int64_t delay_ms_;
+  double budget_;     // In percent of an execution
+  double max_budget_; // In percent of an execution
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(AdaptiveSpeculativeExecutionPolicy);
+};
+
 }}} // namespace datastax::internal::core
 
 #endif
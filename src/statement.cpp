@@ -97,6 +97,24 @@ CassError cass_statement_set_paging_state(CassStatement* statement, const CassRe
   return CASS_OK;
 }
 
+CassError cass_statement_set_prefetch_pages(CassStatement* statement, unsigned pages) {
+  statement->set_prefetch_pages(pages);
+  return CASS_OK;
+}
+
+CassError cass_statement_set_continuous_paging(CassStatement* statement, int max_pages,
+                                               int pages_per_second, int page_size_bytes) {
+  if (max_pages < 0 || pages_per_second < 0 || page_size_bytes < 0) {
+    return CASS_ERROR_LIB_BAD_PARAMS;
+  }
+  ContinuousPagingOptions options;
+  options.max_pages = max_pages;
+  options.pages_per_second = pages_per_second;
+  options.page_size_bytes = page_size_bytes;
+  statement->set_continuous_paging(options);
+  return CASS_OK;
+}
+
 CassError cass_statement_set_paging_state_token(CassStatement* statement, const char* paging_state,
                                                 size_t paging_state_size) {
   statement->set_paging_state(String(paging_state, paging_state_size));
@@ -123,6 +141,14 @@ CassError cass_statement_set_is_idempotent(CassStatement* statement, cass_bool_t
   return CASS_OK;
 }
 
+CassError cass_statement_set_is_cacheable(CassStatement* statement, cass_bool_t is_cacheable) {
+  if (statement->opcode() != CQL_OPCODE_QUERY) {
+    return CASS_ERROR_LIB_INVALID_STATEMENT_TYPE;
+  }
+  statement->set_is_cacheable(is_cacheable == cass_true);
+  return CASS_OK;
+}
+
 CassError cass_statement_set_custom_payload(CassStatement* statement,
                                             const CassCustomPayload* payload) {
   statement->set_custom_payload(payload);
@@ -143,6 +169,20 @@ CassError cass_statement_set_execution_profile_n(CassStatement* statement, const
   return CASS_OK;
 }
 
+CassError cass_statement_set_label(CassStatement* statement, const char* label) {
+  return cass_statement_set_label_n(statement, label, SAFE_STRLEN(label));
+}
+
+CassError cass_statement_set_label_n(CassStatement* statement, const char* label,
+                                     size_t label_length) {
+  if (label_length > 0) {
+    statement->set_label(String(label, label_length));
+  } else {
+    statement->set_label(String());
+  }
+  return CASS_OK;
+}
+
 CassError cass_statement_set_tracing(CassStatement* statement, cass_bool_t enabled) {
   statement->set_tracing(enabled == cass_true);
   return CASS_OK;
@@ -262,6 +302,7 @@ Statement::Statement(const char* query, size_t query_length, size_t values_count
     , AbstractData(values_count)
     , query_or_id_(sizeof(int32_t) + query_length)
     , flags_(0)
+    , is_cacheable_(false)
     , page_size_(-1) {
   // <query> [long string]
   query_or_id_.encode_long_string(0, query, query_length);
@@ -272,6 +313,7 @@ Statement::Statement(const Prepared* prepared)
     , AbstractData(prepared->result()->column_count())
     , query_or_id_(sizeof(uint16_t) + prepared->id().size())
     , flags_(0)
+    , is_cacheable_(false)
     , page_size_(-1) {
   // <id> [short bytes] (or [string])
   const String& id = prepared->id();
@@ -285,6 +327,32 @@ Statement::Statement(const Prepared* prepared)
   }
 }
 
+Statement::Statement(const Prepared* prepared, const Statement& statement)
+    : RoutableRequest(CQL_OPCODE_EXECUTE, statement)
+    , AbstractData(statement.elements())
+    , query_or_id_(sizeof(uint16_t) + prepared->id().size())
+    , flags_(statement.flags_)
+    , is_cacheable_(false)
+    , page_size_(statement.page_size_)
+    , paging_state_(statement.paging_state_)
+    , page_prefetcher_(statement.page_prefetcher_)
+    , continuous_paging_(statement.continuous_paging_) {
+  // <id> [short bytes] (or [string])
+  const String& id = prepared->id();
+  query_or_id_.encode_string(0, id.data(), static_cast<uint16_t>(id.size()));
+  if (keyspace().empty()) {
+    set_keyspace(prepared->result()->quoted_keyspace());
+  }
+}
+
+Statement::Statement(const Buffer& encoded_id)
+    : RoutableRequest(CQL_OPCODE_EXECUTE)
+    , AbstractData(0)
+    , query_or_id_(encoded_id)
+    , flags_(0)
+    , is_cacheable_(false)
+    , page_size_(-1) {}
+
 String Statement::query() const {
   if (opcode() == CQL_OPCODE_QUERY) {
     return String(query_or_id_.data() + sizeof(int32_t), query_or_id_.size() - sizeof(int32_t));
@@ -351,6 +419,22 @@ bool Statement::with_keyspace(ProtocolVersion version) const {
 // <flags> is a [byte] (or [int] for protocol v5)
 // <n> is a [short]
 
+const String& Statement::paging_state(RequestCallback* callback) const {
+  // Prefetched pages override the paging state of the statement
+  const String& paging_state = callback->paging_state();
+  return paging_state.empty() ? paging_state_ : paging_state;
+}
+
+int32_t Statement::page_size(RequestCallback* callback) const {
+  if (callback->is_continuous_paging()) {
+    if (continuous_paging_.page_size_bytes > 0) {
+      return continuous_paging_.page_size_bytes;
+    }
+    return page_size_ > 0 ? page_size_ : CASS_DEFAULT_CONTINUOUS_PAGING_PAGE_SIZE;
+  }
+  return page_size_;
+}
+
 int32_t Statement::encode_query_or_id(BufferVec* bufs) const {
   bufs->push_back(query_or_id_);
   return query_or_id_.size();
@@ -379,11 +463,18 @@ int32_t Statement::encode_begin(ProtocolVersion version, uint16_t element_count,
     flags |= CASS_QUERY_FLAG_VALUES;
   }
 
-  if (page_size() > 0) {
+  if (page_size(callback) > 0) {
     flags |= CASS_QUERY_FLAG_PAGE_SIZE;
   }
 
-  if (!paging_state().empty()) {
+  if (callback->is_continuous_paging()) {
+    flags |= CASS_QUERY_FLAG_CONTINUOUS_PAGING;
+    if (continuous_paging_.page_size_bytes > 0) {
+      flags |= CASS_QUERY_FLAG_PAGE_SIZE_BYTES;
+    }
+  }
+
+  if (!paging_state(callback).empty()) {
     flags |= CASS_QUERY_FLAG_PAGING_STATE;
   }
 
@@ -444,25 +535,30 @@ int32_t Statement::encode_values(ProtocolVersion version, RequestCallback* callb
 }
 
 // Format: [<result_page_size>][<paging_state>][<serial_consistency>][<timestamp>]
+//         [<keyspace>][<max_pages><pages_per_second>[<next_pages>]]
 // where:
 // <result_page_size> is a [int]
 // <paging_state> is a [bytes]
 // <serial_consistency> is a [short]
 // <timestamp> is a [long]
 // <keyspace> is a [string]
+// <max_pages>, <pages_per_second> and <next_pages> (DSEv2) are [int] (continuous paging)
 int32_t Statement::encode_end(ProtocolVersion version, RequestCallback* callback,
                               BufferVec* bufs) const {
   int32_t length = 0;
   size_t paging_buf_size = 0;
 
   bool with_keyspace = this->with_keyspace(version);
+  const String& paging_state = this->paging_state(callback);
+  int32_t page_size = this->page_size(callback);
+  bool is_continuous_paging = callback->is_continuous_paging();
 
-  if (page_size() > 0) {
+  if (page_size > 0) {
     paging_buf_size += sizeof(int32_t); // [int]
   }
 
-  if (!paging_state().empty()) {
-    paging_buf_size += sizeof(int32_t) + paging_state().size(); // [bytes]
+  if (!paging_state.empty()) {
+    paging_buf_size += sizeof(int32_t) + paging_state.size(); // [bytes]
   }
 
   if (callback->serial_consistency() != 0) {
@@ -477,6 +573,13 @@ int32_t Statement::encode_end(ProtocolVersion version, RequestCallback* callback
     paging_buf_size += sizeof(uint16_t) + keyspace().size();
   }
 
+  if (is_continuous_paging) {
+    paging_buf_size += 2 * sizeof(int32_t); // [int][int]
+    if (version >= CASS_PROTOCOL_VERSION_DSEV2) {
+      paging_buf_size += sizeof(int32_t); // [int]
+    }
+  }
+
   if (paging_buf_size > 0) {
     bufs->push_back(Buffer(paging_buf_size));
     length += paging_buf_size;
@@ -484,12 +587,12 @@ int32_t Statement::encode_end(ProtocolVersion version, RequestCallback* callback
     Buffer& buf = bufs->back();
     size_t pos = 0;
 
-    if (page_size() >= 0) {
-      pos = buf.encode_int32(pos, page_size());
+    if (page_size > 0) {
+      pos = buf.encode_int32(pos, page_size);
     }
 
-    if (!paging_state().empty()) {
-      pos = buf.encode_bytes(pos, paging_state().data(), paging_state().size());
+    if (!paging_state.empty()) {
+      pos = buf.encode_bytes(pos, paging_state.data(), paging_state.size());
     }
 
     if (callback->serial_consistency() != 0) {
@@ -503,6 +606,15 @@ int32_t Statement::encode_end(ProtocolVersion version, RequestCallback* callback
     if (with_keyspace) {
       pos = buf.encode_string(pos, keyspace().data(), static_cast<uint16_t>(keyspace().size()));
     }
+
+    if (is_continuous_paging) {
+      pos = buf.encode_int32(pos, continuous_paging_.max_pages);
+      pos = buf.encode_int32(pos, continuous_paging_.pages_per_second);
+      if (version >= CASS_PROTOCOL_VERSION_DSEV2) {
+        // The number of pages the server sends before waiting for more to be requested
+        pos = buf.encode_int32(pos, CASS_DEFAULT_CONTINUOUS_PAGING_MAX_ENQUEUED_PAGES);
+      }
+    }
   }
 
   return length;
@@ -21,6 +21,7 @@
 #include "constants.hpp"
 #include "external.hpp"
 #include "macros.hpp"
+#include "page_prefetcher.hpp"
 #include "prepared.hpp"
 #include "request.hpp"
 #include "result_metadata.hpp"
@@ -34,6 +35,17 @@ namespace datastax { namespace internal { namespace core {
 
 class RequestCallback;
 
+struct ContinuousPagingOptions {
+  ContinuousPagingOptions()
+      : max_pages(0)
+      , pages_per_second(0)
+      , page_size_bytes(0) {}
+
+  int32_t max_pages;        // 0 means no limit
+  int32_t pages_per_second; // 0 means no limit
+  int32_t page_size_bytes;  // 0 means the page size is in rows
+};
+
 class Statement
     : public RoutableRequest
     , public AbstractData {
@@ -44,6 +56,14 @@ public:
 
   Statement(const Prepared* prepared);
 
+  // Creates a bound statement with the values and options of a simple
+  // statement that uses the prepared statement's query.
+  Statement(const Prepared* prepared, const Statement& statement);
+
+  // Creates a bound statement without any elements that shares the encoded
+  // prepared ID. The values are encoded separately (by a statement template).
+  Statement(const Buffer& encoded_id);
+
   virtual ~Statement() {}
 
   // Used to get the original query string from a simple statement. To get the
@@ -61,6 +81,12 @@ public:
 
   bool has_names_for_values() const { return (flags_ & CASS_QUERY_FLAG_NAMES_FOR_VALUES) != 0; }
 
+  // Simple statements executed as bound statements using the session's
+  // prepared statement cache.
+  bool is_cacheable() const { return is_cacheable_; }
+
+  void set_is_cacheable(bool is_cacheable) { is_cacheable_ = is_cacheable; }
+
   int32_t page_size() const { return page_size_; }
 
   void set_page_size(int32_t page_size) { page_size_ = page_size; }
@@ -69,6 +95,18 @@ public:
 
   void set_paging_state(const String& paging_state) { paging_state_ = paging_state; }
 
+  const PagePrefetcher::Ptr& page_prefetcher() const { return page_prefetcher_; }
+
+  void set_prefetch_pages(unsigned pages) {
+    page_prefetcher_.reset(pages > 0 ? new PagePrefetcher(pages) : NULL);
+  }
+
+  const ContinuousPagingOptions& continuous_paging() const { return continuous_paging_; }
+
+  void set_continuous_paging(const ContinuousPagingOptions& options) {
+    continuous_paging_ = options;
+  }
+
   uint8_t kind() const {
     return opcode() == CQL_OPCODE_QUERY ? CASS_BATCH_KIND_QUERY : CASS_BATCH_KIND_PREPARED;
   }
@@ -84,6 +122,10 @@ public:
 protected:
   bool with_keyspace(ProtocolVersion version) const;
 
+  const String& paging_state(RequestCallback* callback) const;
+
+  int32_t page_size(RequestCallback* callback) const;
+
   int32_t encode_query_or_id(BufferVec* bufs) const;
   int32_t encode_begin(ProtocolVersion version, uint16_t element_count, RequestCallback* callback,
                        BufferVec* bufs) const;
@@ -95,8 +137,11 @@ protected:
 private:
   Buffer query_or_id_;
   int32_t flags_;
+  bool is_cacheable_;
   int32_t page_size_;
   String paging_state_;
+  PagePrefetcher::Ptr page_prefetcher_;
+  ContinuousPagingOptions continuous_paging_;
   Vector<size_t> key_indices_;
 
 private:
@@ -0,0 +1,144 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "statement_metrics.hpp"
+
+#include "constants.hpp"
+#include "execute_request.hpp"
+#include "scoped_lock.hpp"
+
+#include <algorithm>
+#include <stdlib.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+namespace {
+
+// Statement latencies are tracked up to a minute (in microseconds) with two
+// significant figures to bound the memory used for each statement.
+const int64_t HIGHEST_TRACKABLE_VALUE = 60LL * 1000LL * 1000LL;
+const int SIGNIFICANT_FIGURES = 2;
+
+bool compare_p99(const StatementMetrics::Snapshot& lhs, const StatementMetrics::Snapshot& rhs) {
+  return lhs.percentile_99th > rhs.percentile_99th;
+}
+
+bool compare_total_time(const StatementMetrics::Snapshot& lhs,
+                        const StatementMetrics::Snapshot& rhs) {
+  return lhs.total_time > rhs.total_time;
+}
+
+} // namespace
+
+StatementMetrics::Entry::Entry(const String& key, const String& name)
+    : key(key)
+    , name(name)
+    , total_time(0) {
+  hdr_init(1LL, HIGHEST_TRACKABLE_VALUE, SIGNIFICANT_FIGURES, &histogram);
+}
+
+StatementMetrics::Entry::~Entry() { free(histogram); }
+
+StatementMetrics::StatementMetrics(size_t capacity)
+    : capacity_(capacity) {
+  uv_mutex_init(&mutex_);
+}
+
+StatementMetrics::~StatementMetrics() {
+  while (!lru_.is_empty()) {
+    delete lru_.pop_front();
+  }
+  uv_mutex_destroy(&mutex_);
+}
+
+void StatementMetrics::record(const Request* request, uint64_t latency_ns) {
+  if (capacity_ == 0) return;
+
+  // Final measurement is in microseconds
+  int64_t latency_us = static_cast<int64_t>(latency_ns / 1000);
+
+  const String& label = request->label();
+  if (!label.empty()) {
+    String key("L");
+    key.append(label);
+    record(key, label, latency_us);
+  } else if (request->opcode() == CQL_OPCODE_EXECUTE) {
+    const Prepared::ConstPtr& prepared = static_cast<const ExecuteRequest*>(request)->prepared();
+    String key("P");
+    key.append(prepared->id());
+    record(key, prepared->query(), latency_us);
+  }
+}
+
+void StatementMetrics::record(const String& key, const String& name, int64_t latency_us) {
+  ScopedMutex l(&mutex_);
+
+  Entry* entry;
+  EntryMap::iterator it = entries_.find(key);
+  if (it != entries_.end()) {
+    entry = it->second;
+    lru_.remove(entry);
+  } else {
+    if (entries_.size() >= capacity_) {
+      Entry* lru = lru_.back();
+      lru_.remove(lru);
+      entries_.erase(lru->key);
+      delete lru;
+    }
+    entry = new Entry(key, name);
+    entries_[key] = entry;
+  }
+  lru_.add_to_front(entry);
+
+  hdr_record_value(entry->histogram, std::min(latency_us, HIGHEST_TRACKABLE_VALUE));
+  entry->total_time += latency_us;
+}
+
+void StatementMetrics::get_top(SortOrder order, size_t count, SnapshotVec* output) const {
+  SnapshotVec snapshots;
+  {
+    ScopedMutex l(&mutex_);
+    snapshots.reserve(entries_.size());
+    for (EntryMap::const_iterator it = entries_.begin(), end = entries_.end(); it != end; ++it) {
+      const Entry* entry = it->second;
+      hdr_histogram* h = entry->histogram;
+      Snapshot snapshot;
+      snapshot.name = entry->name;
+      snapshot.count = h->total_count;
+      snapshot.total_time = entry->total_time;
+      snapshot.min = hdr_min(h);
+      snapshot.max = hdr_max(h);
+      snapshot.mean = static_cast<int64_t>(hdr_mean(h));
+      snapshot.median = hdr_value_at_percentile(h, 50.0);
+      snapshot.percentile_95th = hdr_value_at_percentile(h, 95.0);
+      snapshot.percentile_99th = hdr_value_at_percentile(h, 99.0);
+      snapshot.percentile_999th = hdr_value_at_percentile(h, 99.9);
+      snapshots.push_back(snapshot);
+    }
+  }
+
+  count = std::min(count, snapshots.size());
+  std::partial_sort(snapshots.begin(), snapshots.begin() + count, snapshots.end(),
+                    order == SORT_BY_P99 ? compare_p99 : compare_total_time);
+  output->assign(snapshots.begin(), snapshots.begin() + count);
+}
+
+size_t StatementMetrics::size() const {
+  ScopedMutex l(&mutex_);
+  return entries_.size();
+}
@@ -0,0 +1,121 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_STATEMENT_METRICS_HPP
+#define DATASTAX_INTERNAL_STATEMENT_METRICS_HPP
+
+#include "allocated.hpp"
+#include "list.hpp"
+#include "macros.hpp"
+#include "map.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+
+#include "third_party/hdr_histogram/hdr_histogram.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+class Request;
+
+/**
+ * Latency statistics for individual statements. Statements are identified by
+ * their label or, if they don't have one, by their prepared ID. The number of
+ * statements is bounded and the least recently executed statement is evicted
+ * when a new statement is recorded and the statistics are full.
+ */
+class StatementMetrics {
+public:
+  enum SortOrder { SORT_BY_P99, SORT_BY_TOTAL_TIME };
+
+  struct Snapshot {
+    String name;
+    int64_t count;
+    int64_t total_time;
+    int64_t min;
+    int64_t max;
+    int64_t mean;
+    int64_t median;
+    int64_t percentile_95th;
+    int64_t percentile_99th;
+    int64_t percentile_999th;
+  };
+
+  typedef Vector<Snapshot> SnapshotVec;
+
+  /**
+   * Constructor.
+   *
+   * @param capacity The maximum number of statements. A value of 0 disables
+   * the statistics.
+   */
+  StatementMetrics(size_t capacity);
+  ~StatementMetrics();
+
+  bool is_enabled() const { return capacity_ > 0; }
+
+  /**
+   * Record the latency of a request. Requests without a label that aren't
+   * bound statements are ignored.
+   *
+   * @param request The request.
+   * @param latency_ns The latency of the request in nanoseconds.
+   */
+  void record(const Request* request, uint64_t latency_ns);
+
+  /**
+   * Get the statements with the highest latencies.
+   *
+   * @param order How the statements are ranked.
+   * @param count The maximum number of statements.
+   * @param output The statements ordered from the highest to the lowest
+   * latency.
+   */
+  void get_top(SortOrder order, size_t count, SnapshotVec* output) const;
+
+  size_t size() const;
+
+private:
+  struct Entry
+      : public List<Entry>::Node
+      , public Allocated {
+    Entry(const String& key, const String& name);
+    ~Entry();
+
+    const String key;
+    const String name;
+    hdr_histogram* histogram;
+    int64_t total_time;
+  };
+
+  typedef Map<String, Entry*> EntryMap;
+
+  void record(const String& key, const String& name, int64_t latency_us);
+
+private:
+  mutable uv_mutex_t mutex_;
+  const size_t capacity_;
+  EntryMap entries_;
+  List<Entry> lru_; // Most recently used first
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(StatementMetrics);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
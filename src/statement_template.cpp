@@ -0,0 +1,232 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "statement_template.hpp"
+
+#include "abstract_data.hpp"
+#include "serialization.hpp"
+
+#include <string.h>
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassStatementTemplate* cass_statement_template_new(const CassPrepared* prepared) {
+  return CassStatementTemplate::to(new StatementTemplate(Prepared::ConstPtr(prepared)));
+}
+
+void cass_statement_template_free(CassStatementTemplate* statement_template) {
+  delete statement_template->from();
+}
+
+CassError cass_statement_template_set_consistency(CassStatementTemplate* statement_template,
+                                                  CassConsistency consistency) {
+  statement_template->set_consistency(consistency);
+  return CASS_OK;
+}
+
+CassError cass_statement_template_set_is_idempotent(CassStatementTemplate* statement_template,
+                                                    cass_bool_t is_idempotent) {
+  statement_template->set_is_idempotent(is_idempotent == cass_true);
+  return CASS_OK;
+}
+
+CassError cass_statement_template_bind_null(CassStatementTemplate* statement_template,
+                                            size_t index) {
+  return statement_template->set(index, CassNull());
+}
+
+#define CASS_STATEMENT_TEMPLATE_BIND(Name, Type)                                           \
+  CassError cass_statement_template_bind_##Name(CassStatementTemplate* statement_template, \
+                                                size_t index, Type value) {               \
+    return statement_template->set(index, value);                                         \
+  }
+
+CASS_STATEMENT_TEMPLATE_BIND(int8, cass_int8_t)
+CASS_STATEMENT_TEMPLATE_BIND(int16, cass_int16_t)
+CASS_STATEMENT_TEMPLATE_BIND(int32, cass_int32_t)
+CASS_STATEMENT_TEMPLATE_BIND(uint32, cass_uint32_t)
+CASS_STATEMENT_TEMPLATE_BIND(int64, cass_int64_t)
+CASS_STATEMENT_TEMPLATE_BIND(float, cass_float_t)
+CASS_STATEMENT_TEMPLATE_BIND(double, cass_double_t)
+CASS_STATEMENT_TEMPLATE_BIND(bool, cass_bool_t)
+CASS_STATEMENT_TEMPLATE_BIND(uuid, CassUuid)
+CASS_STATEMENT_TEMPLATE_BIND(inet, CassInet)
+
+#undef CASS_STATEMENT_TEMPLATE_BIND
+
+CassError cass_statement_template_bind_string(CassStatementTemplate* statement_template,
+                                              size_t index, const char* value) {
+  return cass_statement_template_bind_string_n(statement_template, index, value,
+                                               SAFE_STRLEN(value));
+}
+
+CassError cass_statement_template_bind_string_n(CassStatementTemplate* statement_template,
+                                                size_t index, const char* value,
+                                                size_t value_length) {
+  return statement_template->set(index, CassString(value, value_length));
+}
+
+CassError cass_statement_template_bind_bytes(CassStatementTemplate* statement_template,
+                                             size_t index, const cass_byte_t* value,
+                                             size_t value_size) {
+  return statement_template->set(index, CassBytes(value, value_size));
+}
+
+} // extern "C"
+
+StatementTemplate::StatementTemplate(const Prepared::ConstPtr& prepared)
+    : prepared_(prepared)
+    , encoded_id_(sizeof(uint16_t) + prepared->id().size())
+    , settings_(prepared->request_settings())
+    , slots_(prepared->result()->column_count())
+    , unset_count_(slots_.size()) {
+  // <id> [short bytes] (or [string])
+  const String& id = prepared->id();
+  encoded_id_.encode_string(0, id.data(), static_cast<uint16_t>(id.size()));
+
+  // If the keyspace wasn't explictly set then attempt to set it using the
+  // prepared statement's result metadata.
+  if (settings_.keyspace.empty()) {
+    settings_.keyspace = prepared->result()->quoted_keyspace();
+  }
+
+  // All the values start out as unset [bytes]
+  values_.resize(slots_.size() * sizeof(int32_t));
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    slots_[i].offset = i * sizeof(int32_t);
+    slots_[i].size = -2;
+    encode_int32(&values_[slots_[i].offset], -2);
+  }
+}
+
+Buffer StatementTemplate::encode_values() const {
+  Buffer buf(values_.size());
+  if (!values_.empty()) {
+    buf.copy(0, &values_[0], values_.size());
+  }
+  return buf;
+}
+
+bool StatementTemplate::get_routing_key(String* routing_key) const {
+  const Vector<size_t>& key_indices(prepared_->key_indices());
+  if (key_indices.empty()) return false;
+
+  for (Vector<size_t>::const_iterator it = key_indices.begin(), end = key_indices.end();
+       it != end; ++it) {
+    if (*it >= slots_.size() || slots_[*it].size < 0) return false;
+  }
+
+  if (key_indices.size() == 1) {
+    const Slot& slot(slots_[key_indices.front()]);
+    routing_key->assign(&values_[0] + slot.offset + sizeof(int32_t), slot.size);
+  } else {
+    routing_key->clear();
+    for (Vector<size_t>::const_iterator it = key_indices.begin(), end = key_indices.end();
+         it != end; ++it) {
+      const Slot& slot(slots_[*it]);
+      char size_buf[sizeof(uint16_t)];
+      encode_uint16(size_buf, static_cast<uint16_t>(slot.size));
+      routing_key->append(size_buf, sizeof(uint16_t));
+      routing_key->append(&values_[0] + slot.offset + sizeof(int32_t), slot.size);
+      routing_key->push_back(0);
+    }
+  }
+
+  return true;
+}
+
+CassError StatementTemplate::set(size_t index, CassNull value) {
+  CASS_CHECK_INDEX_AND_TYPE(index, value);
+  reserve(index, -1);
+  return CASS_OK;
+}
+
+#define SET_FIXED_TYPE(Type, Encode)                             \
+  CassError StatementTemplate::set(size_t index, Type value) { \
+    CASS_CHECK_INDEX_AND_TYPE(index, value);                   \
+    Encode(reserve(index, sizeof(Type)), value);               \
+    return CASS_OK;                                            \
+  }
+
+SET_FIXED_TYPE(cass_int8_t, encode_int8)
+SET_FIXED_TYPE(cass_int16_t, encode_int16)
+SET_FIXED_TYPE(cass_int32_t, encode_int32)
+SET_FIXED_TYPE(cass_uint32_t, encode_uint32)
+SET_FIXED_TYPE(cass_int64_t, encode_int64)
+SET_FIXED_TYPE(cass_float_t, encode_float)
+SET_FIXED_TYPE(cass_double_t, encode_double)
+SET_FIXED_TYPE(CassUuid, encode_uuid)
+
+#undef SET_FIXED_TYPE
+
+CassError StatementTemplate::set(size_t index, cass_bool_t value) {
+  CASS_CHECK_INDEX_AND_TYPE(index, value);
+  encode_byte(reserve(index, 1), static_cast<uint8_t>(value));
+  return CASS_OK;
+}
+
+CassError StatementTemplate::set(size_t index, CassString value) {
+  CASS_CHECK_INDEX_AND_TYPE(index, value);
+  char* pos = reserve(index, static_cast<int32_t>(value.length));
+  if (value.length > 0) memcpy(pos, value.data, value.length);
+  return CASS_OK;
+}
+
+CassError StatementTemplate::set(size_t index, CassBytes value) {
+  CASS_CHECK_INDEX_AND_TYPE(index, value);
+  char* pos = reserve(index, static_cast<int32_t>(value.size));
+  if (value.size > 0) memcpy(pos, value.data, value.size);
+  return CASS_OK;
+}
+
+CassError StatementTemplate::set(size_t index, CassInet value) {
+  CASS_CHECK_INDEX_AND_TYPE(index, value);
+  memcpy(reserve(index, value.address_length), value.address, value.address_length);
+  return CASS_OK;
+}
+
+char* StatementTemplate::reserve(size_t index, int32_t size) {
+  Slot& slot(slots_[index]);
+
+  if (slot.size == -2) unset_count_--;
+
+  // Null and unset values only have a length
+  size_t old_size = slot.size > 0 ? slot.size : 0;
+  size_t new_size = size > 0 ? size : 0;
+  if (new_size != old_size) {
+    size_t end = slot.offset + sizeof(int32_t) + old_size;
+    if (new_size > old_size) {
+      values_.insert(values_.begin() + end, new_size - old_size, 0);
+      for (size_t i = index + 1; i < slots_.size(); ++i) {
+        slots_[i].offset += new_size - old_size;
+      }
+    } else {
+      values_.erase(values_.begin() + (end - (old_size - new_size)), values_.begin() + end);
+      for (size_t i = index + 1; i < slots_.size(); ++i) {
+        slots_[i].offset -= old_size - new_size;
+      }
+    }
+  }
+
+  slot.size = size;
+  char* pos = &values_[0] + slot.offset;
+  encode_int32(pos, size);
+  return pos + sizeof(int32_t);
+}
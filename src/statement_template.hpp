@@ -0,0 +1,118 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_STATEMENT_TEMPLATE_HPP
+#define DATASTAX_INTERNAL_STATEMENT_TEMPLATE_HPP
+
+#include "allocated.hpp"
+#include "buffer.hpp"
+#include "cassandra.h"
+#include "data_type.hpp"
+#include "external.hpp"
+#include "macros.hpp"
+#include "prepared.hpp"
+#include "request.hpp"
+#include "string.hpp"
+#include "vector.hpp"
+
+namespace datastax { namespace internal { namespace core {
+
+class ExecuteRequest;
+
+/**
+ * A bound statement whose values are encoded in a single contiguous buffer.
+ * Binding a value of the same size (e.g. fixed-width types) overwrites it in
+ * place and executing the template copies the buffer into the request so the
+ * template can be rebound immediately. This avoids the allocations of binding
+ * values to a new statement for every execution (not thread-safe).
+ */
+class StatementTemplate : public Allocated {
+public:
+  StatementTemplate(const Prepared::ConstPtr& prepared);
+
+  const Prepared::ConstPtr& prepared() const { return prepared_; }
+  const Buffer& encoded_id() const { return encoded_id_; }
+  const RequestSettings& settings() const { return settings_; }
+
+  void set_consistency(CassConsistency consistency) { settings_.consistency = consistency; }
+  void set_is_idempotent(bool is_idempotent) { settings_.is_idempotent = is_idempotent; }
+
+  size_t values_count() const { return slots_.size(); }
+
+  // True if any of the values haven't been bound
+  bool has_unset_values() const { return unset_count_ > 0; }
+
+  // Copy the encoded values into a new buffer
+  Buffer encode_values() const;
+
+  bool get_routing_key(String* routing_key) const;
+
+  CassError set(size_t index, CassNull value);
+  CassError set(size_t index, cass_int8_t value);
+  CassError set(size_t index, cass_int16_t value);
+  CassError set(size_t index, cass_int32_t value);
+  CassError set(size_t index, cass_uint32_t value);
+  CassError set(size_t index, cass_int64_t value);
+  CassError set(size_t index, cass_float_t value);
+  CassError set(size_t index, cass_double_t value);
+  CassError set(size_t index, cass_bool_t value);
+  CassError set(size_t index, CassString value);
+  CassError set(size_t index, CassBytes value);
+  CassError set(size_t index, CassUuid value);
+  CassError set(size_t index, CassInet value);
+
+private:
+  struct Slot {
+    size_t offset; // The offset of the value's [bytes] in the encoded values
+    int32_t size;  // The size of the value (negative for null and unset)
+  };
+
+  template <class T>
+  CassError check(size_t index, const T value) const {
+    if (index >= slots_.size()) {
+      return CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS;
+    }
+    IsValidDataType<T> is_valid_type;
+    const DataType::ConstPtr& data_type(
+        prepared_->result()->metadata()->get_column_definition(index).data_type);
+    if (data_type && !is_valid_type(value, data_type)) {
+      return CASS_ERROR_LIB_INVALID_VALUE_TYPE;
+    }
+    return CASS_OK;
+  }
+
+  // Resize the value at the index (moving the values that follow it if the
+  // size changed), encode its [bytes] length and return a pointer to where
+  // the value should be written.
+  char* reserve(size_t index, int32_t size);
+
+private:
+  Prepared::ConstPtr prepared_;
+  Buffer encoded_id_;
+  RequestSettings settings_;
+  Vector<char> values_;
+  Vector<Slot> slots_;
+  size_t unset_count_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(StatementTemplate);
+};
+
+}}} // namespace datastax::internal::core
+
+EXTERNAL_TYPE(datastax::internal::core::StatementTemplate, CassStatementTemplate)
+
+#endif
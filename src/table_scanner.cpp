@@ -0,0 +1,317 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "table_scanner.hpp"
+
+#include "constants.hpp"
+#include "map.hpp"
+#include "metadata.hpp"
+#include "query_request.hpp"
+#include "request_handler.hpp"
+#include "result_response.hpp"
+#include "scoped_lock.hpp"
+#include "session.hpp"
+#include "utils.hpp"
+
+using namespace datastax;
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+extern "C" {
+
+CassFuture* cass_session_scan_table(CassSession* session, const char* keyspace, const char* table,
+                                    unsigned concurrency, CassTableScanCallback callback,
+                                    void* data) {
+  return cass_session_scan_table_n(session, keyspace, SAFE_STRLEN(keyspace), table,
+                                   SAFE_STRLEN(table), concurrency, callback, data);
+}
+
+CassFuture* cass_session_scan_table_n(CassSession* session, const char* keyspace,
+                                      size_t keyspace_length, const char* table,
+                                      size_t table_length, unsigned concurrency,
+                                      CassTableScanCallback callback, void* data) {
+  Future::Ptr future;
+  if (concurrency == 0 || callback == NULL) {
+    future.reset(new Future(Future::FUTURE_TYPE_GENERIC));
+    future->set_error(CASS_ERROR_LIB_BAD_PARAMS,
+                      "Table scans require a callback and a concurrency greater than zero");
+  } else {
+    TableScanner::Ptr scanner(new TableScanner(session->from(), String(keyspace, keyspace_length),
+                                               String(table, table_length), concurrency, callback,
+                                               data));
+    future = scanner->scan();
+  }
+  future->inc_ref();
+  return CassFuture::to(future.get());
+}
+
+} // extern "C"
+
+namespace {
+
+struct PrimaryReplicaGroup {
+  TokenRangeVec ranges;
+  size_t index;
+};
+
+inline int64_t advance_token(int64_t token, uint64_t delta) {
+  return static_cast<int64_t>(static_cast<uint64_t>(token) + delta);
+}
+
+void split_range(const TokenRange& range, size_t count, TokenRangeVec* ranges) {
+  uint64_t step = (static_cast<uint64_t>(range.end) - static_cast<uint64_t>(range.start)) / count;
+  if (step == 0) {
+    ranges->push_back(range);
+    return;
+  }
+
+  int64_t start = range.start;
+  for (size_t i = 1; i < count; ++i) {
+    int64_t end = advance_token(start, step);
+    ranges->push_back(TokenRange(start, end, range.replicas));
+    start = end;
+  }
+  ranges->push_back(TokenRange(start, range.end, range.replicas));
+}
+
+} // namespace
+
+struct TableScanner::PageRequest : public Allocated {
+  PageRequest(const TableScanner::Ptr& scanner, size_t index)
+      : scanner(scanner)
+      , index(index) {}
+
+  TableScanner::Ptr scanner;
+  size_t index;
+};
+
+TableScanner::TableScanner(Session* session, const String& keyspace, const String& table,
+                           unsigned concurrency, CassTableScanCallback callback, void* data)
+    : session_(session)
+    , keyspace_(keyspace)
+    , table_(table)
+    , concurrency_(concurrency)
+    , callback_(callback)
+    , data_(data)
+    , future_(new Future(Future::FUTURE_TYPE_GENERIC))
+    , next_range_(0)
+    , in_flight_(0)
+    , error_code_(CASS_OK) {
+  uv_mutex_init(&mutex_);
+}
+
+TableScanner::~TableScanner() { uv_mutex_destroy(&mutex_); }
+
+Future::Ptr TableScanner::scan() {
+  if (session_->state() != SessionBase::SESSION_STATE_CONNECTED) {
+    future_->set_error(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, "Session is not connected");
+    return future_;
+  }
+
+  TokenMap::Ptr token_map(session_->token_map());
+  if (!token_map) {
+    future_->set_error(CASS_ERROR_LIB_NOT_IMPLEMENTED,
+                       "Table scans require token-aware routing and schema metadata");
+    return future_;
+  }
+
+  Metadata::SchemaSnapshot schema(session_->cluster()->schema_snapshot());
+  const KeyspaceMetadata* keyspace = schema.get_keyspace(keyspace_);
+  const TableMetadata* table = keyspace != NULL ? keyspace->get_table(table_) : NULL;
+  if (table == NULL) {
+    future_->set_error(CASS_ERROR_LIB_NAME_DOES_NOT_EXIST,
+                       "Unable to find table metadata for '" + keyspace_ + "." + table_ + "'");
+    return future_;
+  }
+
+  TokenRangeVec ring;
+  if (!token_map->get_token_ranges(keyspace_, &ring)) {
+    future_->set_error(CASS_ERROR_LIB_NOT_IMPLEMENTED,
+                       "Unable to determine the token ranges for keyspace '" + keyspace_ +
+                           "' (only the Murmur3 partitioner is supported)");
+    return future_;
+  }
+  split_ranges(ring, concurrency_, &ranges_);
+
+  String partition_key;
+  const ColumnMetadata::Vec& columns = table->partition_key();
+  for (ColumnMetadata::Vec::const_iterator it = columns.begin(), end = columns.end(); it != end;
+       ++it) {
+    String name((*it)->name());
+    if (!partition_key.empty()) partition_key.append(", ");
+    partition_key.append(escape_id(name));
+  }
+
+  String keyspace_name(keyspace_), table_name(table_);
+  query_ = "SELECT * FROM " + escape_id(keyspace_name) + "." + escape_id(table_name) +
+           " WHERE token(" + partition_key + ") > ? AND token(" + partition_key + ") <= ?";
+
+  size_t count;
+  { // Reserve the initial ranges before any of the requests can finish
+    ScopedMutex l(&mutex_);
+    count = std::min(static_cast<size_t>(concurrency_), ranges_.size());
+    next_range_ = in_flight_ = count;
+  }
+
+  for (size_t i = 0; i < count; ++i) {
+    execute(i, String());
+  }
+
+  return future_;
+}
+
+void TableScanner::split_ranges(const TokenRangeVec& ring, size_t min_count,
+                                TokenRangeVec* ranges) {
+  // Unwrap the range that wraps around the end of the ring. The minimum token
+  // is never assigned to a partition so it's safe to use it as an exclusive
+  // start.
+  TokenRangeVec unwrapped;
+  unwrapped.reserve(ring.size() + 1);
+  for (TokenRangeVec::const_iterator it = ring.begin(), end = ring.end(); it != end; ++it) {
+    if (it->start >= it->end) {
+      if (it->start != CASS_INT64_MAX) {
+        unwrapped.push_back(TokenRange(it->start, CASS_INT64_MAX, it->replicas));
+      }
+      unwrapped.push_back(TokenRange(CASS_INT64_MIN, it->end, it->replicas));
+    } else {
+      unwrapped.push_back(*it);
+    }
+  }
+
+  size_t splits = 1;
+  if (!unwrapped.empty() && unwrapped.size() < min_count) {
+    splits = (min_count + unwrapped.size() - 1) / unwrapped.size();
+  }
+
+  // Group the ranges by their primary replica (in ring order)
+  Vector<PrimaryReplicaGroup> groups;
+  Map<Address, size_t> group_indices;
+  for (TokenRangeVec::const_iterator it = unwrapped.begin(), end = unwrapped.end(); it != end;
+       ++it) {
+    Address primary;
+    if (it->replicas && !it->replicas->empty()) {
+      primary = it->replicas->front()->address();
+    }
+    Map<Address, size_t>::iterator group_it = group_indices.find(primary);
+    if (group_it == group_indices.end()) {
+      group_it = group_indices.insert(std::make_pair(primary, groups.size())).first;
+      groups.push_back(PrimaryReplicaGroup());
+      groups.back().index = 0;
+    }
+    split_range(*it, splits, &groups[group_it->second].ranges);
+  }
+
+  // Interleave the groups so that the ranges in flight are spread across replicas
+  size_t remaining = 0;
+  for (Vector<PrimaryReplicaGroup>::const_iterator it = groups.begin(), end = groups.end();
+       it != end; ++it) {
+    remaining += it->ranges.size();
+  }
+  ranges->reserve(ranges->size() + remaining);
+  while (remaining > 0) {
+    for (Vector<PrimaryReplicaGroup>::iterator it = groups.begin(), end = groups.end(); it != end;
+         ++it) {
+      if (it->index < it->ranges.size()) {
+        ranges->push_back(it->ranges[it->index++]);
+        remaining--;
+      }
+    }
+  }
+}
+
+void TableScanner::on_result(CassFuture* future, void* data) {
+  ScopedPtr<PageRequest> request(static_cast<PageRequest*>(data));
+  request->scanner->handle_result(request->index, static_cast<ResponseFuture*>(future->from()));
+}
+
+void TableScanner::execute(size_t index, const String& paging_state) {
+  const TokenRange& range = ranges_[index];
+
+  QueryRequest::Ptr request(new QueryRequest(query_, 2));
+  request->set(0, static_cast<cass_int64_t>(range.start));
+  request->set(1, static_cast<cass_int64_t>(range.end));
+  request->set_keyspace(keyspace_);
+  request->set_is_idempotent(true);
+  request->set_page_size(CASS_DEFAULT_TABLE_SCAN_PAGE_SIZE);
+  request->set_paging_state(paging_state);
+
+  OStringStream ss;
+  ss << range.end;
+  request->set_routing_token(ss.str());
+
+  Future::Ptr future(session_->execute(Request::ConstPtr(request)));
+  future->set_callback(on_result, new PageRequest(Ptr(this), index));
+}
+
+void TableScanner::handle_result(size_t index, ResponseFuture* future) {
+  Future::Error* error = future->error();
+  if (error != NULL) {
+    finish_range(error->code, error->message);
+    return;
+  }
+
+  SharedRefPtr<ResultResponse> result(future->response());
+  if (!result || result->kind() != CASS_RESULT_KIND_ROWS) {
+    finish_range(CASS_ERROR_LIB_UNEXPECTED_RESPONSE, "Expected rows for a table scan");
+    return;
+  }
+
+  // Stop scanning the range if another range has already failed
+  if (is_failed()) {
+    finish_range(CASS_OK, String());
+    return;
+  }
+
+  callback_(CassResult::to(result.get()), data_);
+
+  if (result->has_more_pages()) {
+    execute(index, result->paging_state().to_string());
+  } else {
+    finish_range(CASS_OK, String());
+  }
+}
+
+void TableScanner::finish_range(CassError code, const String& message) {
+  ScopedMutex l(&mutex_);
+
+  if (code != CASS_OK && error_code_ == CASS_OK) {
+    error_code_ = code;
+    error_message_ = message;
+  }
+
+  if (error_code_ == CASS_OK && next_range_ < ranges_.size()) {
+    size_t index = next_range_++;
+    l.unlock(); // The request can finish (and call back into the scanner) immediately
+    execute(index, String());
+    return;
+  }
+
+  if (--in_flight_ == 0) {
+    CassError error_code = error_code_;
+    String error_message = error_message_;
+    l.unlock();
+    if (error_code != CASS_OK) {
+      future_->set_error(error_code, error_message);
+    } else {
+      future_->set();
+    }
+  }
+}
+
+bool TableScanner::is_failed() {
+  ScopedMutex l(&mutex_);
+  return error_code_ != CASS_OK;
+}
@@ -0,0 +1,99 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#ifndef DATASTAX_INTERNAL_TABLE_SCANNER_HPP
+#define DATASTAX_INTERNAL_TABLE_SCANNER_HPP
+
+#include "cassandra.h"
+#include "future.hpp"
+#include "macros.hpp"
+#include "ref_counted.hpp"
+#include "string.hpp"
+#include "token_map.hpp"
+
+#include <uv.h>
+
+namespace datastax { namespace internal { namespace core {
+
+class ResponseFuture;
+class Session;
+
+/**
+ * A full table scan that splits the token ring into ranges and queries the
+ * ranges in parallel, with a bounded number of ranges in flight. Each page of
+ * rows is passed to a callback as it arrives.
+ */
+class TableScanner : public RefCounted<TableScanner> {
+public:
+  typedef SharedRefPtr<TableScanner> Ptr;
+
+  TableScanner(Session* session, const String& keyspace, const String& table,
+               unsigned concurrency, CassTableScanCallback callback, void* data);
+  ~TableScanner();
+
+  /**
+   * Start the scan.
+   *
+   * @return A future that's set when all the ranges have been scanned or
+   * when the scan fails.
+   */
+  Future::Ptr scan();
+
+  /**
+   * Unwrap and split the ring's token ranges so that there are at least
+   * `min_count` ranges (if possible). The resulting ranges are interleaved by
+   * their primary replica so that consecutive ranges are owned by different
+   * replicas.
+   *
+   * @param ring The token ranges of the ring.
+   * @param min_count The minimum number of resulting ranges.
+   * @param ranges The resulting token ranges.
+   */
+  static void split_ranges(const TokenRangeVec& ring, size_t min_count, TokenRangeVec* ranges);
+
+private:
+  struct PageRequest;
+
+  static void on_result(CassFuture* future, void* data);
+
+  void execute(size_t index, const String& paging_state);
+  void handle_result(size_t index, ResponseFuture* future);
+  void finish_range(CassError code, const String& message);
+  bool is_failed();
+
+private:
+  uv_mutex_t mutex_;
+  Session* session_;
+  String keyspace_;
+  String table_;
+  String query_;
+  unsigned concurrency_;
+  CassTableScanCallback callback_;
+  void* data_;
+  Future::Ptr future_;
+  TokenRangeVec ranges_;
+  size_t next_range_;
+  size_t in_flight_;
+  CassError error_code_;
+  String error_message_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(TableScanner);
+};
+
+}}} // namespace datastax::internal::core
+
+#endif
@@ -36,6 +36,61 @@ static inline bool contains(const CopyOnWriteHostVec& replicas, const Address& a
   return false;
 }
 
+// Orders hosts by the latency percentile tracked by the latency-aware policy.
+// Percentiles that are unknown, have too few measurements or are older than
+// the retry period (the same rules the latency-aware policy uses) are treated
+// as unknown. Those hosts are ordered first, keeping their relative order, so
+// that a host that was slow in the past gets a chance to be measured again.
+struct CompareLatencyPercentile {
+  CompareLatencyPercentile(uint64_t now, uint64_t retry_period_ns, uint64_t min_measured)
+      : now(now)
+      , retry_period_ns(retry_period_ns)
+      , min_measured(min_measured) {}
+
+  bool operator()(const Host::Ptr& lhs, const Host::Ptr& rhs) const {
+    return current_percentile(lhs) < current_percentile(rhs);
+  }
+
+  int64_t current_percentile(const Host::Ptr& host) const {
+    TimestampedAverage latency = host->get_current_percentile();
+    if (latency.average < 0 || latency.num_measured < min_measured ||
+        now - latency.timestamp > retry_period_ns) {
+      return 0;
+    }
+    return latency.average;
+  }
+
+  uint64_t now;
+  uint64_t retry_period_ns;
+  uint64_t min_measured;
+};
+
+struct IsLocalRack {
+  IsLocalRack(const LoadBalancingPolicy* policy)
+      : policy(policy) {}
+
+  bool operator()(const Host::Ptr& host) const { return policy->is_local_rack(host); }
+
+  const LoadBalancingPolicy* policy;
+};
+
+bool TokenAwarePolicy::has_local_rack_replica(const CopyOnWriteHostVec& replicas) const {
+  // Checked without modifying the replicas so that they're only copied when
+  // they need to be reordered.
+  for (HostVec::const_iterator i = replicas->begin(), end = replicas->end(); i != end; ++i) {
+    if (child_policy_->is_local_rack(*i)) return true;
+  }
+  return false;
+}
+
+// Serial reads use a serial consistency and conditional updates have their
+// serial consistency set explicitly on the statement (a default serial
+// consistency is sent with every request so it can't be used by itself).
+static inline bool is_lightweight_transaction(const RequestHandler* request_handler) {
+  return is_serial(request_handler->consistency()) ||
+         is_serial(request_handler->request()->serial_consistency());
+}
+
 void TokenAwarePolicy::init(const Host::Ptr& connected_host, const HostMap& hosts, Random* random,
                             const String& local_dc) {
   if (random != NULL) {
@@ -62,17 +117,60 @@ QueryPlan* TokenAwarePolicy::new_query_plan(const String& keyspace, RequestHandl
         case CQL_OPCODE_EXECUTE:
         case CQL_OPCODE_BATCH:
           String routing_key;
-          if (request->get_routing_key(&routing_key) && !keyspace.empty()) {
+          const String& routing_token = request->routing_token();
+          if ((!routing_token.empty() || request->get_routing_key(&routing_key)) &&
+              !keyspace.empty()) {
             if (token_map != NULL) {
-              CopyOnWriteHostVec replicas = token_map->get_replicas(keyspace, routing_key);
+              CopyOnWriteHostVec replicas =
+                  routing_token.empty()
+                      ? token_map->get_replicas(keyspace, routing_key)
+                      : token_map->get_replicas_for_token(keyspace, routing_token);
               if (replicas && !replicas->empty()) {
+                if (is_lightweight_transaction(request_handler)) {
+                  // Use the replicas in token ring order (without shuffling or
+                  // reordering) so that concurrent lightweight transactions
+                  // on the same partition use the same coordinator and
+                  // don't contend in Paxos.
+                  return new TokenAwareQueryPlan(
+                      child_policy_.get(),
+                      child_policy_->new_query_plan(keyspace, request_handler, token_map),
+                      replicas, 0);
+                }
                 if (random_ != NULL) {
                   random_shuffle(replicas->begin(), replicas->end(), random_);
                 }
+                size_t start_index = index_;
+                size_t num_local_rack = 0;
+                if (has_local_rack_replica(replicas)) {
+                  // Replicas in the local rack are tried before the other replicas
+                  HostVec& hosts = *replicas;
+                  num_local_rack = std::stable_partition(hosts.begin(), hosts.end(),
+                                                         IsLocalRack(child_policy_.get())) -
+                                   hosts.begin();
+                  if (random_ == NULL) {
+                    std::rotate(hosts.begin(), hosts.begin() + index_ % num_local_rack,
+                                hosts.begin() + num_local_rack);
+                  }
+                  start_index = 0;
+                }
+                if (order_replicas_by_latency_) {
+                  // Replicas with the same (or an unknown) latency keep their
+                  // shuffled or token order starting at the start index
+                  HostVec& hosts = *replicas;
+                  if (start_index != 0) {
+                    std::rotate(hosts.begin(), hosts.begin() + start_index % hosts.size(),
+                                hosts.end());
+                  }
+                  CompareLatencyPercentile compare(uv_hrtime(), latency_retry_period_ns_,
+                                                   latency_min_measured_);
+                  std::stable_sort(hosts.begin(), hosts.begin() + num_local_rack, compare);
+                  std::stable_sort(hosts.begin() + num_local_rack, hosts.end(), compare);
+                  start_index = 0;
+                }
                 return new TokenAwareQueryPlan(
                     child_policy_.get(),
                     child_policy_->new_query_plan(keyspace, request_handler, token_map), replicas,
-                    index_);
+                    start_index);
               }
             }
           }
@@ -26,11 +26,27 @@ namespace datastax { namespace internal { namespace core {
 
 class TokenAwarePolicy : public ChainedLoadBalancingPolicy {
 public:
-  TokenAwarePolicy(LoadBalancingPolicy* child_policy, bool shuffle_replicas)
+  /**
+   * Constructor
+   *
+   * @param child_policy
+   * @param shuffle_replicas
+   * @param order_replicas_by_latency Order the replicas by the latency
+   * percentile published by the latency-aware policy.
+   * @param latency_retry_period_ns Percentiles older than this are ignored
+   * (the same as the latency-aware policy's retry period).
+   * @param latency_min_measured Percentiles with fewer measurements are ignored.
+   */
+  TokenAwarePolicy(LoadBalancingPolicy* child_policy, bool shuffle_replicas,
+                   bool order_replicas_by_latency = false, uint64_t latency_retry_period_ns = 0,
+                   uint64_t latency_min_measured = 0)
       : ChainedLoadBalancingPolicy(child_policy)
       , random_(NULL)
       , index_(0)
-      , shuffle_replicas_(shuffle_replicas) {}
+      , shuffle_replicas_(shuffle_replicas)
+      , order_replicas_by_latency_(order_replicas_by_latency)
+      , latency_retry_period_ns_(latency_retry_period_ns)
+      , latency_min_measured_(latency_min_measured) {}
 
   virtual ~TokenAwarePolicy() {}
 
@@ -41,9 +57,14 @@ public:
                                     const TokenMap* token_map);
 
   LoadBalancingPolicy* new_instance() {
-    return new TokenAwarePolicy(child_policy_->new_instance(), shuffle_replicas_);
+    return new TokenAwarePolicy(child_policy_->new_instance(), shuffle_replicas_,
+                                order_replicas_by_latency_, latency_retry_period_ns_,
+                                latency_min_measured_);
   }
 
+private:
+  bool has_local_rack_replica(const CopyOnWriteHostVec& replicas) const;
+
 private:
   class TokenAwareQueryPlan : public QueryPlan {
   public:
@@ -68,6 +89,9 @@ private:
   Random* random_;
   size_t index_;
   bool shuffle_replicas_;
+  bool order_replicas_by_latency_;
+  uint64_t latency_retry_period_ns_;
+  uint64_t latency_min_measured_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(TokenAwarePolicy);
@@ -33,3 +33,22 @@ TokenMap::Ptr TokenMap::from_partitioner(StringRef partitioner) {
     return Ptr();
   }
 }
+
+template <>
+bool TokenMapImpl<Murmur3Partitioner>::get_token_ranges(const String& keyspace_name,
+                                                        TokenRangeVec* ranges) const {
+  KeyspaceReplicaMap::const_iterator ks_it = replicas_.find(keyspace_name);
+  if (ks_it == replicas_.end() || ks_it->second.empty()) {
+    return false;
+  }
+
+  const TokenReplicasVec& replicas = ks_it->second;
+  int64_t start = replicas.back().first;
+  ranges->reserve(ranges->size() + replicas.size());
+  for (TokenReplicasVec::const_iterator it = replicas.begin(), end = replicas.end(); it != end;
+       ++it) {
+    ranges->push_back(TokenRange(start, it->first, it->second));
+    start = it->first;
+  }
+  return true;
+}
@@ -21,6 +21,7 @@
 #include "ref_counted.hpp"
 #include "string.hpp"
 #include "string_ref.hpp"
+#include "vector.hpp"
 
 namespace datastax { namespace internal { namespace core {
 
@@ -28,6 +29,22 @@ class VersionNumber;
 class Value;
 class ResultResponse;
 
+/**
+ * A range of Murmur3 tokens, (start, end], and the replicas that own it.
+ */
+struct TokenRange {
+  TokenRange(int64_t start, int64_t end, const CopyOnWriteHostVec& replicas)
+      : start(start)
+      , end(end)
+      , replicas(replicas) {}
+
+  int64_t start;
+  int64_t end;
+  CopyOnWriteHostVec replicas;
+};
+
+typedef Vector<TokenRange> TokenRangeVec;
+
 class TokenMap : public RefCounted<TokenMap> {
 public:
   typedef SharedRefPtr<TokenMap> Ptr;
@@ -53,6 +70,21 @@ public:
   virtual const CopyOnWriteHostVec& get_replicas(const String& keyspace_name,
                                                  const String& routing_key) const = 0;
 
+  virtual const CopyOnWriteHostVec& get_replicas_for_token(const String& keyspace_name,
+                                                           const String& token) const = 0;
+
+  /**
+   * Get the token ranges of the ring and their replicas for a keyspace. The
+   * first range wraps around the end of the ring. This is only supported for
+   * the Murmur3 partitioner.
+   *
+   * @param keyspace_name The name of the keyspace.
+   * @param ranges The resulting token ranges.
+   * @return true if the ranges were successfully retrieved, otherwise false
+   * if the partitioner is not supported or the keyspace doesn't exist.
+   */
+  virtual bool get_token_ranges(const String& keyspace_name, TokenRangeVec* ranges) const = 0;
+
   virtual String dump(const String& keyspace_name) const = 0;
 };
 
@@ -615,6 +615,11 @@ public:
   virtual const CopyOnWriteHostVec& get_replicas(const String& keyspace_name,
                                                  const String& routing_key) const;
 
+  virtual const CopyOnWriteHostVec& get_replicas_for_token(const String& keyspace_name,
+                                                           const String& token) const;
+
+  virtual bool get_token_ranges(const String& keyspace_name, TokenRangeVec* ranges) const;
+
   virtual String dump(const String& keyspace_name) const;
 
 public:
@@ -756,6 +761,39 @@ const CopyOnWriteHostVec& TokenMapImpl<Partitioner>::get_replicas(const String&
   return no_replicas_dummy_;
 }
 
+template <class Partitioner>
+const CopyOnWriteHostVec&
+TokenMapImpl<Partitioner>::get_replicas_for_token(const String& keyspace_name,
+                                                  const String& token) const {
+  typename KeyspaceReplicaMap::const_iterator ks_it = replicas_.find(keyspace_name);
+
+  if (ks_it != replicas_.end()) {
+    // The replicas for a token are the owners of the first ring token that is
+    // equal to or after it.
+    const TokenReplicasVec& replicas = ks_it->second;
+    typename TokenReplicasVec::const_iterator replicas_it = std::lower_bound(
+        replicas.begin(), replicas.end(),
+        TokenReplicas(Partitioner::from_string(token), no_replicas_dummy_), TokenReplicasCompare());
+    if (replicas_it != replicas.end()) {
+      return replicas_it->second;
+    } else if (!replicas.empty()) {
+      return replicas.front().second;
+    }
+  }
+
+  return no_replicas_dummy_;
+}
+
+template <class Partitioner>
+bool TokenMapImpl<Partitioner>::get_token_ranges(const String& keyspace_name,
+                                                 TokenRangeVec* ranges) const {
+  return false;
+}
+
+template <>
+bool TokenMapImpl<Murmur3Partitioner>::get_token_ranges(const String& keyspace_name,
+                                                        TokenRangeVec* ranges) const;
+
 template <class Partitioner>
 String TokenMapImpl<Partitioner>::dump(const String& keyspace_name) const {
   String result;
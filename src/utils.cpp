@@ -68,6 +68,8 @@ String opcode_to_string(int opcode) {
       return "CQL_OPCODE_AUTH_RESPONSE";
     case CQL_OPCODE_AUTH_SUCCESS:
       return "CQL_OPCODE_AUTH_SUCCESS";
+    case CQL_OPCODE_CANCEL:
+      return "CQL_OPCODE_CANCEL";
   };
   assert(false);
   return "";
@@ -194,19 +194,20 @@ CassValueType cass_value_secondary_sub_type(const CassValue* collection) {
 
 Value::Value(const DataType::ConstPtr& data_type, Decoder decoder)
     : data_type_(data_type)
-    , count_(0)
+    , borrowed_data_type_(NULL)
+    , count_(element_count(data_type.get()))
     , decoder_(decoder)
     , is_null_(false) {
   assert(!data_type->is_collection());
+}
+
+int32_t Value::element_count(const DataType* data_type) {
   if (data_type->is_tuple()) {
-    SharedRefPtr<const CompositeType> composite_type(data_type);
-    count_ = composite_type->types().size();
+    return static_cast<const CompositeType*>(data_type)->types().size();
   } else if (data_type->is_user_type()) {
-    UserType::ConstPtr user_type(data_type);
-    count_ = user_type->fields().size();
-  } else {
-    count_ = 0;
+    return static_cast<const UserType*>(data_type)->fields().size();
   }
+  return 0;
 }
 
 bool Value::as_bool() const {
@@ -28,12 +28,14 @@ namespace datastax { namespace internal { namespace core {
 class Value {
 public:
   Value()
-      : count_(0)
+      : borrowed_data_type_(NULL)
+      , count_(0)
       , is_null_(false) {}
 
   // Used for "null" values
   Value(const DataType::ConstPtr& data_type)
       : data_type_(data_type)
+      , borrowed_data_type_(NULL)
       , count_(0)
       , is_null_(true) {}
 
@@ -43,22 +45,46 @@ public:
   // Used for collections and schema metadata collections (converted from JSON)
   Value(const DataType::ConstPtr& data_type, int32_t count, Decoder decoder)
       : data_type_(data_type)
+      , borrowed_data_type_(NULL)
       , count_(count)
       , decoder_(decoder)
       , is_null_(false) {}
 
+  // Copies always own a reference to the data type so that they're able to
+  // outlive the metadata a borrowed data type belongs to.
+  Value(const Value& other)
+      : data_type_(other.data_type())
+      , borrowed_data_type_(NULL)
+      , count_(other.count_)
+      , decoder_(other.decoder_)
+      , is_null_(other.is_null_) {}
+
+  Value& operator=(const Value& other) {
+    if (this != &other) {
+      data_type_ = other.data_type();
+      borrowed_data_type_ = NULL;
+      count_ = other.count_;
+      decoder_ = other.decoder_;
+      is_null_ = other.is_null_;
+    }
+    return *this;
+  }
+
   Decoder decoder() const { return decoder_; }
   ProtocolVersion protocol_version() const { return decoder_.protocol_version(); }
   int64_t size() const { return (is_null_ ? -1 : decoder_.remaining()); }
 
   CassValueType value_type() const {
-    if (!data_type_) {
+    const DataType::ConstPtr& type(data_type());
+    if (!type) {
       return CASS_VALUE_TYPE_UNKNOWN;
     }
-    return data_type_->value_type();
+    return type->value_type();
   }
 
-  const DataType::ConstPtr& data_type() const { return data_type_; }
+  const DataType::ConstPtr& data_type() const {
+    return borrowed_data_type_ != NULL ? *borrowed_data_type_ : data_type_;
+  }
 
   CassValueType primary_value_type() const {
     const DataType::ConstPtr& primary(primary_data_type());
@@ -69,10 +95,11 @@ public:
   }
 
   const DataType::ConstPtr& primary_data_type() const {
-    if (!data_type_ || !data_type_->is_collection()) {
+    const DataType::ConstPtr& type(data_type());
+    if (!type || !type->is_collection()) {
       return DataType::NIL;
     }
-    const CollectionType::ConstPtr& collection_type(data_type_);
+    const CollectionType* collection_type = static_cast<const CollectionType*>(type.get());
     if (collection_type->types().size() < 1) {
       return DataType::NIL;
     }
@@ -88,10 +115,11 @@ public:
   }
 
   const DataType::ConstPtr& secondary_data_type() const {
-    if (!data_type_ || !data_type_->is_map()) {
+    const DataType::ConstPtr& type(data_type());
+    if (!type || !type->is_map()) {
       return DataType::NIL;
     }
-    const CollectionType::ConstPtr& collection_type(data_type_);
+    const CollectionType* collection_type = static_cast<const CollectionType*>(type.get());
     if (collection_type->types().size() < 2) {
       return DataType::NIL;
     }
@@ -101,23 +129,27 @@ public:
   bool is_null() const { return is_null_; }
 
   bool is_collection() const {
-    if (!data_type_) return false;
-    return data_type_->is_collection();
+    const DataType::ConstPtr& type(data_type());
+    if (!type) return false;
+    return type->is_collection();
   }
 
   bool is_map() const {
-    if (!data_type_) return false;
-    return data_type_->is_map();
+    const DataType::ConstPtr& type(data_type());
+    if (!type) return false;
+    return type->is_map();
   }
 
   bool is_tuple() const {
-    if (!data_type_) return false;
-    return data_type_->is_tuple();
+    const DataType::ConstPtr& type(data_type());
+    if (!type) return false;
+    return type->is_tuple();
   }
 
   bool is_user_type() const {
-    if (!data_type_) return false;
-    return data_type_->is_user_type();
+    const DataType::ConstPtr& type(data_type());
+    if (!type) return false;
+    return type->is_user_type();
   }
 
   int32_t count() const { return count_; }
@@ -135,7 +167,25 @@ public:
   StringVec as_stringlist() const;
 
 private:
+  friend class Decoder;
+
+  // The number of elements in a tuple or the number of fields in a UDT
+  static int32_t element_count(const DataType* data_type);
+
+  // Used by the decoder for row values. The data type is borrowed from the
+  // result metadata, which outlives the row, so that decoding a column doesn't
+  // require reference counting the data type.
+  void set_borrowed(const DataType::ConstPtr& data_type, int32_t count, Decoder decoder,
+                    bool is_null) {
+    data_type_.reset();
+    borrowed_data_type_ = &data_type;
+    count_ = count;
+    decoder_ = decoder;
+    is_null_ = is_null;
+  }
+
   DataType::ConstPtr data_type_;
+  const DataType::ConstPtr* borrowed_data_type_;
   int32_t count_;
   Decoder decoder_;
   bool is_null_;
@@ -0,0 +1,195 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "unit.hpp"
+
+#include "bulk_executor.hpp"
+#include "session.hpp"
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class BulkExecutorUnitTest : public Unit {
+public:
+  struct Statements {
+    Statements(int count)
+        : count(count)
+        , next(0)
+        , max_in_flight(0)
+        , executor(NULL) {}
+
+    int count;
+    int next;
+    Atomic<int> max_in_flight;
+    CassBulkExecutor* executor;
+  };
+
+  static CassStatement* next_statement(void* data) {
+    Statements* statements = static_cast<Statements*>(data);
+    if (statements->next >= statements->count) return NULL;
+    statements->next++;
+    CassStatement* statement = cass_statement_new("blah", 0);
+    cass_statement_set_is_idempotent(statement, cass_true);
+    return statement;
+  }
+
+  // Uses the executor from the callback that provides its statements
+  static CassStatement* next_statement_with_metrics(void* data) {
+    Statements* statements = static_cast<Statements*>(data);
+    CassBulkExecutorMetrics metrics;
+    cass_bulk_executor_get_metrics(statements->executor, &metrics);
+    int in_flight = static_cast<int>(metrics.in_flight);
+    int max_in_flight = statements->max_in_flight.load();
+    while (in_flight > max_in_flight &&
+           !statements->max_in_flight.compare_exchange_weak(max_in_flight, in_flight)) {
+    }
+    return next_statement(data);
+  }
+
+  static void on_result(CassFuture* future, void* data) {
+    Statements* statements = static_cast<Statements*>(data);
+    CassBulkExecutorMetrics metrics;
+    cass_bulk_executor_get_metrics(statements->executor, &metrics);
+    int in_flight = static_cast<int>(metrics.in_flight);
+    int max_in_flight = statements->max_in_flight.load();
+    while (in_flight > max_in_flight &&
+           !statements->max_in_flight.compare_exchange_weak(max_in_flight, in_flight)) {
+    }
+  }
+
+  static void connect(Session* session) {
+    Config config;
+    config.contact_points().push_back(Address("127.0.0.1", 9042));
+    Future::Ptr connect_future(session->connect(config));
+    ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME))
+        << "Timed out waiting for session to connect";
+    ASSERT_FALSE(connect_future->error()) << cass_error_desc(connect_future->error()->code) << ": "
+                                          << connect_future->error()->message;
+  }
+
+  static void close(Session* session) {
+    Future::Ptr close_future(session->close());
+    ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME)) << "Timed out waiting for session to close";
+  }
+};
+
+TEST_F(BulkExecutorUnitTest, InvalidParameters) {
+  Session session;
+  EXPECT_TRUE(cass_bulk_executor_new(CassSession::to(&session), 0, next_statement, NULL) == NULL);
+  EXPECT_TRUE(cass_bulk_executor_new(CassSession::to(&session), 1, NULL, NULL) == NULL);
+}
+
+TEST_F(BulkExecutorUnitTest, NotConnected) {
+  Session session;
+  Statements statements(1);
+  CassBulkExecutor* executor =
+      cass_bulk_executor_new(CassSession::to(&session), 1, next_statement, &statements);
+  CassFuture* future = cass_bulk_executor_execute(executor);
+  EXPECT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, cass_future_error_code(future));
+  EXPECT_EQ(0, statements.next);
+  cass_future_free(future);
+  cass_bulk_executor_free(executor);
+}
+
+TEST_F(BulkExecutorUnitTest, Execute) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  Statements statements(100);
+  CassBulkExecutor* executor =
+      cass_bulk_executor_new(CassSession::to(&session), 4, next_statement, &statements);
+  statements.executor = executor;
+  cass_bulk_executor_set_result_callback(executor, on_result, &statements);
+
+  CassFuture* future = cass_bulk_executor_execute(executor);
+  ASSERT_TRUE(cass_future_wait_timed(future, WAIT_FOR_TIME));
+  EXPECT_EQ(CASS_OK, cass_future_error_code(future));
+  cass_future_free(future);
+
+  CassBulkExecutorMetrics metrics;
+  cass_bulk_executor_get_metrics(executor, &metrics);
+  EXPECT_EQ(100, statements.next);
+  EXPECT_EQ(100u, metrics.completed);
+  EXPECT_EQ(0u, metrics.errors);
+  EXPECT_EQ(0u, metrics.in_flight);
+  EXPECT_GT(metrics.mean_rate, 0.0);
+  EXPECT_GT(metrics.latency.max, 0u);
+  EXPECT_LE(metrics.latency.min, metrics.latency.max);
+  EXPECT_LE(statements.max_in_flight.load(), 4);
+
+  cass_bulk_executor_free(executor);
+  close(&session);
+}
+
+TEST_F(BulkExecutorUnitTest, MetricsFromNextCallback) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  Statements statements(20);
+  CassBulkExecutor* executor = cass_bulk_executor_new(CassSession::to(&session), 4,
+                                                      next_statement_with_metrics, &statements);
+  statements.executor = executor;
+
+  CassFuture* future = cass_bulk_executor_execute(executor);
+  ASSERT_TRUE(cass_future_wait_timed(future, WAIT_FOR_TIME));
+  EXPECT_EQ(CASS_OK, cass_future_error_code(future));
+  cass_future_free(future);
+
+  CassBulkExecutorMetrics metrics;
+  cass_bulk_executor_get_metrics(executor, &metrics);
+  EXPECT_EQ(20, statements.next);
+  EXPECT_EQ(20u, metrics.completed);
+  EXPECT_EQ(0u, metrics.in_flight);
+  EXPECT_LE(statements.max_in_flight.load(), 4);
+
+  cass_bulk_executor_free(executor);
+  close(&session);
+}
+
+TEST_F(BulkExecutorUnitTest, Rate) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  Statements statements(15);
+  CassBulkExecutor* executor =
+      cass_bulk_executor_new(CassSession::to(&session), 100, next_statement, &statements);
+  cass_bulk_executor_set_rate(executor, 10);
+
+  uint64_t start = uv_hrtime();
+  CassFuture* future = cass_bulk_executor_execute(executor);
+  EXPECT_EQ(10, statements.next); // The first second's worth of requests are started immediately
+  ASSERT_TRUE(cass_future_wait_timed(future, WAIT_FOR_TIME));
+  EXPECT_EQ(CASS_OK, cass_future_error_code(future));
+  cass_future_free(future);
+  // The remaining requests are started at the target rate
+  EXPECT_GE(uv_hrtime() - start, 400ULL * 1000 * 1000);
+
+  CassBulkExecutorMetrics metrics;
+  cass_bulk_executor_get_metrics(executor, &metrics);
+  EXPECT_EQ(15u, metrics.completed);
+
+  cass_bulk_executor_free(executor);
+  close(&session);
+}
@@ -0,0 +1,278 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include "unit.hpp"
+
+#include "callback_executor.hpp"
+#include "future.hpp"
+#include "query_request.hpp"
+#include "session.hpp"
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+class CallbackExecutorUnitTest : public Unit {
+public:
+  struct Callbacks {
+    Callbacks()
+        : count(0)
+        , is_other_thread(false) {
+      thread = uv_thread_self();
+    }
+
+    Atomic<int> count;
+    uv_thread_t thread;
+    Atomic<bool> is_other_thread;
+  };
+
+  static void on_callback(CassFuture* future, void* data) {
+    Callbacks* callbacks = static_cast<Callbacks*>(data);
+    uv_thread_t self = uv_thread_self();
+    if (!uv_thread_equal(&self, &callbacks->thread)) {
+      callbacks->is_other_thread.store(true);
+    }
+    EXPECT_TRUE(future->from()->ready());
+    callbacks->count.fetch_add(1);
+  }
+
+  static void on_wait_callback(CassFuture* future, void* data) {
+    cass_future_wait(future); // A callback can wait on its own future
+    on_callback(future, data);
+  }
+
+  static void dispatch(CassCallbackBatch* batch, void* data) {
+    static_cast<Vector<CassCallbackBatch*>*>(data)->push_back(batch);
+  }
+
+  // Returns two pages of (empty) rows
+  class PagedRowsResult : public mockssandra::Action {
+  public:
+    void on_run(mockssandra::Request* request) const {
+      String query;
+      mockssandra::QueryParameters params;
+      if (!request->decode_query(&query, &params)) {
+        request->error(mockssandra::ERROR_PROTOCOL_ERROR, "Invalid query message");
+        return;
+      }
+      bool has_more_pages = params.paging_state.empty();
+      String body;
+      mockssandra::encode_int32(mockssandra::RESULT_ROWS, &body);
+      mockssandra::encode_int32(has_more_pages ? mockssandra::RESULT_FLAG_HAS_MORE_PAGES : 0,
+                                &body);     // Flags
+      mockssandra::encode_int32(0, &body); // Column count
+      if (has_more_pages) {
+        mockssandra::encode_int32(4, &body); // Paging state
+        body.append("next");
+      }
+      mockssandra::encode_int32(0, &body); // Row count
+      request->write(mockssandra::OPCODE_RESULT, body);
+    }
+  };
+
+  static bool wait_for_count(Callbacks* callbacks, int count) {
+    for (int i = 0; i < 5000 && callbacks->count.load() < count; ++i) {
+      test::Utils::msleep(1);
+    }
+    return callbacks->count.load() == count;
+  }
+};
+
+TEST_F(CallbackExecutorUnitTest, IoThread) {
+  CallbackExecutor::Ptr executor(new CallbackExecutor());
+  Callbacks callbacks;
+
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  future->set_callback_executor(executor);
+  ASSERT_TRUE(future->set_application_callback(on_callback, &callbacks));
+  future->set();
+  EXPECT_EQ(1, callbacks.count.load()); // Run on the thread that sets the future
+  EXPECT_FALSE(callbacks.is_other_thread.load());
+
+  CassCallbackMetrics metrics;
+  executor->get_metrics(&metrics);
+  EXPECT_EQ(1u, metrics.io_thread_callbacks);
+  EXPECT_EQ(0u, metrics.dispatched_callbacks);
+}
+
+TEST_F(CallbackExecutorUnitTest, Function) {
+  Vector<CassCallbackBatch*> batches;
+  CallbackExecutor::Ptr executor(new CallbackExecutor(dispatch, &batches));
+  Callbacks callbacks;
+
+  for (int i = 0; i < 3; ++i) {
+    Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+    future->set_callback_executor(executor);
+    ASSERT_TRUE(future->set_application_callback(on_callback, &callbacks));
+    future->set();
+  }
+  EXPECT_EQ(0, callbacks.count.load());
+  ASSERT_EQ(1u, batches.size()); // The callbacks are added to the pending batch
+
+  cass_callback_batch_run(batches[0]);
+  EXPECT_EQ(3, callbacks.count.load());
+
+  // Internal callbacks are always run on the thread that sets the future
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  future->set_callback_executor(executor);
+  ASSERT_TRUE(future->set_callback(on_callback, &callbacks));
+  future->set();
+  EXPECT_EQ(4, callbacks.count.load());
+  EXPECT_EQ(1u, batches.size());
+
+  CassCallbackMetrics metrics;
+  executor->get_metrics(&metrics);
+  EXPECT_EQ(3u, metrics.dispatched_callbacks);
+  EXPECT_EQ(1u, metrics.dispatched_batches);
+}
+
+TEST_F(CallbackExecutorUnitTest, WaitForCallback) {
+  Vector<CassCallbackBatch*> batches;
+  CallbackExecutor::Ptr executor(new CallbackExecutor(dispatch, &batches));
+  Callbacks callbacks;
+
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  future->set_callback_executor(executor);
+  ASSERT_TRUE(future->set_application_callback(on_wait_callback, &callbacks));
+  future->set();
+  EXPECT_TRUE(future->ready());
+
+  // Waiting threads aren't notified until the callback has run
+  Future* futures[] = { future.get() };
+  size_t index = 1;
+  EXPECT_FALSE(future->wait_for(1000));
+  EXPECT_FALSE(Future::wait_all(futures, 1, 1000));
+  EXPECT_FALSE(Future::wait_any(futures, 1, 1000, &index));
+
+  ASSERT_EQ(1u, batches.size());
+  cass_callback_batch_run(batches[0]);
+  EXPECT_EQ(1, callbacks.count.load());
+
+  EXPECT_TRUE(future->wait_for(1000));
+  EXPECT_TRUE(Future::wait_all(futures, 1, 1000));
+  EXPECT_TRUE(Future::wait_any(futures, 1, 1000, &index));
+  EXPECT_EQ(0u, index);
+}
+
+TEST_F(CallbackExecutorUnitTest, ThreadPool) {
+  CallbackExecutor::Ptr executor(new CallbackExecutor(2));
+  ASSERT_EQ(0, executor->init());
+  Callbacks callbacks;
+
+  for (int i = 0; i < 100; ++i) {
+    Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+    future->set_callback_executor(executor);
+    ASSERT_TRUE(future->set_application_callback(on_callback, &callbacks));
+    future->set();
+  }
+
+  EXPECT_TRUE(wait_for_count(&callbacks, 100));
+  EXPECT_TRUE(callbacks.is_other_thread.load());
+
+  CassCallbackMetrics metrics;
+  executor->get_metrics(&metrics);
+  EXPECT_EQ(100u, metrics.dispatched_callbacks);
+  EXPECT_EQ(0u, metrics.io_thread_callbacks);
+}
+
+TEST_F(CallbackExecutorUnitTest, Session) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .wait(100) // Set the callback before the query completes
+      .empty_rows_result(1);
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  CallbackExecutor::Ptr executor(new CallbackExecutor(1));
+  ASSERT_EQ(0, executor->init());
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_callback_executor(executor);
+
+  Session session;
+  Future::Ptr connect_future(session.connect(config));
+  ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME));
+  ASSERT_FALSE(connect_future->error());
+
+  Callbacks callbacks;
+  CassStatement* statement = cass_statement_new("blah", 0);
+  CassFuture* future = cass_session_execute(CassSession::to(&session), statement);
+  EXPECT_EQ(CASS_OK, cass_future_set_callback(future, on_callback, &callbacks));
+  cass_future_free(future);
+  cass_statement_free(statement);
+
+  EXPECT_TRUE(wait_for_count(&callbacks, 1));
+  EXPECT_TRUE(callbacks.is_other_thread.load());
+
+  CassCallbackMetrics metrics;
+  cass_session_get_callback_metrics(CassSession::to(&session), &metrics);
+  EXPECT_EQ(1u, metrics.dispatched_callbacks);
+
+  Future::Ptr close_future(session.close());
+  ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME));
+}
+
+TEST_F(CallbackExecutorUnitTest, PrefetchedPage) {
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(mockssandra::OPCODE_QUERY)
+      .system_local()
+      .system_peers()
+      .wait(200) // Set the callback before the prefetched page completes
+      .execute(new PagedRowsResult());
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  CallbackExecutor::Ptr executor(new CallbackExecutor(1));
+  ASSERT_EQ(0, executor->init());
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_callback_executor(executor);
+
+  Session session;
+  Future::Ptr connect_future(session.connect(config));
+  ASSERT_TRUE(connect_future->wait_for(WAIT_FOR_TIME));
+  ASSERT_FALSE(connect_future->error());
+
+  CassStatement* statement = cass_statement_new("blah", 0);
+  cass_statement_set_prefetch_pages(statement, 1);
+  CassFuture* future = cass_session_execute(CassSession::to(&session), statement);
+  const CassResult* result = cass_future_get_result(future);
+  ASSERT_TRUE(result != NULL);
+  EXPECT_TRUE(cass_result_has_more_pages(result));
+  cass_statement_set_paging_state(statement, result);
+  cass_result_free(result);
+  cass_future_free(future);
+
+  // The second page was requested when the first page arrived
+  Callbacks callbacks;
+  future = cass_session_execute(CassSession::to(&session), statement);
+  EXPECT_EQ(CASS_OK, cass_future_set_callback(future, on_callback, &callbacks));
+  cass_future_free(future);
+  cass_statement_free(statement);
+
+  EXPECT_TRUE(wait_for_count(&callbacks, 1));
+
+  // The prefetched page's callback uses the session's executor
+  CassCallbackMetrics metrics;
+  cass_session_get_callback_metrics(CassSession::to(&session), &metrics);
+  EXPECT_EQ(1u, metrics.dispatched_callbacks);
+
+  Future::Ptr close_future(session.close());
+  ASSERT_TRUE(close_future->wait_for(WAIT_FOR_TIME));
+}
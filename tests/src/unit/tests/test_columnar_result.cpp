@@ -0,0 +1,138 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "columnar_result.hpp"
+#include "test_token_map_utils.hpp"
+
+using datastax::internal::core::ColumnarResult;
+
+class ColumnarResultUnitTest : public testing::Test {
+public:
+  // Builds a rows result with the columns: id int, value bigint, name text
+  void build(BufferBuilder& builder, int32_t row_count) {
+    builder.append<int32_t>(CASS_RESULT_KIND_ROWS);
+    builder.append<int32_t>(CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+    builder.append<int32_t>(3); // Column count
+    builder.append_string("keyspace");
+    builder.append_string("table");
+    builder.append_string("id");
+    builder.append<uint16_t>(CASS_VALUE_TYPE_INT);
+    builder.append_string("value");
+    builder.append<uint16_t>(CASS_VALUE_TYPE_BIGINT);
+    builder.append_string("name");
+    builder.append<uint16_t>(CASS_VALUE_TYPE_VARCHAR);
+    builder.append<int32_t>(row_count);
+  }
+
+  void decode(BufferBuilder& builder) {
+    Decoder decoder(builder.data(), builder.size(), CASS_PROTOCOL_VERSION);
+    ASSERT_TRUE(result.decode(decoder));
+  }
+
+  ResultResponse result;
+};
+
+TEST_F(ColumnarResultUnitTest, Simple) {
+  BufferBuilder builder;
+  build(builder, 10);
+  for (int32_t i = 0; i < 10; ++i) {
+    builder.append_value<int32_t>(i);
+    if (i % 3 == 0) {
+      builder.append<int32_t>(-1); // Null
+    } else {
+      builder.append_value<int64_t>(static_cast<int64_t>(i) << 40);
+    }
+    OStringStream ss;
+    ss << "name" << i;
+    builder.append_value<String>(ss.str());
+  }
+  decode(builder);
+
+  CassColumnarResult* columns = NULL;
+  ASSERT_EQ(CASS_OK, cass_result_export_columns(CassResult::to(&result), &columns));
+  ASSERT_EQ(10u, cass_columnar_result_row_count(columns));
+  ASSERT_EQ(3u, cass_columnar_result_column_count(columns));
+
+  CassColumnBuffers id;
+  ASSERT_EQ(CASS_OK, cass_columnar_result_column(columns, 0, &id));
+  EXPECT_EQ(CASS_VALUE_TYPE_INT, id.type);
+  EXPECT_EQ(10u, id.length);
+  EXPECT_EQ(0u, id.null_count);
+  EXPECT_TRUE(id.validity == NULL);
+  EXPECT_TRUE(id.offsets == NULL);
+  EXPECT_EQ(sizeof(cass_int32_t), id.value_size);
+  const cass_int32_t* ids = reinterpret_cast<const cass_int32_t*>(id.values);
+  for (int32_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(i, ids[i]);
+  }
+
+  CassColumnBuffers value;
+  ASSERT_EQ(CASS_OK, cass_columnar_result_column(columns, 1, &value));
+  EXPECT_EQ(CASS_VALUE_TYPE_BIGINT, value.type);
+  EXPECT_EQ(4u, value.null_count); // Rows 0, 3, 6 and 9
+  ASSERT_TRUE(value.validity != NULL);
+  EXPECT_EQ(sizeof(cass_int64_t), value.value_size);
+  const cass_int64_t* values = reinterpret_cast<const cass_int64_t*>(value.values);
+  for (int32_t i = 0; i < 10; ++i) {
+    bool is_valid = (value.validity[i / 8] & (1 << (i % 8))) != 0;
+    if (i % 3 == 0) {
+      EXPECT_FALSE(is_valid);
+      EXPECT_EQ(0, values[i]);
+    } else {
+      EXPECT_TRUE(is_valid);
+      EXPECT_EQ(static_cast<cass_int64_t>(i) << 40, values[i]);
+    }
+  }
+
+  CassColumnBuffers name;
+  ASSERT_EQ(CASS_OK, cass_columnar_result_column(columns, 2, &name));
+  EXPECT_EQ(CASS_VALUE_TYPE_VARCHAR, name.type);
+  EXPECT_EQ(0u, name.value_size);
+  ASSERT_TRUE(name.offsets != NULL);
+  EXPECT_EQ(0, name.offsets[0]);
+  for (int32_t i = 0; i < 10; ++i) {
+    OStringStream ss;
+    ss << "name" << i;
+    EXPECT_EQ(ss.str(), String(reinterpret_cast<const char*>(name.values) + name.offsets[i],
+                               name.offsets[i + 1] - name.offsets[i]));
+  }
+
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS, cass_columnar_result_column(columns, 3, &name));
+
+  cass_columnar_result_free(columns);
+}
+
+TEST_F(ColumnarResultUnitTest, InvalidData) {
+  BufferBuilder builder;
+  build(builder, 1);
+  builder.append_value<int64_t>(1); // Invalid size for an int
+  builder.append_value<int64_t>(2);
+  builder.append_value<String>("abc");
+  decode(builder);
+
+  CassColumnarResult* columns = NULL;
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_DATA,
+            cass_result_export_columns(CassResult::to(&result), &columns));
+}
+
+TEST_F(ColumnarResultUnitTest, UnsupportedType) {
+  EXPECT_EQ(-1, ColumnarResult::value_size(CASS_VALUE_TYPE_LIST));
+  EXPECT_EQ(-1, ColumnarResult::value_size(CASS_VALUE_TYPE_DECIMAL));
+  EXPECT_EQ(16, ColumnarResult::value_size(CASS_VALUE_TYPE_TIMEUUID));
+  EXPECT_EQ(0, ColumnarResult::value_size(CASS_VALUE_TYPE_BLOB));
+}
@@ -0,0 +1,107 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "completion_queue.hpp"
+#include "future.hpp"
+
+using namespace datastax::internal::core;
+
+TEST(CompletionQueueUnitTest, Drain) {
+  CompletionQueue::Ptr queue(new CompletionQueue(4));
+
+  int tags[3];
+  Future::Ptr futures[3];
+  for (int i = 0; i < 3; ++i) {
+    futures[i].reset(new Future(Future::FUTURE_TYPE_GENERIC));
+    ASSERT_TRUE(queue->reserve());
+    ASSERT_TRUE(futures[i]->set_completion_queue(queue, &tags[i]));
+  }
+
+  CassCompletion completions[4];
+  EXPECT_EQ(0u, queue->drain(completions, 4)); // Nothing has completed
+
+  futures[0]->set();
+  futures[2]->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Timed out");
+
+  ASSERT_EQ(2u, queue->drain(completions, 4));
+  EXPECT_EQ(&tags[0], completions[0].tag);
+  EXPECT_EQ(CASS_OK, completions[0].code);
+  EXPECT_EQ(futures[0].get(), completions[0].future->from());
+  EXPECT_EQ(&tags[2], completions[1].tag);
+  EXPECT_EQ(CASS_ERROR_LIB_REQUEST_TIMED_OUT, completions[1].code);
+  EXPECT_EQ(futures[2].get(), completions[1].future->from());
+  for (size_t i = 0; i < 2; ++i) {
+    completions[i].future->from()->dec_ref();
+  }
+
+  // A future that's already set posts its completion immediately
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  future->set();
+  ASSERT_TRUE(queue->reserve());
+  ASSERT_TRUE(future->set_completion_queue(queue, NULL));
+
+  futures[1]->set();
+  ASSERT_EQ(1u, queue->drain(completions, 1)); // Drained in batches
+  completions[0].future->from()->dec_ref();
+  ASSERT_EQ(1u, queue->drain(completions, 4));
+  completions[0].future->from()->dec_ref();
+}
+
+TEST(CompletionQueueUnitTest, Capacity) {
+  CompletionQueue::Ptr queue(new CompletionQueue(2));
+
+  EXPECT_TRUE(queue->reserve());
+  EXPECT_TRUE(queue->reserve());
+  EXPECT_FALSE(queue->reserve()); // Outstanding requests count toward the capacity
+
+  queue->release();
+  EXPECT_TRUE(queue->reserve());
+
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  ASSERT_TRUE(future->set_completion_queue(queue, NULL));
+  future->set();
+  EXPECT_FALSE(queue->reserve()); // Completions that haven't been drained count too
+
+  CassCompletion completion;
+  ASSERT_EQ(1u, queue->drain(&completion, 1));
+  completion.future->from()->dec_ref();
+  EXPECT_TRUE(queue->reserve());
+}
+
+TEST(CompletionQueueUnitTest, CallbackAlreadySet) {
+  CompletionQueue::Ptr queue(new CompletionQueue(1));
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+
+  ASSERT_TRUE(queue->reserve());
+  ASSERT_TRUE(future->set_completion_queue(queue, NULL));
+  EXPECT_FALSE(future->set_completion_queue(queue, NULL));
+  EXPECT_FALSE(future->set_callback(NULL, NULL));
+  future->set();
+  EXPECT_FALSE(future->set_callback(NULL, NULL)); // Still set after posting the completion
+}
+
+TEST(CompletionQueueUnitTest, FreeWithoutDraining) {
+  Future::Ptr future(new Future(Future::FUTURE_TYPE_GENERIC));
+  {
+    CompletionQueue::Ptr queue(new CompletionQueue(1));
+    ASSERT_TRUE(queue->reserve());
+    ASSERT_TRUE(future->set_completion_queue(queue, NULL));
+  }
+  future->set(); // The future keeps the queue alive until it's set
+  EXPECT_EQ(1, future->ref_count());
+}
@@ -18,6 +18,7 @@
 
 #include "decoder.hpp"
 #include "logger.hpp"
+#include "value.hpp"
 
 using namespace datastax;
 using namespace datastax::internal;
@@ -1000,3 +1001,49 @@ TEST_F(DecoderUnitTest, DecodeWarnings) {
   ASSERT_FALSE(decoder.decode_warnings(value));
   ASSERT_TRUE(failure_logged_);
 }
+
+TEST_F(DecoderUnitTest, DecodeBorrowedValue) {
+  const char input[28] = { 0,   0,   0,   4,   0,   0,   0,   42, // Int value
+                           -1,  -1,  -1,  -1,                     // Null value
+                           0,   0,   0,   12,  0,   0,   0,   1,  // List with a single int
+                           0,   0,   0,   4,   0,   0,   0,   7 };
+  TestDecoder decoder(input, 28);
+  DataType::ConstPtr int_type(new DataType(CASS_VALUE_TYPE_INT));
+  DataType::ConstPtr list_type(CollectionType::list(int_type, false));
+  int int_type_ref_count = int_type->ref_count();
+  int list_type_ref_count = list_type->ref_count();
+
+  { // SUCCESS
+    Value value;
+    ASSERT_TRUE(decoder.decode_borrowed_value(int_type, value));
+    EXPECT_EQ(int_type.get(), value.data_type().get());
+    EXPECT_EQ(int_type_ref_count, int_type->ref_count());
+    EXPECT_FALSE(value.is_null());
+    EXPECT_EQ(42, value.as_int32());
+
+    // Values are reused in place
+    ASSERT_TRUE(decoder.decode_borrowed_value(int_type, value));
+    EXPECT_TRUE(value.is_null());
+    EXPECT_EQ(CASS_VALUE_TYPE_INT, value.value_type());
+
+    ASSERT_TRUE(decoder.decode_borrowed_value(list_type, value));
+    EXPECT_EQ(list_type_ref_count, list_type->ref_count());
+    EXPECT_TRUE(value.is_collection());
+    EXPECT_EQ(1, value.count());
+    EXPECT_EQ(CASS_VALUE_TYPE_INT, value.primary_value_type());
+
+    // Copies of borrowed values own a reference to the data type
+    Value copy(value);
+    EXPECT_EQ(list_type.get(), copy.data_type().get());
+    EXPECT_EQ(list_type_ref_count + 1, list_type->ref_count());
+    EXPECT_EQ(1, copy.count());
+    ASSERT_EQ(0ul, decoder.remaining());
+  }
+
+  // FAIL
+  const char truncated[6] = { 0, 0, 0, 4, 0, 0 };
+  TestDecoder truncated_decoder(truncated, 6);
+  Value value;
+  ASSERT_FALSE(truncated_decoder.decode_borrowed_value(int_type, value));
+  ASSERT_TRUE(failure_logged_);
+}
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 
 #include "future.hpp"
+#include "request_handler.hpp"
 #include "test_utils.hpp"
 
 #include <uv.h>
@@ -24,6 +25,8 @@
 #define DELAY_MS 500 // 500 milliseconds
 
 using datastax::internal::core::Future;
+using datastax::internal::core::RequestTimings;
+using datastax::internal::core::ResponseFuture;
 
 void on_timeout_set_future(uv_timer_t* handle) {
   Future* future = static_cast<Future*>(handle->data);
@@ -112,6 +115,25 @@ TEST(FutureUnitTest, CallbackAlreadyAssigned) {
   ASSERT_FALSE(future.set_callback(&on_future_callback, NULL));
 }
 
+TEST(FutureUnitTest, TimingsCallbackInvoked) {
+  bool is_future_callback_called = false;
+  ResponseFuture::Ptr future(new ResponseFuture());
+  RequestTimings* timings = future->enable_timings();
+  timings->times[RequestTimings::STAGE_ENQUEUED] = uv_hrtime();
+  ASSERT_TRUE(future->set_callback(&on_future_callback, &is_future_callback_called));
+  future->set();
+  ASSERT_TRUE(is_future_callback_called);
+
+  CassRequestTimings output;
+  ASSERT_EQ(CASS_OK, cass_future_timings(CassFuture::to(future.get()), &output));
+  EXPECT_GT(output.enqueued, 0u);
+  EXPECT_GE(output.callback_invoked, output.enqueued);
+
+  Future generic(Future::FUTURE_TYPE_GENERIC);
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_FUTURE_TYPE,
+            cass_future_timings(CassFuture::to(&generic), &output));
+}
+
 TEST(FutureUnitTest, CallbackAfterFutureIsSet) {
   bool is_future_callback_called = false;
   Future future(Future::FUTURE_TYPE_GENERIC);
@@ -124,3 +146,41 @@ TEST(FutureUnitTest, CallbackAfterFutureIsSet) {
   ASSERT_TRUE(future.set_callback(&on_future_callback, &is_future_callback_called));
   ASSERT_TRUE(is_future_callback_called);
 }
+
+TEST(FutureUnitTest, WaitAll) {
+  Future first(Future::FUTURE_TYPE_GENERIC);
+  Future second(Future::FUTURE_TYPE_GENERIC);
+  Future* futures[] = { &first, &second };
+
+  first.set(); // Already set futures don't need to be waited on
+  EXPECT_FALSE(Future::wait_all(futures, 2, 1000)); // 1 millisecond
+
+  uv_thread_t thread;
+  ASSERT_EQ(0, uv_thread_create(&thread, start_timer, &second));
+  ASSERT_TRUE(Future::wait_all(futures, 2, 1e+7)); // 10 seconds
+  ASSERT_TRUE(second.ready());
+
+  ASSERT_EQ(0, uv_thread_join(&thread));
+}
+
+TEST(FutureUnitTest, WaitAny) {
+  Future first(Future::FUTURE_TYPE_GENERIC);
+  Future second(Future::FUTURE_TYPE_GENERIC);
+  Future* futures[] = { &first, &second };
+
+  size_t index = 2;
+  EXPECT_FALSE(Future::wait_any(futures, 2, 1000, &index)); // 1 millisecond
+  EXPECT_EQ(2u, index);
+
+  uv_thread_t thread;
+  ASSERT_EQ(0, uv_thread_create(&thread, start_timer, &second));
+  ASSERT_TRUE(Future::wait_any(futures, 2, 1e+7, &index)); // 10 seconds
+  EXPECT_EQ(1u, index);
+  EXPECT_FALSE(first.ready());
+  ASSERT_EQ(0, uv_thread_join(&thread));
+
+  // The waiter was removed from the future that wasn't set
+  first.set();
+  ASSERT_TRUE(Future::wait_any(futures, 2, 0, &index));
+  EXPECT_EQ(0u, index);
+}
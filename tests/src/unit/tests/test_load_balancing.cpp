@@ -24,6 +24,7 @@
 #include "event_loop.hpp"
 #include "latency_aware_policy.hpp"
 #include "murmur3.hpp"
+#include "outlier_detection_policy.hpp"
 #include "query_request.hpp"
 #include "random.hpp"
 #include "request_handler.hpp"
@@ -467,6 +468,37 @@ TEST(DatacenterAwareLoadBalancingUnitTest, UsedHostsPerDatacenter) {
   }
 }
 
+TEST(DatacenterAwareLoadBalancingUnitTest, LocalRack) {
+  HostMap hosts;
+  populate_hosts(2, "rack1", LOCAL_DC, &hosts);
+  populate_hosts(2, "rack2", LOCAL_DC, &hosts);
+  populate_hosts(2, "rack2", REMOTE_DC, &hosts);
+
+  DCAwarePolicy policy(LOCAL_DC, 0, true, "rack2");
+  policy.init(SharedRefPtr<Host>(), hosts, NULL, "");
+
+  // Local rack hosts are tried first, then the rest of the local DC hosts
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("ks", NULL, NULL));
+    const size_t seq[] = { 3, 4, 1, 2 };
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+
+  // Hosts in the same rack of a remote DC are not local
+  EXPECT_TRUE(policy.is_local_rack(hosts[addr_for_sequence(3)]));
+  EXPECT_FALSE(policy.is_local_rack(hosts[addr_for_sequence(1)]));
+  EXPECT_FALSE(policy.is_local_rack(hosts[addr_for_sequence(5)]));
+
+  // Fall back to the rest of the local DC when the local rack is down
+  policy.on_host_down(addr_for_sequence(3));
+  policy.on_host_down(addr_for_sequence(4));
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("ks", NULL, NULL));
+    const size_t seq[] = { 2, 1 };
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+}
+
 TEST(DatacenterAwareLoadBalancingUnitTest, AllowRemoteDatacentersForLocalConsistencyLevel) {
   HostMap hosts;
   populate_hosts(3, "rack", LOCAL_DC, &hosts);
@@ -702,6 +734,55 @@ TEST(TokenAwareLoadBalancingUnitTest, Simple) {
   }
 }
 
+TEST(TokenAwareLoadBalancingUnitTest, RoutingToken) {
+  const int64_t num_hosts = 4;
+  HostMap hosts;
+  TokenMap::Ptr token_map(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+
+  // Tokens
+  // 1.0.0.0 -4611686018427387905
+  // 2.0.0.0 -2
+  // 3.0.0.0  4611686018427387901
+  // 4.0.0.0  9223372036854775804
+
+  const uint64_t partition_size = CASS_UINT64_MAX / num_hosts;
+  Murmur3Partitioner::Token token = CASS_INT64_MIN + static_cast<int64_t>(partition_size);
+
+  for (size_t i = 1; i <= num_hosts; ++i) {
+    Host::Ptr host(create_host(addr_for_sequence(i), single_token(token),
+                               Murmur3Partitioner::name().to_string(), "rack1", LOCAL_DC));
+
+    hosts[host->address()] = host;
+    token_map->add_host(host);
+    token += partition_size;
+  }
+
+  add_keyspace_simple("test", 3, token_map.get());
+  token_map->build();
+
+  TokenAwarePolicy policy(new RoundRobinPolicy(), false);
+  policy.init(SharedRefPtr<Host>(), hosts, NULL, "");
+
+  // The routing token is used without a routing key
+  QueryRequest::Ptr request(new QueryRequest("", 0));
+  request->set_routing_token("-2"); // Owned by 2.0.0.0
+  SharedRefPtr<RequestHandler> request_handler(new RequestHandler(request, ResponseFuture::Ptr()));
+
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("test", request_handler.get(), token_map.get()));
+    const size_t seq[] = { 2, 3, 4, 1 };
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+
+  request->set_routing_token("-1"); // Owned by 3.0.0.0
+
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("test", request_handler.get(), token_map.get()));
+    const size_t seq[] = { 3, 4, 1, 2 };
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+}
+
 TEST(TokenAwareLoadBalancingUnitTest, NetworkTopology) {
   const size_t num_hosts = 7;
   HostMap hosts;
@@ -774,6 +855,76 @@ TEST(TokenAwareLoadBalancingUnitTest, NetworkTopology) {
   }
 }
 
+TEST(TokenAwareLoadBalancingUnitTest, LocalRack) {
+  const size_t num_hosts = 7;
+  HostMap hosts;
+
+  TokenMap::Ptr token_map(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+
+  // Tokens
+  // 1.0.0.0 local  rack1 -6588122883467697006
+  // 2.0.0.0 remote rack1 -3952873730080618204
+  // 3.0.0.0 local  rack1 -1317624576693539402
+  // 4.0.0.0 remote rack1  1317624576693539400
+  // 5.0.0.0 local  rack2  3952873730080618202
+  // 6.0.0.0 remote rack1  6588122883467697004
+  // 7.0.0.0 local  rack2  9223372036854775806
+
+  const uint64_t partition_size = CASS_UINT64_MAX / num_hosts;
+  Murmur3Partitioner::Token token = CASS_INT64_MIN + static_cast<int64_t>(partition_size);
+
+  for (size_t i = 1; i <= num_hosts; ++i) {
+    Host::Ptr host(create_host(addr_for_sequence(i), single_token(token),
+                               Murmur3Partitioner::name().to_string(),
+                               i == 5 || i == 7 ? "rack2" : "rack1",
+                               i % 2 == 0 ? REMOTE_DC : LOCAL_DC));
+
+    hosts[host->address()] = host;
+    token_map->add_host(host);
+    token += partition_size;
+  }
+
+  ReplicationMap replication;
+  replication[LOCAL_DC] = "3";
+  replication[REMOTE_DC] = "2";
+  add_keyspace_network_topology("test", replication, token_map.get());
+  token_map->build();
+
+  QueryRequest::Ptr request(new QueryRequest("", 1));
+  const char* value = "abc"; // hash: -5434086359492102041
+  request->set(0, CassString(value, strlen(value)));
+  request->add_key_index(0);
+  SharedRefPtr<RequestHandler> request_handler(new RequestHandler(request, ResponseFuture::Ptr()));
+
+  // Local rack replicas (5, 7) are tried before the other local replica (3)
+  {
+    TokenAwarePolicy policy(new DCAwarePolicy(LOCAL_DC, num_hosts / 2, false, "rack2"), false);
+    policy.init(SharedRefPtr<Host>(), hosts, NULL, "");
+
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("test", request_handler.get(), token_map.get()));
+    const size_t seq[] = { 5, 7, 3, 1, 4, 6, 2 };
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+
+  // Shuffling replicas keeps the local rack replicas first
+  {
+    Random random;
+    TokenAwarePolicy policy(new DCAwarePolicy(LOCAL_DC, num_hosts / 2, false, "rack2"), true);
+    policy.init(SharedRefPtr<Host>(), hosts, &random, "");
+
+    for (int i = 0; i < 10; ++i) {
+      ScopedPtr<QueryPlan> qp(
+          policy.new_query_plan("test", request_handler.get(), token_map.get()));
+      Host::Ptr first(qp->compute_next());
+      Host::Ptr second(qp->compute_next());
+      Host::Ptr third(qp->compute_next());
+      EXPECT_EQ("rack2", first->rack());
+      EXPECT_EQ("rack2", second->rack());
+      EXPECT_EQ(addr_for_sequence(3), third->address());
+    }
+  }
+}
+
 TEST(TokenAwareLoadBalancingUnitTest, ShuffleReplicas) {
   Random random;
 
@@ -860,6 +1011,164 @@ TEST(TokenAwareLoadBalancingUnitTest, ShuffleReplicas) {
   }
 }
 
+TEST(TokenAwareLoadBalancingUnitTest, LightweightTransactionsNotShuffled) {
+  Random random;
+
+  const int64_t num_hosts = 4;
+  HostMap hosts;
+  TokenMap::Ptr token_map(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+
+  const uint64_t partition_size = CASS_UINT64_MAX / num_hosts;
+  Murmur3Partitioner::Token token = CASS_INT64_MIN + static_cast<int64_t>(partition_size);
+
+  for (size_t i = 1; i <= num_hosts; ++i) {
+    Host::Ptr host(create_host(addr_for_sequence(i), single_token(token),
+                               Murmur3Partitioner::name().to_string(), "rack1", LOCAL_DC));
+
+    hosts[host->address()] = host;
+    token_map->add_host(host);
+    token += partition_size;
+  }
+
+  add_keyspace_simple("test", 3, token_map.get());
+  token_map->build();
+
+  TokenAwarePolicy policy(new RoundRobinPolicy(), true); // Shuffled
+  policy.init(SharedRefPtr<Host>(), hosts, &random, "");
+
+  const char* value = "kjdfjkldsdjkl"; // hash: 9024137376112061887
+
+  // Serial read
+  QueryRequest::Ptr serial_read(new QueryRequest("", 1));
+  serial_read->set(0, CassString(value, strlen(value)));
+  serial_read->add_key_index(0);
+  serial_read->set_consistency(CASS_CONSISTENCY_SERIAL);
+
+  // Conditional update
+  QueryRequest::Ptr conditional_update(new QueryRequest("", 1));
+  conditional_update->set(0, CassString(value, strlen(value)));
+  conditional_update->add_key_index(0);
+  conditional_update->set_serial_consistency(CASS_CONSISTENCY_LOCAL_SERIAL);
+
+  QueryRequest::Ptr requests[] = { serial_read, conditional_update };
+  for (size_t i = 0; i < 2; ++i) {
+    SharedRefPtr<RequestHandler> request_handler(
+        new RequestHandler(requests[i], ResponseFuture::Ptr()));
+
+    // Replicas are always in token ring order
+    for (int j = 0; j < 10; ++j) {
+      ScopedPtr<QueryPlan> qp(
+          policy.new_query_plan("test", request_handler.get(), token_map.get()));
+      const size_t seq[] = { 4, 1, 2, 3 };
+      verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+    }
+  }
+}
+
+TEST(TokenAwareLoadBalancingUnitTest, OrderReplicasByLatency) {
+  const int64_t num_hosts = 4;
+  HostMap hosts;
+  TokenMap::Ptr token_map(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+
+  const uint64_t partition_size = CASS_UINT64_MAX / num_hosts;
+  Murmur3Partitioner::Token token = CASS_INT64_MIN + static_cast<int64_t>(partition_size);
+
+  for (size_t i = 1; i <= num_hosts; ++i) {
+    Host::Ptr host(create_host(addr_for_sequence(i), single_token(token),
+                               Murmur3Partitioner::name().to_string(), "rack1", LOCAL_DC));
+    host->enable_latency_histogram(99.0, 0); // Publish the percentile on every merge
+
+    hosts[host->address()] = host;
+    token_map->add_host(host);
+    token += partition_size;
+  }
+
+  add_keyspace_simple("test", 3, token_map.get());
+  token_map->build();
+
+  QueryRequest::Ptr request(new QueryRequest("", 1));
+  const char* value = "kjdfjkldsdjkl"; // hash: 9024137376112061887
+  request->set(0, CassString(value, strlen(value)));
+  request->add_key_index(0);
+  SharedRefPtr<RequestHandler> request_handler(new RequestHandler(request, ResponseFuture::Ptr()));
+
+  // Replicas are 4, 1 and 2; make host 2 the fastest and host 4 the slowest
+  const uint64_t latencies_us[] = { 200, 100, 0, 300 };
+  for (size_t i = 1; i <= num_hosts; ++i) {
+    if (latencies_us[i - 1] == 0) continue; // Host 3 isn't a replica
+    hdr_histogram* histogram = Host::create_latency_histogram();
+    hdr_record_value(histogram, latencies_us[i - 1]);
+    hosts[addr_for_sequence(i)]->merge_latencies(histogram);
+    free(histogram);
+  }
+
+  const uint64_t retry_period_ns = 10LL * 1000LL * 1000LL * 1000LL;
+  TokenAwarePolicy policy(new RoundRobinPolicy(), false, true, retry_period_ns, 1);
+  policy.init(SharedRefPtr<Host>(), hosts, NULL, "");
+
+  {
+    ScopedPtr<QueryPlan> qp(
+        policy.new_query_plan("test", request_handler.get(), token_map.get()));
+    const size_t seq[] = { 2, 1, 4, 3 };
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+
+  // Percentiles with too few measurements are unknown and are tried first
+  TokenAwarePolicy min_measured_policy(new RoundRobinPolicy(), false, true, retry_period_ns, 2);
+  min_measured_policy.init(SharedRefPtr<Host>(), hosts, NULL, "");
+  {
+    ScopedPtr<QueryPlan> qp(
+        min_measured_policy.new_query_plan("test", request_handler.get(), token_map.get()));
+    const size_t seq[] = { 4, 1, 2, 3 }; // Token order
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+}
+
+TEST(TokenAwareLoadBalancingUnitTest, OrderReplicasByLatencyStale) {
+  const int64_t num_hosts = 4;
+  HostMap hosts;
+  TokenMap::Ptr token_map(TokenMap::from_partitioner(Murmur3Partitioner::name()));
+
+  const uint64_t partition_size = CASS_UINT64_MAX / num_hosts;
+  Murmur3Partitioner::Token token = CASS_INT64_MIN + static_cast<int64_t>(partition_size);
+
+  for (size_t i = 1; i <= num_hosts; ++i) {
+    Host::Ptr host(create_host(addr_for_sequence(i), single_token(token),
+                               Murmur3Partitioner::name().to_string(), "rack1", LOCAL_DC));
+    host->enable_latency_histogram(99.0, 0); // Publish the percentile on every merge
+
+    hosts[host->address()] = host;
+    token_map->add_host(host);
+    token += partition_size;
+  }
+
+  add_keyspace_simple("test", 3, token_map.get());
+  token_map->build();
+
+  QueryRequest::Ptr request(new QueryRequest("", 1));
+  const char* value = "kjdfjkldsdjkl"; // hash: 9024137376112061887
+  request->set(0, CassString(value, strlen(value)));
+  request->add_key_index(0);
+  SharedRefPtr<RequestHandler> request_handler(new RequestHandler(request, ResponseFuture::Ptr()));
+
+  // Host 4 (the first replica in token order) was slow once
+  hdr_histogram* histogram = Host::create_latency_histogram();
+  hdr_record_value(histogram, 1000);
+  hosts[addr_for_sequence(4)]->merge_latencies(histogram);
+  free(histogram);
+
+  test::Utils::msleep(20);
+
+  // The percentile is older than the retry period so host 4 keeps its place
+  // and gets a chance to be measured again
+  TokenAwarePolicy policy(new RoundRobinPolicy(), false, true, 10LL * 1000LL * 1000LL, 1);
+  policy.init(SharedRefPtr<Host>(), hosts, NULL, "");
+
+  ScopedPtr<QueryPlan> qp(policy.new_query_plan("test", request_handler.get(), token_map.get()));
+  const size_t seq[] = { 4, 1, 2, 3 };
+  verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+}
+
 TEST(LatencyAwareLoadBalancingUnitTest, ThreadholdToAccount) {
   const uint64_t scale = 100LL;
   const uint64_t min_measured = 15LL;
@@ -1015,6 +1324,155 @@ TEST(LatencyAwareLoadBalancingUnitTest, MinAverageUnderMinMeasured) {
   EXPECT_EQ(policy.min_average(), -1);
 }
 
+TEST(LatencyAwareLoadBalancingUnitTest, Percentile) {
+  LatencyAwarePolicy::Settings settings;
+  settings.min_measured = 10;
+  settings.percentile = 90.0;
+  settings.window_ns = 0; // Publish the percentile on every merge
+
+  const int64_t num_hosts = 4;
+  HostMap hosts;
+  populate_hosts(num_hosts, "rack1", LOCAL_DC, &hosts);
+  LatencyAwarePolicy policy(new RoundRobinPolicy(), settings);
+  policy.init(SharedRefPtr<Host>(), hosts, NULL, "");
+
+  const uint64_t one_ms = 1000LL * 1000LL; // 1 ms in ns
+  const Host::Ptr& host1 = hosts[Address("1.0.0.0", 9042)];
+  const Host::Ptr& host2 = hosts[Address("2.0.0.0", 9042)];
+
+  // Host 1 has a lower average, but a much higher tail latency than host 2
+  for (int i = 0; i < 80; ++i) {
+    policy.record_latency(host1, one_ms);
+    policy.record_latency(host2, 5 * one_ms);
+  }
+  for (int i = 0; i < 20; ++i) {
+    policy.record_latency(host1, 50 * one_ms);
+    policy.record_latency(host2, 6 * one_ms);
+  }
+
+  // Nothing is visible until the per-thread latencies are merged
+  EXPECT_EQ(-1, host1->get_current_percentile().average);
+
+  policy.merge_latencies();
+
+  TimestampedAverage latency1 = host1->get_current_percentile();
+  TimestampedAverage latency2 = host2->get_current_percentile();
+  EXPECT_EQ(100u, latency1.num_measured);
+  EXPECT_EQ(100u, latency2.num_measured);
+  EXPECT_NEAR(static_cast<double>(50 * one_ms), static_cast<double>(latency1.average),
+              0.01 * 50 * one_ms);
+  EXPECT_NEAR(static_cast<double>(6 * one_ms), static_cast<double>(latency2.average),
+              0.01 * 6 * one_ms);
+
+  // Hosts without latencies are unaffected
+  EXPECT_EQ(-1, hosts[Address("3.0.0.0", 9042)]->get_current_percentile().average);
+}
+
+TEST(OutlierDetectionLoadBalancingUnitTest, ConsecutiveFailures) {
+  const uint64_t one_second = 1000LL * 1000LL * 1000LL; // 1 second in ns
+
+  OutlierDetectionSettings settings;
+  settings.consecutive_failures = 3;
+  settings.failure_rate_threshold = 0.0;
+  settings.base_ejection_time_ns = one_second;
+  settings.max_ejection_time_ns = 3 * one_second;
+
+  Host host(Address("0.0.0.0", 9042));
+  host.enable_outlier_detection(settings);
+
+  uint64_t now = uv_hrtime();
+  EXPECT_FALSE(host.record_execution(true, now));
+  EXPECT_FALSE(host.record_execution(true, now));
+  EXPECT_FALSE(host.record_execution(false, now)); // Resets the consecutive failures
+  EXPECT_FALSE(host.record_execution(true, now));
+  EXPECT_FALSE(host.record_execution(true, now));
+  EXPECT_FALSE(host.is_ejected(now));
+
+  EXPECT_TRUE(host.record_execution(true, now));
+  EXPECT_TRUE(host.is_ejected(now));
+  EXPECT_EQ(1u, host.ejection_count());
+
+  // Re-admitted after the base ejection time
+  EXPECT_TRUE(host.is_ejected(now + one_second - 1));
+  EXPECT_FALSE(host.is_ejected(now + one_second));
+
+  // The ejection time doubles for consecutive ejections
+  now += one_second;
+  for (int i = 0; i < 3; ++i) {
+    host.record_execution(true, now);
+  }
+  EXPECT_TRUE(host.is_ejected(now + 2 * one_second - 1));
+  EXPECT_FALSE(host.is_ejected(now + 2 * one_second));
+
+  // ...up to the maximum ejection time
+  now += 2 * one_second;
+  for (int i = 0; i < 3; ++i) {
+    host.record_execution(true, now);
+  }
+  EXPECT_TRUE(host.is_ejected(now + 3 * one_second - 1));
+  EXPECT_FALSE(host.is_ejected(now + 3 * one_second));
+  EXPECT_EQ(3u, host.ejection_count());
+}
+
+TEST(OutlierDetectionLoadBalancingUnitTest, FailureRate) {
+  OutlierDetectionSettings settings;
+  settings.consecutive_failures = 0;
+  settings.failure_rate_threshold = 50.0;
+  settings.min_requests = 10;
+
+  Host host(Address("0.0.0.0", 9042));
+  host.enable_outlier_detection(settings);
+
+  uint64_t now = uv_hrtime();
+  for (int i = 0; i < 4; ++i) { // Not enough requests to consider the failure rate
+    EXPECT_FALSE(host.record_execution(true, now));
+  }
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_FALSE(host.record_execution(false, now));
+  }
+  EXPECT_FALSE(host.record_execution(false, now)); // 40% after 10 requests
+  EXPECT_FALSE(host.record_execution(true, now));  // 45%
+  EXPECT_TRUE(host.record_execution(true, now));   // 50%
+  EXPECT_TRUE(host.is_ejected(now));
+
+  // The failure rate is calculated per interval
+  Host other(Address("0.0.0.1", 9042));
+  other.enable_outlier_detection(settings);
+  for (int i = 0; i < 9; ++i) {
+    EXPECT_FALSE(other.record_execution(true, now));
+  }
+  now += settings.interval_ns;
+  EXPECT_FALSE(other.record_execution(true, now));
+  EXPECT_FALSE(other.is_ejected(now));
+}
+
+TEST(OutlierDetectionLoadBalancingUnitTest, EjectedHostsLast) {
+  OutlierDetectionSettings settings;
+  settings.consecutive_failures = 1;
+
+  const int64_t num_hosts = 4;
+  HostMap hosts;
+  populate_hosts(num_hosts, "rack1", LOCAL_DC, &hosts);
+  OutlierDetectionPolicy policy(new RoundRobinPolicy(), settings);
+  policy.init(SharedRefPtr<Host>(), hosts, NULL, "");
+
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("", NULL, NULL));
+    Host::Ptr host(qp->compute_next());
+    EXPECT_EQ(addr_for_sequence(1), host->address());
+    qp->on_execution_error(host, CASS_ERROR_SERVER_SYNTAX_ERROR); // Not a host failure
+    EXPECT_FALSE(host->is_ejected(uv_hrtime()));
+    qp->on_execution_error(host, CASS_ERROR_SERVER_OVERLOADED);
+    EXPECT_TRUE(host->is_ejected(uv_hrtime()));
+  }
+
+  {
+    ScopedPtr<QueryPlan> qp(policy.new_query_plan("", NULL, NULL));
+    const size_t seq[] = { 2, 3, 4, 1 };
+    verify_sequence(qp.get(), VECTOR_FROM(size_t, seq));
+  }
+}
+
 TEST(WhitelistLoadBalancingUnitTest, Hosts) {
   const int64_t num_hosts = 100;
   HostMap hosts;
@@ -26,6 +26,7 @@
 #define NUM_ITERATIONS 100
 
 using datastax::internal::core::Metrics;
+using datastax::internal::core::RequestTimings;
 
 struct CounterThreadArgs {
   uv_thread_t thread;
@@ -256,3 +257,191 @@ TEST(MetricsUnitTest, MeterWithThreads) {
   EXPECT_NEAR(meter.five_minute_rate(), expected, abs_error);
   EXPECT_NEAR(meter.fifteen_minute_rate(), expected, abs_error);
 }
+
+TEST(MetricsUnitTest, HistogramWindows) {
+  const uint64_t interval = Metrics::Histogram::WINDOW_BUCKET_INTERVAL_NS;
+
+  Metrics::ThreadState thread_state(1);
+  Metrics::Histogram histogram(&thread_state, 3, true);
+  ASSERT_TRUE(histogram.is_windowed());
+
+  uint64_t start = uv_hrtime();
+  for (uint64_t i = 1; i <= 100; ++i) {
+    histogram.record_value(i);
+  }
+  histogram.rotate_windows_if_necessary(start + interval); // Starts a new bucket
+  for (int i = 0; i < 10; ++i) {
+    histogram.record_value(1000);
+  }
+
+  Metrics::Histogram::Snapshot snapshot;
+  histogram.get_window_snapshot(Metrics::Histogram::WINDOW_ONE_MINUTE, &snapshot,
+                                start + interval);
+  EXPECT_EQ(110, snapshot.count);
+  EXPECT_EQ(1, snapshot.min);
+  EXPECT_NEAR(1000, snapshot.max, 10);
+
+  // The first bucket has moved out of the one minute window
+  histogram.get_window_snapshot(Metrics::Histogram::WINDOW_ONE_MINUTE, &snapshot,
+                                start + 4 * interval);
+  EXPECT_EQ(10, snapshot.count);
+  EXPECT_NEAR(1000, snapshot.min, 10);
+  histogram.get_window_snapshot(Metrics::Histogram::WINDOW_FIVE_MINUTES, &snapshot,
+                                start + 4 * interval);
+  EXPECT_EQ(110, snapshot.count);
+
+  // All the buckets have moved out of the fifteen minute window
+  histogram.get_window_snapshot(Metrics::Histogram::WINDOW_FIFTEEN_MINUTES, &snapshot,
+                                start + 61 * interval);
+  EXPECT_EQ(0, snapshot.count);
+  EXPECT_EQ(0, snapshot.max);
+
+  // The cumulative snapshot is unaffected by the windows
+  histogram.get_snapshot(&snapshot);
+  EXPECT_EQ(110, snapshot.count);
+  EXPECT_EQ(1, snapshot.min);
+}
+
+TEST(MetricsUnitTest, HistogramWindowsStaleTime) {
+  const uint64_t interval = Metrics::Histogram::WINDOW_BUCKET_INTERVAL_NS;
+
+  Metrics::ThreadState thread_state(1);
+  Metrics::Histogram histogram(&thread_state, 3, true);
+
+  uint64_t start = uv_hrtime();
+  histogram.record_value(1);
+  histogram.rotate_windows_if_necessary(start + interval);
+
+  // A time before the start of the current bucket doesn't rotate the buckets
+  Metrics::Histogram::Snapshot snapshot;
+  histogram.get_window_snapshot(Metrics::Histogram::WINDOW_ONE_MINUTE, &snapshot, start);
+  EXPECT_EQ(1, snapshot.count);
+}
+
+TEST(MetricsUnitTest, HistogramWindowsIdle) {
+  const uint64_t interval = Metrics::Histogram::WINDOW_BUCKET_INTERVAL_NS;
+
+  Metrics::ThreadState thread_state(1);
+  Metrics::Histogram histogram(&thread_state, 3, true);
+
+  // A value recorded after several idle buckets is in the current bucket
+  uint64_t start = uv_hrtime();
+  histogram.record_value(1000, start + 4 * interval);
+  Metrics::Histogram::Snapshot snapshot;
+  histogram.get_window_snapshot(Metrics::Histogram::WINDOW_ONE_MINUTE, &snapshot,
+                                start + 4 * interval);
+  EXPECT_EQ(1, snapshot.count);
+  EXPECT_NEAR(1000, snapshot.max, 10);
+
+  // Even when the idle period is longer than all the windows
+  histogram.record_value(2000, start + 70 * interval);
+  histogram.get_window_snapshot(Metrics::Histogram::WINDOW_ONE_MINUTE, &snapshot,
+                                start + 70 * interval);
+  EXPECT_EQ(1, snapshot.count);
+  EXPECT_NEAR(2000, snapshot.max, 20);
+
+  histogram.get_snapshot(&snapshot);
+  EXPECT_EQ(2, snapshot.count);
+}
+
+TEST(MetricsUnitTest, RequestStages) {
+  Metrics metrics(1, 0, true);
+  ASSERT_TRUE(metrics.request_stages);
+
+  RequestTimings timings;
+  for (int i = 0; i < RequestTimings::STAGE_COUNT; ++i) {
+    timings.times[i] = (i + 1) * 1000000; // Each stage takes 1 ms
+  }
+  timings.times[RequestTimings::STAGE_WRITE_FLUSHED] = 0; // Not reached
+  metrics.request_stages->record(timings);
+
+  Metrics::Histogram::Snapshot snapshot;
+  metrics.request_stages->queue.get_snapshot(&snapshot);
+  EXPECT_EQ(1, snapshot.count);
+  EXPECT_EQ(1000, snapshot.max);
+  metrics.request_stages->decode.get_snapshot(&snapshot);
+  EXPECT_EQ(1, snapshot.count);
+
+  // The stages before and after a stage that wasn't reached aren't recorded
+  metrics.request_stages->write.get_snapshot(&snapshot);
+  EXPECT_EQ(0, snapshot.count);
+  metrics.request_stages->server.get_snapshot(&snapshot);
+  EXPECT_EQ(0, snapshot.count);
+
+  // The connection stage isn't recorded for speculative executions or retries
+  timings.times[RequestTimings::STAGE_WRITE_FLUSHED] = 5 * 1000000;
+  timings.is_first_attempt = false;
+  metrics.request_stages->record(timings);
+  metrics.request_stages->plan.get_snapshot(&snapshot);
+  EXPECT_EQ(2, snapshot.count);
+  metrics.request_stages->connection.get_snapshot(&snapshot);
+  EXPECT_EQ(1, snapshot.count);
+  metrics.request_stages->write.get_snapshot(&snapshot);
+  EXPECT_EQ(1, snapshot.count);
+
+  EXPECT_FALSE(Metrics(1).request_stages); // Disabled by default
+}
+
+TEST(MetricsUnitTest, HostMetrics) {
+  using datastax::String;
+  using datastax::internal::core::Address;
+
+  Metrics metrics(1);
+  Metrics::HostMetrics::Ptr host1 = metrics.host_metrics(Address("127.0.0.1", 9042), "dc1");
+  Metrics::HostMetrics::Ptr host2 = metrics.host_metrics(Address("127.0.0.2", 9042), "dc1");
+  Metrics::HostMetrics::Ptr host3 = metrics.host_metrics(Address("127.0.0.3", 9042), "dc2");
+  EXPECT_EQ(host1.get(), metrics.host_metrics(Address("127.0.0.1", 9042), "dc1").get());
+
+  host1->start_request();
+  host1->record_latency(1000000); // 1 ms
+  host2->start_request();
+  host2->finish_request();
+  host2->record_latency(2000000);
+  host2->record_error();
+  host2->record_speculative_win();
+  host3->record_timeout();
+
+  Metrics::HostMetrics::Vec hosts;
+  metrics.all_host_metrics(&hosts);
+  ASSERT_EQ(3u, hosts.size());
+
+  Metrics::Histogram::Snapshot snapshot;
+  host1->host_metrics().latencies.get_snapshot(&snapshot);
+  EXPECT_EQ(1, snapshot.count);
+  EXPECT_EQ(1, host1->host_metrics().in_flight.sum());
+  EXPECT_EQ(0, host2->host_metrics().in_flight.sum());
+  EXPECT_EQ(1, host2->host_metrics().errors.sum());
+  EXPECT_EQ(1, host2->host_metrics().speculative_wins.sum());
+  EXPECT_EQ(1, host3->host_metrics().timeouts.sum());
+
+  // The host metrics are aggregated by data center
+  Metrics::DcMetricsMap dcs;
+  metrics.all_dc_metrics(&dcs);
+  ASSERT_EQ(2u, dcs.size());
+
+  const Metrics::RequestMetrics& dc1 = *dcs[String("dc1")];
+  dc1.latencies.get_snapshot(&snapshot);
+  EXPECT_EQ(2, snapshot.count);
+  EXPECT_NEAR(1000, snapshot.min, 10);
+  EXPECT_NEAR(2000, snapshot.max, 20);
+  EXPECT_EQ(1, dc1.in_flight.sum());
+  EXPECT_EQ(1, dc1.errors.sum());
+  EXPECT_EQ(1, dc1.speculative_wins.sum());
+  EXPECT_EQ(0, dc1.timeouts.sum());
+
+  const Metrics::RequestMetrics& dc2 = *dcs[String("dc2")];
+  dc2.latencies.get_snapshot(&snapshot);
+  EXPECT_EQ(0, snapshot.count);
+  EXPECT_EQ(1, dc2.timeouts.sum());
+
+  // Removed hosts are no longer reported, but their data center's metrics are
+  // kept and the host's metrics can still be used by in-flight requests.
+  metrics.remove_host_metrics(Address("127.0.0.3", 9042));
+  hosts.clear();
+  metrics.all_host_metrics(&hosts);
+  EXPECT_EQ(2u, hosts.size());
+  host3->record_timeout();
+  EXPECT_EQ(2, host3->host_metrics().timeouts.sum());
+  EXPECT_EQ(2, dc2.timeouts.sum());
+  EXPECT_NE(host3.get(), metrics.host_metrics(Address("127.0.0.3", 9042), "dc2").get());
+}
@@ -0,0 +1,83 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "page_prefetcher.hpp"
+
+using namespace datastax;
+using namespace datastax::internal::core;
+
+static Future::Ptr new_future() { return Future::Ptr(new Future(Future::FUTURE_TYPE_GENERIC)); }
+
+TEST(PagePrefetcherUnitTest, Simple) {
+  PagePrefetcher prefetcher(1);
+  uint64_t generation = prefetcher.start();
+
+  Future::Ptr page2(new_future());
+  EXPECT_TRUE(prefetcher.reserve(generation, "page1", page2));
+  EXPECT_FALSE(prefetcher.reserve(generation, "page1", new_future())); // Already reserved
+
+  uint64_t taken_generation = 0;
+  String deferred;
+  EXPECT_FALSE(prefetcher.take("unknown", &taken_generation, &deferred));
+  EXPECT_EQ(page2, prefetcher.take("page1", &taken_generation, &deferred));
+  EXPECT_EQ(generation, taken_generation);
+  EXPECT_TRUE(deferred.empty());
+
+  // Already taken
+  EXPECT_FALSE(prefetcher.take("page1", &taken_generation, &deferred));
+}
+
+TEST(PagePrefetcherUnitTest, LookAheadLimit) {
+  PagePrefetcher prefetcher(2);
+  uint64_t generation = prefetcher.start();
+
+  Future::Ptr page2(new_future());
+  Future::Ptr page3(new_future());
+  EXPECT_TRUE(prefetcher.reserve(generation, "page1", page2));
+  EXPECT_TRUE(prefetcher.reserve(generation, "page2", page3));
+  EXPECT_FALSE(prefetcher.reserve(generation, "page3", new_future())); // Deferred
+
+  // Taking a page frees a slot for the deferred page
+  uint64_t taken_generation = 0;
+  String deferred;
+  EXPECT_EQ(page2, prefetcher.take("page1", &taken_generation, &deferred));
+  EXPECT_EQ("page3", deferred);
+  EXPECT_TRUE(prefetcher.reserve(taken_generation, deferred, new_future()));
+
+  deferred.clear();
+  EXPECT_EQ(page3, prefetcher.take("page2", &taken_generation, &deferred));
+  EXPECT_TRUE(deferred.empty());
+}
+
+TEST(PagePrefetcherUnitTest, Restart) {
+  PagePrefetcher prefetcher(1);
+  uint64_t generation = prefetcher.start();
+
+  EXPECT_TRUE(prefetcher.reserve(generation, "page1", new_future()));
+
+  // Starting a new sequence discards prefetched pages and pages in flight
+  // from the previous sequence are not prefetched further.
+  uint64_t new_generation = prefetcher.start();
+  EXPECT_NE(generation, new_generation);
+
+  uint64_t taken_generation = 0;
+  String deferred;
+  EXPECT_FALSE(prefetcher.take("page1", &taken_generation, &deferred));
+  EXPECT_FALSE(prefetcher.reserve(generation, "page2", new_future()));
+  EXPECT_TRUE(prefetcher.reserve(new_generation, "page1", new_future()));
+}
@@ -13,26 +13,43 @@
 
 #include "loop_test.hpp"
 
+#include "cluster.hpp"
 #include "execute_request.hpp"
 #include "md5.hpp"
 #include "prepared.hpp"
+#include "prepared_file.hpp"
+#include "query_request.hpp"
 #include "session.hpp"
 #include "set.hpp"
+#include "statement_template.hpp"
 #include "uuids.hpp"
 
 using namespace mockssandra;
 using datastax::internal::ScopedMutex;
 using datastax::internal::Set;
+using datastax::internal::Vector;
 using datastax::internal::core::Config;
 using datastax::internal::core::ExecuteRequest;
 using datastax::internal::core::Future;
 using datastax::internal::core::Prepared;
+using datastax::internal::core::PreparedFile;
+using datastax::internal::core::PreparedMetadata;
+using datastax::internal::core::PrepareHostMetrics;
+using datastax::internal::core::ProtocolVersion;
+using datastax::internal::core::QueryRequest;
 using datastax::internal::core::ResponseFuture;
 using datastax::internal::core::ResultResponse;
 using datastax::internal::core::Session;
+using datastax::internal::core::StatementTemplate;
 
 #define PREPARED_QUERY "SELECT * FROM test"
 
+#ifdef _WIN32
+#define PATH_SEPARATOR '\\'
+#else
+#define PATH_SEPARATOR '/'
+#endif
+
 class PreparedUnitTest : public LoopTest {
 public:
   /**
@@ -49,7 +66,9 @@ public:
     String put_query(const Address& address, const String& query) {
       ScopedMutex l(&mutex_);
       String id = generate_id(query);
-      statements_.insert(to_key(address, id));
+      if (statements_.insert(to_key(address, id)).second) {
+        ordered_keys_.push_back(to_key(address, id));
+      }
       return id;
     }
 
@@ -62,6 +81,20 @@ public:
       return contains_id(address, generate_id(query));
     }
 
+    // The order a query was first prepared on a node (or -1 if not prepared)
+    int order_of_query(const Address& address, const String& query) const {
+      ScopedMutex l(&mutex_);
+      String prefix = to_key(address, "");
+      String key = to_key(address, generate_id(query));
+      int order = 0;
+      for (Vector<String>::const_iterator it = ordered_keys_.begin(), end = ordered_keys_.end();
+           it != end; ++it) {
+        if (*it == key) return order;
+        if (it->compare(0, prefix.size(), prefix) == 0) order++;
+      }
+      return -1;
+    }
+
   private:
     String to_key(const Address& address, const String& id) const {
       return address.to_string() + "_" + id;
@@ -78,6 +111,7 @@ public:
   private:
     mutable uv_mutex_t mutex_;
     Set<String> statements_;
+    Vector<String> ordered_keys_;
   };
 
   /**
@@ -86,9 +120,11 @@ public:
    */
   class PrepareQuery : public Action {
   public:
-    PrepareQuery(PrepareStatements* statements, const String& keyspace = "")
+    PrepareQuery(PrepareStatements* statements, const String& keyspace = "",
+                 const String& table_keyspace = "")
         : statements_(statements)
-        , keyspace_(keyspace) {}
+        , keyspace_(keyspace)
+        , table_keyspace_(table_keyspace.empty() ? keyspace : table_keyspace) {}
 
     void on_run(Request* request) const {
       String query;
@@ -103,12 +139,12 @@ public:
         encode_int32(RESULT_PREPARED, &body);
         encode_string(id, &body); // Prepared ID
         // Metadata
-        bool global_table_spec = !keyspace_.empty();
+        bool global_table_spec = !table_keyspace_.empty();
         encode_int32(global_table_spec ? RESULT_FLAG_GLOBAL_TABLESPEC : 0, &body); // Flags
         encode_int32(0, &body);                                                    // Column count
         encode_int32(0, &body); // Primary key count
         if (global_table_spec) {
-          encode_string(keyspace_, &body);
+          encode_string(table_keyspace_, &body);
           encode_string("", &body); // Empty table doesn't matter for these tests
         }
         // Result metadata
@@ -122,6 +158,7 @@ public:
   private:
     PrepareStatements* statements_;
     const String keyspace_;
+    const String table_keyspace_;
   };
 
   /**
@@ -196,6 +233,27 @@ public:
     return Prepared::ConstPtr(
         new Prepared(result, future->prepare_request, *future->schema_metadata));
   }
+
+  /**
+   * A file in the system's temporary directory that's removed when it goes out of scope.
+   */
+  class TempFile {
+  public:
+    TempFile(const char* name) {
+      char tmp[260] = { 0 }; // Note: 260 is the maximum path on Windows
+      size_t tmp_length = 260;
+      uv_os_tmpdir(tmp, &tmp_length);
+      path_ = String(tmp, tmp_length) + PATH_SEPARATOR + name;
+      remove(path_.c_str());
+    }
+
+    ~TempFile() { remove(path_.c_str()); }
+
+    const String& path() const { return path_; }
+
+  private:
+    String path_;
+  };
 };
 
 /**
@@ -289,3 +347,328 @@ TEST_F(PreparedUnitTest, PreparedOnUpWithCaseSensitiveKeyspace) {
 
   close(&session);
 }
+
+/**
+ * Verify that recently used statements are prepared first on a host that comes up and that the
+ * remaining statements are prepared in the background, within the rate limit.
+ */
+TEST_F(PreparedUnitTest, PreparedOnUpRecentlyUsedFirst) {
+  PrepareStatements statements;
+
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_PREPARE).execute(new PrepareQuery(&statements));
+  builder.on(OPCODE_EXECUTE).execute(new ExecuteQuery(&statements));
+
+  mockssandra::SimpleCluster cluster(builder.build(), 2); // Requires at least 2 nodes
+  ASSERT_EQ(cluster.start(1), 0);
+
+  Config config;
+  config.set_prepare_on_up_or_add_host_concurrency(1);
+  config.set_prepare_on_up_or_add_host_rate(2); // A burst of two, then one every 500 ms
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+
+  Session session;
+  connect(config, &session);
+
+  const char* queries[] = { "SELECT * FROM test1", "SELECT * FROM test2", "SELECT * FROM test3" };
+  Prepared::ConstPtr recently_used;
+  for (size_t i = 0; i < 3; ++i) {
+    recently_used = prepare(&session, queries[i]);
+    ASSERT_TRUE(recently_used);
+  }
+
+  { // Only the last statement is used
+    Future::Ptr future =
+        session.execute(ExecuteRequest::ConstPtr(new ExecuteRequest(recently_used.get())));
+    EXPECT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out waiting to execute prepared query ";
+    EXPECT_FALSE(future->error()) << cass_error_desc(future->error()->code) << ": "
+                                  << future->error()->message;
+  }
+
+  ASSERT_EQ(cluster.start(2), 0);
+  cluster.event(StatusChangeEvent::up(Address("127.0.0.2", 9042)));
+
+  const PrepareHostMetrics& metrics = session.cluster()->prepare_host_metrics();
+  bool is_done = false;
+  for (int i = 0; i < 600 && !is_done; ++i) {
+    is_done = metrics.prepared_statements.load() == 3 && metrics.hosts_preparing.load() == 0;
+    test::Utils::msleep(100);
+  }
+  ASSERT_TRUE(is_done);
+
+  EXPECT_EQ(0, statements.order_of_query(Address("127.0.0.2", 9042), queries[2]));
+  EXPECT_GT(statements.order_of_query(Address("127.0.0.2", 9042), queries[0]), 0);
+  EXPECT_GT(statements.order_of_query(Address("127.0.0.2", 9042), queries[1]), 0);
+
+  EXPECT_EQ(0, metrics.pending_statements.load());
+  EXPECT_EQ(0u, metrics.failed_statements.load());
+
+  close(&session);
+}
+
+/**
+ * Verify that a statement template is executed as a bound statement.
+ */
+TEST_F(PreparedUnitTest, ExecuteTemplate) {
+  PrepareStatements statements;
+
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_PREPARE).execute(new PrepareQuery(&statements));
+  builder.on(OPCODE_EXECUTE).execute(new ExecuteQuery(&statements));
+
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+
+  Session session;
+  connect(config, &session);
+
+  Prepared::ConstPtr prepared = prepare(&session, PREPARED_QUERY);
+  ASSERT_TRUE(prepared);
+
+  StatementTemplate statement_template(prepared);
+  for (int i = 0; i < 2; ++i) {
+    Future::Ptr future =
+        session.execute(ExecuteRequest::ConstPtr(new ExecuteRequest(&statement_template)));
+    EXPECT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out waiting to execute template";
+    EXPECT_FALSE(future->error()) << cass_error_desc(future->error()->code) << ": "
+                                  << future->error()->message;
+  }
+
+  close(&session);
+}
+
+/**
+ * Verify that a cacheable simple statement is prepared in the background and is then executed as a
+ * bound statement.
+ */
+TEST_F(PreparedUnitTest, CacheableStatement) {
+  PrepareStatements statements;
+
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_PREPARE).execute(new PrepareQuery(&statements));
+  builder.on(OPCODE_EXECUTE).execute(new ExecuteQuery(&statements)); // Returns no rows
+  builder.on(OPCODE_QUERY).system_local().system_peers().empty_rows_result(1);
+
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+
+  Session session;
+  connect(config, &session);
+
+  QueryRequest::Ptr request(new QueryRequest(PREPARED_QUERY));
+  request->set_is_cacheable(true);
+
+  int row_count = -1;
+  for (int i = 0; i < 100 && row_count != 0; ++i) {
+    Future::Ptr future(session.execute(QueryRequest::ConstPtr(request)));
+    EXPECT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out waiting to execute query";
+    ASSERT_FALSE(future->error()) << cass_error_desc(future->error()->code) << ": "
+                                  << future->error()->message;
+    ResultResponse::Ptr result(static_cast<ResponseFuture*>(future.get())->response());
+    ASSERT_TRUE(result);
+    if (i == 0) {
+      EXPECT_EQ(1, result->row_count()); // The first execution is a simple statement
+    }
+    row_count = result->row_count();
+    if (row_count != 0) test::Utils::msleep(1);
+  }
+  EXPECT_EQ(0, row_count);
+  EXPECT_TRUE(statements.contains_query(Address("127.0.0.1", 9042), PREPARED_QUERY));
+
+  close(&session);
+}
+
+/**
+ * Verify that metadata entries are marked as stale when they're replaced, unless the result
+ * metadata ID is unchanged.
+ */
+TEST_F(PreparedUnitTest, MetadataEntryStale) {
+  PreparedMetadata metadata;
+
+  PreparedMetadata::Entry::Ptr entry(
+      new PreparedMetadata::Entry(PREPARED_QUERY, "", "abc", ResultResponse::ConstPtr()));
+  metadata.set("id", entry);
+  EXPECT_FALSE(entry->is_stale());
+
+  // Same result metadata ID
+  metadata.set("id", PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                         PREPARED_QUERY, "", "abc", ResultResponse::ConstPtr())));
+  EXPECT_FALSE(entry->is_stale());
+  EXPECT_EQ(entry.get(), metadata.get("id").get());
+
+  // Changed result metadata ID
+  PreparedMetadata::Entry::Ptr changed(
+      new PreparedMetadata::Entry(PREPARED_QUERY, "", "def", ResultResponse::ConstPtr()));
+  metadata.set("id", changed);
+  EXPECT_TRUE(entry->is_stale());
+  EXPECT_FALSE(changed->is_stale());
+  EXPECT_EQ(changed.get(), metadata.get("id").get());
+
+  // No result metadata ID (protocol v4 and earlier)
+  PreparedMetadata::Entry::Ptr v4(
+      new PreparedMetadata::Entry(PREPARED_QUERY, "", "", ResultResponse::ConstPtr()));
+  metadata.set("v4", v4);
+  metadata.set("v4", PreparedMetadata::Entry::Ptr(new PreparedMetadata::Entry(
+                         PREPARED_QUERY, "", "", ResultResponse::ConstPtr())));
+  EXPECT_TRUE(v4->is_stale());
+}
+
+/**
+ * Verify that a prepared statement keeps the metadata entry recorded when it was prepared.
+ */
+TEST_F(PreparedUnitTest, MetadataEntryFromPrepare) {
+  PrepareStatements statements;
+
+  mockssandra::SimpleRequestHandlerBuilder builder;
+  builder.on(OPCODE_PREPARE).execute(new PrepareQuery(&statements));
+  builder.on(OPCODE_EXECUTE).execute(new ExecuteQuery(&statements));
+
+  mockssandra::SimpleCluster cluster(builder.build());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+
+  Session session;
+  connect(config, &session);
+
+  ResponseFuture::Ptr future = session.prepare(PREPARED_QUERY, strlen(PREPARED_QUERY));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out waiting to prepare query";
+  ASSERT_FALSE(future->error());
+  ASSERT_TRUE(future->prepared_metadata_entry);
+  EXPECT_EQ(PREPARED_QUERY, future->prepared_metadata_entry->query());
+
+  ResultResponse::Ptr result(future->response());
+  Prepared::ConstPtr prepared(new Prepared(result, future->prepare_request,
+                                           *future->schema_metadata,
+                                           future->prepared_metadata_entry));
+  EXPECT_EQ(future->prepared_metadata_entry.get(), prepared->metadata_entry().get());
+  EXPECT_FALSE(prepared->metadata_entry()->is_stale());
+
+  Future::Ptr execute_future =
+      session.execute(ExecuteRequest::ConstPtr(new ExecuteRequest(prepared.get())));
+  EXPECT_TRUE(execute_future->wait_for(WAIT_FOR_TIME)) << "Timed out waiting to execute query";
+  EXPECT_FALSE(execute_future->error());
+
+  close(&session);
+}
+
+/**
+ * Verify that prepared statements are persisted to a file when a session is closed and that
+ * preparing the same query in a new session uses the file instead of the cluster.
+ */
+TEST_F(PreparedUnitTest, PreparedStatementsFile) {
+  TempFile file("test_prepared_statements.bin");
+  const String& path(file.path());
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_prepared_statements_file(path);
+
+  String prepared_id;
+  ProtocolVersion protocol_version;
+
+  { // Prepare the query using the cluster
+    PrepareStatements statements;
+
+    mockssandra::SimpleRequestHandlerBuilder builder;
+    builder.on(OPCODE_PREPARE).execute(new PrepareQuery(&statements));
+
+    mockssandra::SimpleCluster cluster(builder.build());
+    ASSERT_EQ(cluster.start_all(), 0);
+
+    Session session;
+    connect(config, &session);
+
+    Prepared::ConstPtr prepared = prepare(&session, PREPARED_QUERY);
+    ASSERT_TRUE(prepared);
+    prepared_id = prepared->id();
+    protocol_version = prepared->result()->protocol_version();
+
+    close(&session);
+  }
+
+  PreparedFile::RecordVec records;
+  ASSERT_TRUE(PreparedFile::read(path, protocol_version, "", &records));
+  ASSERT_EQ(1u, records.size());
+  EXPECT_EQ(PREPARED_QUERY, records[0].query);
+  EXPECT_EQ(prepared_id, records[0].result->prepared_id().to_string());
+
+  // The file is ignored for sessions connected to a different keyspace
+  EXPECT_FALSE(PreparedFile::read(path, protocol_version, "other", &records));
+
+  { // Prepare the query using the file
+    mockssandra::SimpleRequestHandlerBuilder builder;
+    builder.on(OPCODE_PREPARE).error(ERROR_INVALID_QUERY, "Unexpected prepare");
+
+    mockssandra::SimpleCluster cluster(builder.build());
+    ASSERT_EQ(cluster.start_all(), 0);
+
+    Session session;
+    connect(config, &session);
+
+    Prepared::ConstPtr prepared = prepare(&session, PREPARED_QUERY);
+    ASSERT_TRUE(prepared);
+    EXPECT_EQ(prepared_id, prepared->id());
+
+    close(&session);
+  }
+}
+
+/**
+ * Verify that persisted prepared statements are found using the keyspace they were prepared in
+ * instead of the keyspace of their result metadata (e.g. for keyspace qualified queries).
+ */
+TEST_F(PreparedUnitTest, PreparedStatementsFileGlobalTableSpec) {
+  TempFile file("test_prepared_statements_table_spec.bin");
+  const String query("SELECT * FROM ks2.test");
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_prepared_statements_file(file.path());
+
+  String prepared_id;
+
+  { // Prepare the query using the cluster. Its result has a global table spec of "ks2".
+    PrepareStatements statements;
+
+    mockssandra::SimpleRequestHandlerBuilder builder;
+    builder.on(OPCODE_PREPARE).execute(new PrepareQuery(&statements, "", "ks2"));
+
+    mockssandra::SimpleCluster cluster(builder.build());
+    ASSERT_EQ(cluster.start_all(), 0);
+
+    Session session;
+    connect(config, &session);
+
+    Prepared::ConstPtr prepared = prepare(&session, query);
+    ASSERT_TRUE(prepared);
+    EXPECT_EQ("ks2", prepared->result()->keyspace().to_string());
+    prepared_id = prepared->id();
+
+    close(&session);
+  }
+
+  { // Prepare the query using the file
+    mockssandra::SimpleRequestHandlerBuilder builder;
+    builder.on(OPCODE_PREPARE).error(ERROR_INVALID_QUERY, "Unexpected prepare");
+
+    mockssandra::SimpleCluster cluster(builder.build());
+    ASSERT_EQ(cluster.start_all(), 0);
+
+    Session session;
+    connect(config, &session);
+
+    Prepared::ConstPtr prepared = prepare(&session, query);
+    ASSERT_TRUE(prepared);
+    EXPECT_EQ(prepared_id, prepared->id());
+
+    close(&session);
+  }
+}
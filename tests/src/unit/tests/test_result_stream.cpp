@@ -0,0 +1,154 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "execution_profile.hpp"
+#include "query_request.hpp"
+#include "result_stream.hpp"
+#include "test_token_map_utils.hpp"
+
+using namespace datastax::internal::core;
+
+class ResultStreamUnitTest : public testing::Test {
+public:
+  // Builds a rows result page with a single int column
+  ResultResponse::Ptr page(int32_t page_number, bool is_last, int32_t value,
+                           ProtocolVersion version = ProtocolVersion(CASS_PROTOCOL_VERSION_DSEV2)) {
+    BufferBuilder builder;
+    int32_t flags = CASS_RESULT_FLAG_GLOBAL_TABLESPEC | CASS_RESULT_FLAG_CONTINUOUS_PAGING;
+    if (is_last) flags |= CASS_RESULT_FLAG_LAST_CONTINUOUS_PAGE;
+    builder.append<int32_t>(CASS_RESULT_KIND_ROWS);
+    builder.append<int32_t>(flags);
+    builder.append<int32_t>(1); // Column count
+    builder.append<int32_t>(page_number);
+    builder.append_string("keyspace");
+    builder.append_string("table");
+    builder.append_string("value");
+    builder.append<uint16_t>(CASS_VALUE_TYPE_INT);
+    builder.append<int32_t>(1); // Row count
+    builder.append_value<int32_t>(value);
+
+    // The response owns the buffer the values are decoded from
+    ResultResponse::Ptr result(new ResultResponse());
+    result->set_buffer(builder.size());
+    memcpy(result->data(), builder.data(), builder.size());
+    Decoder decoder(result->data(), builder.size(), version);
+    EXPECT_TRUE(result->decode(decoder));
+    return result;
+  }
+
+  int32_t value(const ResultResponse::Ptr& result) {
+    cass_int32_t value = 0;
+    const CassValue* column = CassValue::to(&result->first_row().values[0]);
+    EXPECT_EQ(CASS_OK, cass_value_get_int32(column, &value));
+    return value;
+  }
+};
+
+TEST_F(ResultStreamUnitTest, DecodeContinuousPage) {
+  ResultResponse::Ptr first(page(1, false, 42));
+  EXPECT_TRUE(first->is_continuous_page());
+  EXPECT_EQ(1, first->continuous_page_number());
+  EXPECT_FALSE(first->is_last_continuous_page());
+  EXPECT_EQ(42, value(first));
+
+  ResultResponse::Ptr last(page(2, true, 43));
+  EXPECT_TRUE(last->is_continuous_page());
+  EXPECT_EQ(2, last->continuous_page_number());
+  EXPECT_TRUE(last->is_last_continuous_page());
+
+  ResultResponse regular;
+  EXPECT_FALSE(regular.is_continuous_page());
+}
+
+TEST_F(ResultStreamUnitTest, Pages) {
+  ResponseFuture::Ptr future(new ResponseFuture());
+  ResultStream::Ptr stream(new ResultStream(future));
+  stream->init(RequestHandler::Ptr());
+
+  EXPECT_TRUE(stream->push(page(1, false, 1)));
+  EXPECT_TRUE(stream->push(page(2, false, 2)));
+  future->set_response(Address("127.0.0.1", 9042), page(3, true, 3));
+
+  // The queued pages are returned before the final page
+  for (int32_t i = 1; i <= 3; ++i) {
+    ResultResponse::Ptr result(stream->next());
+    ASSERT_TRUE(result);
+    EXPECT_EQ(i, value(result));
+  }
+  EXPECT_FALSE(stream->next());
+  EXPECT_TRUE(stream->error() == NULL);
+}
+
+TEST_F(ResultStreamUnitTest, Error) {
+  ResponseFuture::Ptr future(new ResponseFuture());
+  ResultStream::Ptr stream(new ResultStream(future));
+  stream->init(RequestHandler::Ptr());
+
+  EXPECT_TRUE(stream->error() == NULL); // Not finished
+
+  EXPECT_TRUE(stream->push(page(1, false, 1)));
+  future->set_error(CASS_ERROR_LIB_REQUEST_TIMED_OUT, "Request timed out");
+
+  ResultResponse::Ptr result(stream->next());
+  ASSERT_TRUE(result);
+  EXPECT_EQ(1, value(result));
+  EXPECT_FALSE(stream->next());
+
+  ASSERT_TRUE(stream->error() != NULL);
+  EXPECT_EQ(CASS_ERROR_LIB_REQUEST_TIMED_OUT, stream->error()->code);
+}
+
+TEST_F(ResultStreamUnitTest, Cancel) {
+  ResponseFuture::Ptr future(new ResponseFuture());
+  ResultStream::Ptr stream(new ResultStream(future));
+  stream->init(RequestHandler::Ptr());
+
+  EXPECT_TRUE(stream->push(page(1, false, 1)));
+  stream->cancel();
+
+  // Queued pages are discarded and new pages are rejected
+  EXPECT_FALSE(stream->next());
+  EXPECT_FALSE(stream->push(page(2, false, 2)));
+
+  future->set_error(CASS_ERROR_LIB_INVALID_STATE, "Continuous paging was cancelled");
+}
+
+TEST_F(ResultStreamUnitTest, CancelBeforeInit) {
+  QueryRequest::Ptr request(new QueryRequest("SELECT * FROM table"));
+  request->set_keyspace("keyspace");
+  request->set_host(Address("127.0.0.1", 9042));
+
+  ResponseFuture::Ptr future(new ResponseFuture());
+  RequestHandler::Ptr request_handler(new RequestHandler(request, future));
+  ResultStream::Ptr stream(new ResultStream(future));
+  request_handler->set_result_stream(stream);
+  stream->init(request_handler);
+
+  // The request hasn't been initialized by a request processor yet
+  stream->cancel();
+  EXPECT_FALSE(future->ready());
+
+  // The cancellation is applied once the request is initialized
+  ExecutionProfile profile;
+  profile.set_speculative_execution_policy(new NoSpeculativeExecutionPolicy());
+  ServerSideTimestampGenerator timestamp_generator;
+  request_handler->init(profile, NULL, NULL, &timestamp_generator, NULL);
+  ASSERT_TRUE(future->ready());
+  ASSERT_TRUE(future->error() != NULL);
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_STATE, future->error()->code);
+}
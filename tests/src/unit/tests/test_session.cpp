@@ -281,6 +281,18 @@ TEST_F(SessionUnitTest, ExecuteQueryNotConnected) {
   ASSERT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, future->error()->code);
 }
 
+TEST_F(SessionUnitTest, ExecuteManyNotConnected) {
+  Session session;
+  Request::ConstVec requests(2, Request::ConstPtr(new QueryRequest("blah", 0)));
+  Future::Vec futures;
+  session.execute_many(requests, &futures);
+  ASSERT_EQ(2u, futures.size());
+  for (Future::Vec::const_iterator it = futures.begin(), end = futures.end(); it != end; ++it) {
+    ASSERT_TRUE((*it)->error());
+    EXPECT_EQ(CASS_ERROR_LIB_NO_HOSTS_AVAILABLE, (*it)->error()->code);
+  }
+}
+
 TEST_F(SessionUnitTest, InvalidKeyspace) {
   mockssandra::SimpleRequestHandlerBuilder builder;
   builder.on(mockssandra::OPCODE_QUERY)
@@ -1011,3 +1023,251 @@ TEST_F(SessionUnitTest, DbaasDefaultConsistencyExecutionProfileNotUpdate) {
 
   close(&session);
 }
+
+TEST_F(SessionUnitTest, ExecuteWithCompletionQueue) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  CassCompletionQueue* queue = cass_completion_queue_new(2);
+  CassStatement* statement = cass_statement_new("blah", 0);
+
+  int tags[2];
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(CASS_OK, cass_session_execute_with_completion_queue(CassSession::to(&session),
+                                                                  statement, queue, &tags[i]));
+  }
+  // The queue's capacity includes the outstanding requests
+  EXPECT_EQ(CASS_ERROR_LIB_REQUEST_QUEUE_FULL,
+            cass_session_execute_with_completion_queue(CassSession::to(&session), statement,
+                                                       queue, NULL));
+
+  CassCompletion completions[2];
+  size_t drained = 0;
+  uint64_t start = uv_hrtime();
+  while (drained < 2 && uv_hrtime() - start < static_cast<uint64_t>(WAIT_FOR_TIME) * 1000) {
+    drained += cass_completion_queue_drain(queue, completions + drained, 2 - drained);
+    test::Utils::msleep(1);
+  }
+  ASSERT_EQ(2u, drained) << "Timed out waiting for completions";
+
+  for (size_t i = 0; i < drained; ++i) {
+    EXPECT_TRUE(completions[i].tag == &tags[0] || completions[i].tag == &tags[1]);
+    EXPECT_EQ(CASS_OK, completions[i].code);
+    EXPECT_EQ(CASS_OK, cass_future_error_code(completions[i].future));
+    cass_future_free(completions[i].future);
+  }
+
+  cass_statement_free(statement);
+  cass_completion_queue_free(queue);
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, ExecuteMany) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_thread_count_io(3); // Spread the requests across several processors
+  Session session;
+  connect(config, &session);
+
+  Request::ConstVec requests;
+  for (int i = 0; i < 100; ++i) {
+    QueryRequest::Ptr request(new QueryRequest("blah", 0));
+    request->set_is_idempotent(true);
+    requests.push_back(request);
+  }
+
+  Future::Vec futures;
+  session.execute_many(requests, &futures);
+  ASSERT_EQ(requests.size(), futures.size());
+  for (Future::Vec::const_iterator it = futures.begin(), end = futures.end(); it != end; ++it) {
+    ASSERT_TRUE((*it)->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE((*it)->error())
+        << cass_error_desc((*it)->error()->code) << ": " << (*it)->error()->message;
+  }
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, HostMetrics) {
+  mockssandra::SimpleCluster cluster(simple(), 3);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  EXPECT_EQ(0u, cass_session_get_host_metrics(CassSession::to(&session), NULL, 0));
+  connect(&session, NULL, WAIT_FOR_TIME, 3);
+
+  for (int i = 0; i < 30; ++i) {
+    Future::Ptr future(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE(future->error());
+  }
+
+  CassHostMetrics hosts[4];
+  ASSERT_EQ(3u, cass_session_get_host_metrics(CassSession::to(&session), hosts, 4));
+  cass_uint64_t count = 0;
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_STREQ("dc1", hosts[i].dc);
+    EXPECT_EQ(9042, hosts[i].port);
+    EXPECT_GT(hosts[i].requests.latency.count, 0u); // The requests are spread across the hosts
+    EXPECT_EQ(0u, hosts[i].requests.in_flight);
+    EXPECT_EQ(0u, hosts[i].requests.errors);
+    count += hosts[i].requests.latency.count;
+  }
+  EXPECT_EQ(30u, count);
+
+  CassDcMetrics dcs[1];
+  ASSERT_EQ(1u, cass_session_get_dc_metrics(CassSession::to(&session), dcs, 1));
+  EXPECT_STREQ("dc1", dcs[0].dc);
+  EXPECT_EQ(30u, dcs[0].requests.latency.count);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, WindowedMetrics) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  for (int i = 0; i < 5; ++i) {
+    Future::Ptr future(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE(future->error());
+  }
+
+  // The latency is recorded after the future is set
+  CassLatencyMetrics latency;
+  for (int i = 0; i < 100; ++i) {
+    cass_session_get_windowed_metrics(CassSession::to(&session), CASS_METRICS_WINDOW_ONE_MINUTE,
+                                      &latency);
+    if (latency.count == 5u) break;
+    test::Utils::msleep(10);
+  }
+  EXPECT_EQ(5u, latency.count);
+  EXPECT_GT(latency.max, 0u);
+
+  cass_session_get_windowed_metrics(CassSession::to(&session),
+                                    CASS_METRICS_WINDOW_FIFTEEN_MINUTES, &latency);
+  EXPECT_EQ(5u, latency.count);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, RequestTimings) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_request_timings(true);
+  Session session;
+  connect(config, &session);
+
+  Future::Ptr future(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+  EXPECT_FALSE(future->error());
+
+  CassRequestTimings timings;
+  ASSERT_EQ(CASS_OK, cass_future_timings(CassFuture::to(future.get()), &timings));
+  EXPECT_GT(timings.enqueued, 0u);
+  EXPECT_LE(timings.enqueued, timings.dequeued);
+  EXPECT_LE(timings.dequeued, timings.plan_built);
+  EXPECT_LE(timings.plan_built, timings.write_queued);
+  EXPECT_LE(timings.write_queued, timings.write_flushed);
+  EXPECT_LE(timings.write_queued, timings.response_received);
+  EXPECT_LE(timings.response_received, timings.response_decoded);
+  EXPECT_EQ(0u, timings.callback_invoked); // No callback
+
+  // The stage latencies are recorded after the future is set
+  CassRequestStageMetrics stages;
+  for (int i = 0; i < 100; ++i) {
+    cass_session_get_request_stage_metrics(CassSession::to(&session), &stages);
+    if (stages.decode.count == 1u) break;
+    test::Utils::msleep(10);
+  }
+  EXPECT_EQ(1u, stages.queue.count);
+  EXPECT_EQ(1u, stages.plan.count);
+  EXPECT_EQ(1u, stages.connection.count);
+  EXPECT_EQ(1u, stages.decode.count);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, RequestTimingsDisabled) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Session session;
+  connect(&session);
+
+  Future::Ptr future(session.execute(Request::ConstPtr(new QueryRequest("blah", 0))));
+  ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+
+  CassRequestTimings timings;
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_STATE,
+            cass_future_timings(CassFuture::to(future.get()), &timings));
+
+  CassRequestStageMetrics stages;
+  cass_session_get_request_stage_metrics(CassSession::to(&session), &stages);
+  EXPECT_EQ(0u, stages.queue.count);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, StatementMetrics) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_statement_metrics_size(10);
+  Session session;
+  connect(config, &session);
+
+  for (int i = 0; i < 5; ++i) {
+    QueryRequest::Ptr request(new QueryRequest("blah", 0));
+    request->set_label("blah query");
+    Future::Ptr future(session.execute(Request::ConstPtr(request)));
+    ASSERT_TRUE(future->wait_for(WAIT_FOR_TIME)) << "Timed out executing query";
+    EXPECT_FALSE(future->error());
+  }
+
+  // The latency is recorded after the future is set
+  CassStatementMetrics statements[2];
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(1u, cass_session_get_statement_metrics(CassSession::to(&session),
+                                                     CASS_STATEMENT_METRICS_ORDER_TOTAL_TIME,
+                                                     statements, 2));
+    if (statements[0].count == 5u) break;
+    test::Utils::msleep(10);
+  }
+  EXPECT_STREQ("blah query", statements[0].name);
+  EXPECT_EQ(5u, statements[0].count);
+
+  close(&session);
+}
+
+TEST_F(SessionUnitTest, OrderReplicasByLatencyWithoutLatencyAwareRouting) {
+  mockssandra::SimpleCluster cluster(simple());
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.contact_points().push_back(Address("127.0.0.1", 9042));
+  config.set_thread_count_io(2);
+  config.set_token_aware_routing_order_replicas_by_latency(true);
+  Session session;
+
+  add_logging_critera("Ordering replicas by latency requires latency-aware routing");
+  connect(config, &session);
+  close(&session);
+
+  // Reported once instead of for each copy of the profile
+  EXPECT_EQ(1, logging_criteria_count());
+}
@@ -0,0 +1,146 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "scoped_ptr.hpp"
+#include "speculative_execution.hpp"
+
+using namespace datastax::internal;
+using namespace datastax::internal::core;
+
+#define ONE_MS_IN_NS (1000LL * 1000LL)
+
+TEST(SpeculativeExecutionUnitTest, Constant) {
+  ConstantSpeculativeExecutionPolicy policy(100, 2);
+  ScopedPtr<SpeculativeExecutionPlan> plan(policy.new_plan("", NULL));
+
+  EXPECT_EQ(100, plan->next_execution(Host::Ptr()));
+  EXPECT_EQ(100, plan->next_execution(Host::Ptr()));
+  EXPECT_EQ(-1, plan->next_execution(Host::Ptr()));
+}
+
+TEST(SpeculativeExecutionUnitTest, AdaptiveNoDelayUntilMinMeasured) {
+  AdaptiveSpeculativeExecutionPolicy::Settings settings;
+  settings.min_measured = 10;
+  SharedRefPtr<AdaptiveSpeculativeExecutionPolicy> policy(
+      new AdaptiveSpeculativeExecutionPolicy(settings));
+
+  uint64_t now = uv_hrtime();
+  for (int i = 0; i < 9; ++i) {
+    policy->record_latency(5 * ONE_MS_IN_NS, now);
+  }
+  now += settings.window_ms * ONE_MS_IN_NS;
+  policy->record_request(now); // Rolls the window
+  EXPECT_EQ(-1, policy->delay_ms());
+
+  ScopedPtr<SpeculativeExecutionPlan> plan(policy->new_plan("", NULL));
+  EXPECT_EQ(-1, plan->next_execution(Host::Ptr()));
+
+  // The measurements from the previous window are kept
+  policy->record_latency(5 * ONE_MS_IN_NS, now);
+  now += settings.window_ms * ONE_MS_IN_NS;
+  policy->record_request(now);
+  EXPECT_EQ(5, policy->delay_ms());
+}
+
+TEST(SpeculativeExecutionUnitTest, AdaptivePercentile) {
+  AdaptiveSpeculativeExecutionPolicy::Settings settings;
+  settings.percentile = 90.0;
+  settings.max_speculative_executions = 2;
+  settings.min_measured = 100;
+  SharedRefPtr<AdaptiveSpeculativeExecutionPolicy> policy(
+      new AdaptiveSpeculativeExecutionPolicy(settings));
+
+  uint64_t now = uv_hrtime();
+  for (int i = 1; i <= 100; ++i) { // 1 ms to 100 ms
+    policy->record_latency(i * ONE_MS_IN_NS, now);
+  }
+  now += settings.window_ms * ONE_MS_IN_NS;
+  policy->record_request(now);
+  EXPECT_EQ(90, policy->delay_ms());
+
+  ScopedPtr<SpeculativeExecutionPlan> plan(policy->new_plan("", NULL));
+  EXPECT_EQ(90, plan->next_execution(Host::Ptr()));
+  EXPECT_EQ(90, plan->next_execution(Host::Ptr()));
+  EXPECT_EQ(-1, plan->next_execution(Host::Ptr()));
+
+  // A new window replaces the previous delay
+  for (int i = 0; i < 100; ++i) {
+    policy->record_latency(ONE_MS_IN_NS / 2, now);
+  }
+  now += settings.window_ms * ONE_MS_IN_NS;
+  policy->record_request(now);
+  EXPECT_EQ(1, policy->delay_ms()); // Rounded up to the nearest millisecond
+}
+
+TEST(SpeculativeExecutionUnitTest, AdaptiveBudget) {
+  AdaptiveSpeculativeExecutionPolicy::Settings settings;
+  settings.max_speculative_percent = 10.0;
+  SharedRefPtr<AdaptiveSpeculativeExecutionPolicy> policy(
+      new AdaptiveSpeculativeExecutionPolicy(settings));
+
+  uint64_t now = uv_hrtime();
+  EXPECT_FALSE(policy->acquire_execution()); // No requests
+
+  for (int i = 0; i < 20; ++i) {
+    policy->record_request(now);
+  }
+  EXPECT_TRUE(policy->acquire_execution());
+  EXPECT_TRUE(policy->acquire_execution());
+  EXPECT_FALSE(policy->acquire_execution()); // Exceeds 10%
+
+  for (int i = 0; i < 10; ++i) {
+    policy->record_request(now);
+  }
+  EXPECT_TRUE(policy->acquire_execution());
+  EXPECT_FALSE(policy->acquire_execution());
+
+  // The budget is carried across windows
+  for (int i = 0; i < 5; ++i) {
+    policy->record_request(now);
+  }
+  now += settings.window_ms * ONE_MS_IN_NS;
+  for (int i = 0; i < 5; ++i) {
+    policy->record_request(now);
+  }
+  EXPECT_TRUE(policy->acquire_execution());
+  EXPECT_FALSE(policy->acquire_execution());
+
+  // The saved budget is limited
+  for (int i = 0; i < 10 * AdaptiveSpeculativeExecutionPolicy::MAX_BUDGET_REQUESTS; ++i) {
+    policy->record_request(now);
+  }
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(policy->acquire_execution());
+  }
+  EXPECT_FALSE(policy->acquire_execution());
+}
+
+TEST(SpeculativeExecutionUnitTest, AdaptiveBudgetLowPercent) {
+  AdaptiveSpeculativeExecutionPolicy::Settings settings;
+  settings.max_speculative_percent = 0.5;
+  SharedRefPtr<AdaptiveSpeculativeExecutionPolicy> policy(
+      new AdaptiveSpeculativeExecutionPolicy(settings));
+
+  // A single execution can always be saved up
+  uint64_t now = uv_hrtime();
+  for (int i = 0; i < 1000; ++i) {
+    policy->record_request(now);
+  }
+  EXPECT_TRUE(policy->acquire_execution());
+  EXPECT_FALSE(policy->acquire_execution());
+}
@@ -166,3 +166,22 @@ TEST_F(StatementUnitTest, ErrorParametersUnset) {
   ASSERT_TRUE(future->error());
   EXPECT_EQ(future->error()->code, CASS_ERROR_LIB_PARAMETER_UNSET);
 }
+
+TEST_F(StatementUnitTest, ErrorContinuousPagingUnsupportedProtocol) {
+  mockssandra::SimpleCluster cluster(simple(), 1);
+  ASSERT_EQ(cluster.start_all(), 0);
+
+  Config config;
+  config.set_protocol_version(ProtocolVersion(4));
+
+  connect(config);
+
+  Statement::Ptr request(new QueryRequest("SELECT * FROM does_not_matter"));
+
+  // Continuous paging requires a DSE protocol version
+  ResultStream::Ptr stream(session.execute_continuous(Request::ConstPtr(request)));
+  EXPECT_FALSE(stream->next());
+
+  ASSERT_TRUE(stream->error() != NULL);
+  EXPECT_EQ(CASS_ERROR_LIB_MESSAGE_ENCODE, stream->error()->code);
+}
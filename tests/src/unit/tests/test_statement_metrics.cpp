@@ -0,0 +1,93 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "query_request.hpp"
+#include "statement_metrics.hpp"
+
+using namespace datastax;
+using namespace datastax::internal::core;
+
+#define ONE_MS_IN_NS (1000LL * 1000LL)
+
+namespace {
+
+Request::ConstPtr labeled(const char* label) {
+  QueryRequest::Ptr request(new QueryRequest("SELECT * FROM tbl", 0));
+  request->set_label(label);
+  return request;
+}
+
+} // namespace
+
+TEST(StatementMetricsUnitTest, Disabled) {
+  StatementMetrics metrics(0);
+  EXPECT_FALSE(metrics.is_enabled());
+  metrics.record(labeled("a").get(), ONE_MS_IN_NS);
+  EXPECT_EQ(0u, metrics.size());
+}
+
+TEST(StatementMetricsUnitTest, IgnoreSimpleStatementsWithoutLabel) {
+  StatementMetrics metrics(10);
+  metrics.record(Request::ConstPtr(new QueryRequest("SELECT * FROM tbl", 0)).get(), ONE_MS_IN_NS);
+  EXPECT_EQ(0u, metrics.size());
+}
+
+TEST(StatementMetricsUnitTest, TopN) {
+  StatementMetrics metrics(10);
+
+  // "slow" has the highest p99, "busy" has the highest total time
+  metrics.record(labeled("slow").get(), 100 * ONE_MS_IN_NS);
+  for (int i = 0; i < 1000; ++i) {
+    metrics.record(labeled("busy").get(), ONE_MS_IN_NS);
+  }
+  metrics.record(labeled("fast").get(), ONE_MS_IN_NS / 10);
+  EXPECT_EQ(3u, metrics.size());
+
+  StatementMetrics::SnapshotVec top;
+  metrics.get_top(StatementMetrics::SORT_BY_P99, 2, &top);
+  ASSERT_EQ(2u, top.size());
+  EXPECT_EQ(String("slow"), top[0].name);
+  EXPECT_EQ(1, top[0].count);
+  EXPECT_NEAR(100000, top[0].percentile_99th, 1000);
+  EXPECT_EQ(String("busy"), top[1].name);
+
+  metrics.get_top(StatementMetrics::SORT_BY_TOTAL_TIME, 10, &top);
+  ASSERT_EQ(3u, top.size());
+  EXPECT_EQ(String("busy"), top[0].name);
+  EXPECT_EQ(1000, top[0].count);
+  EXPECT_EQ(1000000, top[0].total_time);
+  EXPECT_EQ(String("slow"), top[1].name);
+  EXPECT_EQ(String("fast"), top[2].name);
+}
+
+TEST(StatementMetricsUnitTest, EvictLeastRecentlyUsed) {
+  StatementMetrics metrics(2);
+
+  metrics.record(labeled("a").get(), ONE_MS_IN_NS);
+  metrics.record(labeled("b").get(), 2 * ONE_MS_IN_NS);
+  metrics.record(labeled("a").get(), ONE_MS_IN_NS); // "b" is now the least recently used
+  metrics.record(labeled("c").get(), 3 * ONE_MS_IN_NS);
+  EXPECT_EQ(2u, metrics.size());
+
+  StatementMetrics::SnapshotVec top;
+  metrics.get_top(StatementMetrics::SORT_BY_P99, 10, &top);
+  ASSERT_EQ(2u, top.size());
+  EXPECT_EQ(String("c"), top[0].name);
+  EXPECT_EQ(String("a"), top[1].name);
+  EXPECT_EQ(2, top[1].count);
+}
@@ -0,0 +1,141 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "execute_request.hpp"
+#include "metadata.hpp"
+#include "prepare_request.hpp"
+#include "statement_template.hpp"
+#include "test_token_map_utils.hpp"
+
+using namespace datastax::internal::core;
+
+class StatementTemplateUnitTest : public testing::Test {
+public:
+  // Builds a prepared statement for "INSERT INTO ks.tbl (key, name, value) VALUES (?, ?, ?)"
+  // where "key" is the partition key.
+  Prepared::ConstPtr prepared() {
+    BufferBuilder builder;
+    builder.append<int32_t>(CASS_RESULT_KIND_PREPARED);
+    builder.append_string("0123456789abcdef"); // Prepared ID
+    builder.append<int32_t>(CASS_RESULT_FLAG_GLOBAL_TABLESPEC);
+    builder.append<int32_t>(3); // Column count
+    builder.append<int32_t>(1); // Primary key count
+    builder.append<uint16_t>(0);
+    builder.append_string("ks");
+    builder.append_string("tbl");
+    builder.append_string("key");
+    builder.append<uint16_t>(CASS_VALUE_TYPE_INT);
+    builder.append_string("name");
+    builder.append<uint16_t>(CASS_VALUE_TYPE_VARCHAR);
+    builder.append_string("value");
+    builder.append<uint16_t>(CASS_VALUE_TYPE_BIGINT);
+    builder.append<int32_t>(CASS_RESULT_FLAG_NO_METADATA); // Result metadata
+    builder.append<int32_t>(0);
+
+    ResultResponse::Ptr result(new ResultResponse());
+    result->set_buffer(builder.size());
+    memcpy(result->data(), builder.data(), builder.size());
+    Decoder decoder(result->data(), builder.size(), ProtocolVersion(CASS_PROTOCOL_VERSION_V4));
+    EXPECT_TRUE(result->decode(decoder));
+
+    Metadata metadata;
+    return Prepared::ConstPtr(
+        new Prepared(result, PrepareRequest::ConstPtr(new PrepareRequest("INSERT ...")),
+                     metadata.schema_snapshot()));
+  }
+
+  // The values of a regular bound statement encoded back-to-back
+  String encoded_values(const ExecuteRequest& request) {
+    String values;
+    for (size_t i = 0; i < request.elements().size(); ++i) {
+      const AbstractData::Element& element(request.elements()[i]);
+      Buffer buf(element.is_unset() ? encode_with_length(CassUnset()) : element.get_buffer());
+      values.append(buf.data(), buf.size());
+    }
+    return values;
+  }
+
+  String encoded_values(const StatementTemplate& statement_template) {
+    Buffer buf(statement_template.encode_values());
+    return String(buf.data(), buf.size());
+  }
+};
+
+TEST_F(StatementTemplateUnitTest, Rebind) {
+  Prepared::ConstPtr prepared(this->prepared());
+  StatementTemplate statement_template(prepared);
+  ExecuteRequest request(prepared.get());
+
+  EXPECT_TRUE(statement_template.has_unset_values());
+  EXPECT_EQ(encoded_values(request), encoded_values(statement_template));
+
+  EXPECT_EQ(CASS_OK, statement_template.set(0, cass_int32_t(42)));
+  EXPECT_EQ(CASS_OK, statement_template.set(1, CassString("abc", 3)));
+  EXPECT_EQ(CASS_OK, statement_template.set(2, cass_int64_t(1234567890)));
+  request.set(0, cass_int32_t(42));
+  request.set(1, CassString("abc", 3));
+  request.set(2, cass_int64_t(1234567890));
+  EXPECT_FALSE(statement_template.has_unset_values());
+  EXPECT_EQ(encoded_values(request), encoded_values(statement_template));
+
+  // Variable-width values move the values that follow them
+  EXPECT_EQ(CASS_OK, statement_template.set(1, CassString("a much longer name", 18)));
+  request.set(1, CassString("a much longer name", 18));
+  EXPECT_EQ(encoded_values(request), encoded_values(statement_template));
+
+  EXPECT_EQ(CASS_OK, statement_template.set(1, CassString("", 0)));
+  request.set(1, CassString("", 0));
+  EXPECT_EQ(encoded_values(request), encoded_values(statement_template));
+
+  EXPECT_EQ(CASS_OK, statement_template.set(1, CassNull()));
+  EXPECT_EQ(CASS_OK, statement_template.set(0, cass_int32_t(-1)));
+  request.set(1, CassNull());
+  request.set(0, cass_int32_t(-1));
+  EXPECT_EQ(encoded_values(request), encoded_values(statement_template));
+
+  EXPECT_EQ(CASS_ERROR_LIB_INVALID_VALUE_TYPE,
+            statement_template.set(0, CassString("not an int", 10)));
+  EXPECT_EQ(CASS_ERROR_LIB_INDEX_OUT_OF_BOUNDS, statement_template.set(3, cass_int32_t(0)));
+}
+
+TEST_F(StatementTemplateUnitTest, ExecuteRequest) {
+  Prepared::ConstPtr prepared(this->prepared());
+  StatementTemplate statement_template(prepared);
+  statement_template.set_consistency(CASS_CONSISTENCY_QUORUM);
+
+  String routing_key;
+  EXPECT_FALSE(statement_template.get_routing_key(&routing_key)); // The key isn't bound
+
+  statement_template.set(0, cass_int32_t(42));
+  statement_template.set(1, CassString("abc", 3));
+  ExecuteRequest request(&statement_template);
+
+  // Rebinding the template doesn't change the values of the request
+  statement_template.set(0, cass_int32_t(43));
+
+  ExecuteRequest expected(prepared.get());
+  expected.set(0, cass_int32_t(42));
+  String expected_routing_key;
+  ASSERT_TRUE(expected.get_routing_key(&expected_routing_key));
+  ASSERT_TRUE(request.get_routing_key(&routing_key));
+  EXPECT_EQ(expected_routing_key, routing_key);
+
+  EXPECT_EQ(CASS_CONSISTENCY_QUORUM, request.consistency());
+  EXPECT_EQ("ks", request.keyspace());
+  EXPECT_EQ(prepared->id(), request.prepared()->id());
+}
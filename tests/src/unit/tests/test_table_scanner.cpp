@@ -0,0 +1,78 @@
+/*
+  Copyright (c) DataStax, Inc.
+
+  Licensed under the Apache License, Version 2.0 (the "License");
+  you may not use this file except in compliance with the License.
+  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <gtest/gtest.h>
+
+#include "constants.hpp"
+#include "table_scanner.hpp"
+
+#include <algorithm>
+
+using namespace datastax::internal::core;
+
+namespace {
+
+CopyOnWriteHostVec replicas(const char* address) {
+  CopyOnWriteHostVec hosts(new HostVec());
+  hosts->push_back(Host::Ptr(new Host(Address(address, 9042))));
+  return hosts;
+}
+
+bool start_less(const TokenRange& lhs, const TokenRange& rhs) { return lhs.start < rhs.start; }
+
+// Verify that the ranges cover the whole ring without gaps or overlaps
+void verify_coverage(TokenRangeVec ranges) {
+  std::sort(ranges.begin(), ranges.end(), start_less);
+  ASSERT_FALSE(ranges.empty());
+  EXPECT_EQ(CASS_INT64_MIN, ranges.front().start);
+  EXPECT_EQ(CASS_INT64_MAX, ranges.back().end);
+  for (size_t i = 1; i < ranges.size(); ++i) {
+    EXPECT_LT(ranges[i - 1].start, ranges[i - 1].end);
+    EXPECT_EQ(ranges[i - 1].end, ranges[i].start);
+  }
+}
+
+} // namespace
+
+TEST(TableScannerUnitTest, SplitRanges) {
+  TokenRangeVec ring;
+  ring.push_back(TokenRange(CASS_INT64_MAX / 2, CASS_INT64_MIN / 2, replicas("127.0.0.1")));
+  ring.push_back(TokenRange(CASS_INT64_MIN / 2, 0, replicas("127.0.0.2")));
+  ring.push_back(TokenRange(0, CASS_INT64_MAX / 2, replicas("127.0.0.3")));
+
+  TokenRangeVec ranges;
+  TableScanner::split_ranges(ring, 1, &ranges);
+  ASSERT_EQ(4u, ranges.size()); // The wrapping range is unwrapped
+  verify_coverage(ranges);
+
+  // The ranges are interleaved by primary replica
+  EXPECT_EQ(Address("127.0.0.1", 9042), ranges[0].replicas->front()->address());
+  EXPECT_EQ(CASS_INT64_MAX / 2, ranges[0].start);
+  EXPECT_EQ(Address("127.0.0.2", 9042), ranges[1].replicas->front()->address());
+  EXPECT_EQ(Address("127.0.0.3", 9042), ranges[2].replicas->front()->address());
+  EXPECT_EQ(Address("127.0.0.1", 9042), ranges[3].replicas->front()->address());
+  EXPECT_EQ(CASS_INT64_MIN, ranges[3].start);
+}
+
+TEST(TableScannerUnitTest, SplitRangesMinCount) {
+  TokenRangeVec ring;
+  ring.push_back(TokenRange(0, 0, replicas("127.0.0.1"))); // A single token owns the whole ring
+
+  TokenRangeVec ranges;
+  TableScanner::split_ranges(ring, 7, &ranges);
+  EXPECT_EQ(8u, ranges.size()); // Each of the two unwrapped ranges is split in four
+  verify_coverage(ranges);
+}
@@ -111,6 +111,43 @@ TEST(TokenMapUnitTest, Murmur3) {
   test_murmur3.verify();
 }
 
+TEST(TokenMapUnitTest, Murmur3TokenRanges) {
+  TestTokenMap<Murmur3Partitioner> test_murmur3;
+
+  test_murmur3.add_host(create_host("1.0.0.1", single_token(CASS_INT64_MIN / 2)));
+  test_murmur3.add_host(create_host("1.0.0.2", single_token(0)));
+  test_murmur3.add_host(create_host("1.0.0.3", single_token(CASS_INT64_MAX / 2)));
+
+  test_murmur3.build("ks", 1);
+
+  TokenRangeVec ranges;
+  ASSERT_TRUE(test_murmur3.token_map->get_token_ranges("ks", &ranges));
+  ASSERT_EQ(3u, ranges.size());
+
+  // The first range wraps around the end of the ring
+  EXPECT_EQ(CASS_INT64_MAX / 2, ranges[0].start);
+  EXPECT_EQ(CASS_INT64_MIN / 2, ranges[0].end);
+  EXPECT_EQ(Address("1.0.0.1", 9042), ranges[0].replicas->front()->address());
+  EXPECT_EQ(CASS_INT64_MIN / 2, ranges[1].start);
+  EXPECT_EQ(0, ranges[1].end);
+  EXPECT_EQ(Address("1.0.0.2", 9042), ranges[1].replicas->front()->address());
+  EXPECT_EQ(0, ranges[2].start);
+  EXPECT_EQ(CASS_INT64_MAX / 2, ranges[2].end);
+  EXPECT_EQ(Address("1.0.0.3", 9042), ranges[2].replicas->front()->address());
+
+  // Ring tokens are owned by their host
+  EXPECT_EQ(Address("1.0.0.2", 9042),
+            test_murmur3.token_map->get_replicas_for_token("ks", "0")->front()->address());
+  EXPECT_EQ(Address("1.0.0.3", 9042),
+            test_murmur3.token_map->get_replicas_for_token("ks", "1")->front()->address());
+  EXPECT_EQ(Address("1.0.0.1", 9042),
+            test_murmur3.token_map->get_replicas_for_token("ks", "9223372036854775807")
+                ->front()
+                ->address());
+
+  EXPECT_FALSE(test_murmur3.token_map->get_token_ranges("invalid", &ranges));
+}
+
 TEST(TokenMapUnitTest, Murmur3MultipleTokensPerHost) {
   TestTokenMap<Murmur3Partitioner> test_murmur3;
 